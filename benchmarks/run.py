@@ -0,0 +1,98 @@
+"""
+Запуск набора бенчмарков Lumen.
+
+Для каждого benchmarks/*.lumen выполняет lumenc в режиме -bench и выводит
+медиану/разброс времени выполнения и разбивку по этапам (лексер,
+препроцессор, парсер, оптимизатор, выполнение).
+
+    python benchmarks/run.py [--lumenc bin/lumenc.exe] [--iters 10] [--warmup 2]
+                             [--lumenc-arg=--no-jit ...] [--json results.json]
+                             [имена бенчмарков...]
+
+Результат --json удобно сохранять до и после изменения интерпретатора
+и сравнивать медианы; --lumenc-arg передаёт lumenc дополнительный ключ
+(например, сравнение --jit и --no-jit).
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+PHASES = ["lex", "preprocess", "parse", "optimize", "execute"]
+
+
+def ms(ns):
+    return "%.3f" % (ns / 1e6)
+
+
+def run_benchmark(lumenc, path, iters, warmup, extra_args):
+    with tempfile.TemporaryDirectory() as tmp:
+        bench_json = os.path.join(tmp, "bench.json")
+        phases_json = os.path.join(tmp, "phases.json")
+        command = [lumenc] + extra_args + ["--file", path, "-bench",
+                   "-bench-iters", str(iters), "-bench-warmup", str(warmup),
+                   "-bench-json", bench_json, "-phases", phases_json]
+        process = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        if not os.path.exists(bench_json) or not os.path.exists(phases_json):
+            sys.stdout.write(process.stdout.decode(errors="replace"))
+            return None
+        with open(bench_json) as f:
+            bench = json.load(f)
+        with open(phases_json) as f:
+            phases = json.load(f)
+        return {"bench": bench, "phases": phases}
+
+
+# compile_all.py собирает bin/lumenc.exe на любой ОС; bin/lumenc – ручная сборка
+def default_lumenc():
+    bin_dir = os.path.join(ROOT, "..", "bin")
+    path = os.path.join(bin_dir, "lumenc")
+    return path if os.name != "nt" and os.path.exists(path) else os.path.join(bin_dir, "lumenc.exe")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Lumen benchmark runner")
+    parser.add_argument("--lumenc", default=default_lumenc())
+    parser.add_argument("--iters", type=int, default=10)
+    parser.add_argument("--warmup", type=int, default=2)
+    parser.add_argument("--lumenc-arg", action="append", default=[],
+                        help="дополнительный ключ lumenc (можно несколько раз)")
+    parser.add_argument("--json", help="сохранить результаты в файл")
+    parser.add_argument("names", nargs="*", help="запустить только эти бенчмарки")
+    args = parser.parse_args()
+
+    files = sorted(glob.glob(os.path.join(ROOT, "*.lumen")))
+    if args.names:
+        files = [f for f in files if os.path.splitext(os.path.basename(f))[0] in args.names]
+
+    header = "%-12s %12s %12s" % ("benchmark", "median ms", "stddev ms")
+    header += "".join(" %12s" % (phase + " ms") for phase in PHASES)
+    print(header)
+
+    results = {}
+    for path in files:
+        name = os.path.splitext(os.path.basename(path))[0]
+        result = run_benchmark(args.lumenc, path, args.iters, args.warmup, args.lumenc_arg)
+        if result is None:
+            print("%-12s failed" % name)
+            continue
+        results[name] = result
+        bench, phases = result["bench"], result["phases"]
+        row = "%-12s %12s %12s" % (name, ms(bench["median"]), ms(bench["stddev"]))
+        row += "".join(" %12s" % ms(phases.get(phase, 0)) for phase in PHASES)
+        print(row)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+    return 0 if len(results) == len(files) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
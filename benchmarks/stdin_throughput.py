@@ -0,0 +1,64 @@
+"""
+Пропускная способность чтения stdin в Lumen (строк/с).
+
+Генерирует входной файл из N строк и подаёт его на stdin программам
+benchmarks/stdin/*.lumen: lines.lumen читает по одной строке через input,
+batch.lumen – пакетами через input_lines(n).
+
+    python benchmarks/stdin_throughput.py [--lumenc bin/lumenc.exe] [--lines 1000000] [--repeat 3]
+"""
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+
+
+def main():
+    default_lumenc = os.path.join(ROOT, "..", "bin", "lumenc.exe" if os.name == "nt" else "lumenc")
+    parser = argparse.ArgumentParser(description="Lumen stdin throughput benchmark")
+    parser.add_argument("--lumenc", default=default_lumenc)
+    parser.add_argument("--lines", type=int, default=1000000)
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    with tempfile.NamedTemporaryFile("w", suffix=".txt", delete=False) as data:
+        for i in range(args.lines):
+            data.write("%d,record-%d,%d.%02d\n" % (i, i * 7, i % 1000, i % 100))
+        data_path = data.name
+
+    print("%-10s %12s %14s" % ("program", "best s", "lines/sec"))
+    failed = False
+    try:
+        for path in sorted(glob.glob(os.path.join(ROOT, "stdin", "*.lumen"))):
+            name = os.path.splitext(os.path.basename(path))[0]
+            best = None
+            for _ in range(args.repeat):
+                with open(data_path, "rb") as stdin:
+                    start = time.perf_counter()
+                    process = subprocess.run([args.lumenc, "--file", path], stdin=stdin,
+                                             stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+                    elapsed = time.perf_counter() - start
+                output = process.stdout.decode(errors="replace")
+                if process.returncode != 0 or str(args.lines) not in output:
+                    sys.stdout.write(output)
+                    failed = True
+                    break
+                best = elapsed if best is None else min(best, elapsed)
+            if best is None:
+                print("%-10s failed" % name)
+                continue
+            print("%-10s %12.3f %14.0f" % (name, best, args.lines / best))
+    finally:
+        os.remove(data_path)
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -11,4 +11,15 @@ try:
     start_t = time.time()
     os.system('clang lumenc.cpp -O3 -DSERVER -std=c++17 -o bin/lumen-ls.exe')
     print(Fore.GREEN + "lumen-ls.exe success compiled." + Fore.BLACK, str(round(time.time() - start_t, 2)) + "ms" + Fore.RESET)
-except:...
\ No newline at end of file
+except:...
+try:
+    start_t = time.time()
+    os.system('clang lumenc.cpp -O3 -DLUMEN_STATS -std=c++17 -o bin/lumenc-stats.exe')
+    print(Fore.GREEN + "lumenc-stats.exe success compiled." + Fore.BLACK, str(round(time.time() - start_t, 2)) + "ms" + Fore.RESET)
+except:...
+try:
+    start_t = time.time()
+    os.system('clang -c liblumen.cpp -O3 -std=c++17 -o bin/liblumen.o')
+    os.system('llvm-ar rcs bin/liblumen.a bin/liblumen.o')
+    print(Fore.GREEN + "liblumen.a success compiled." + Fore.BLACK, str(round(time.time() - start_t, 2)) + "ms" + Fore.RESET)
+except:...
@@ -2484,11 +2484,12 @@ class TwistLangLexer(QsciLexerCustom):
         self.keywords = {
             'if', 'else', 'for', 'while', 'let', 'in', 'and', 'or', 'echo',
             'ret', 'assert', 'lambda', 'do',
-            'struct', 'namespace', 'func', 'continue', 'break'
+            'struct', 'namespace', 'func', 'continue', 'break', 'spawn', 'await', 'yield'
         }
         self.modifiers = {'const', 'static', 'global', 'final', 'private', 'shadow'}
         self.types = {'Int', 'Bool', 'String', 'Char', 'Null', 'Double',
-                      'Namespace', 'Func', 'Lambda', 'auto', "Type", "ptr"}
+                      'Namespace', 'Func', 'Lambda', 'auto', "Type", "ptr", "Map", "Set",
+                      "Future", "Channel", "Generator"}
         self.literals = {'true', 'false', 'null', 'self', 'this'}
         self.directives = {'#define', '#macro', '#include'}
         self.special_keywords = {'new', 'del', 'typeof', 'sizeof', 'out', 'outln', 'input', 'exit'}
@@ -0,0 +1,291 @@
+// liblumen – реализация lumen.h (статическая библиотека, см. compile_all.py)
+#include "lumen.h"
+
+#include "src/twist-interpreter.cpp"
+#include "src/twist-native.cpp"
+#include "src/Nodes/NodeValueHolder.cpp"
+
+#include <deque>
+#include <memory>
+#include <sstream>
+
+// Размер стека потока, в котором разбирается программа (МБ)
+#define COMPILE_STACK_MB 64
+
+namespace lumen {
+
+// ---------- преобразование значений ----------
+
+::Value ToLumen(const Value& value) {
+    switch (value.kind) {
+        case Value::Kind::Null:   return NewNull();
+        case Value::Kind::Int:    return NewInt(value.integer);
+        case Value::Kind::Double: return NewDouble((NUMBER_ACCURACY)value.number);
+        case Value::Kind::Bool:   return NewBool(value.boolean);
+        case Value::Kind::Char:   return NewChar(value.character);
+        case Value::Kind::String: return NewString(value.string);
+        case Value::Kind::Array: {
+            // Тип массива – объединение типов элементов, как у литерала [a, b, ...]
+            vector<::Value> elements;
+            elements.reserve(value.items.size());
+            Type T = Type();
+            for (auto& item : value.items) {
+                elements.push_back(ToLumen(item));
+                T = elements.size() == 1 ? elements.back().type : T | elements.back().type;
+            }
+            T = Type("[" + T.pool + ", ~]");
+            return ::Value(T, Array(T, std::move(elements)));
+        }
+    }
+    return NewNull();
+}
+
+Value ToHost(const ::Value& value) {
+    if (value.type == STANDART_TYPE::NULL_T)
+        return Value();
+    if (value.type == STANDART_TYPE::INT)
+        return Value((long long)any_cast<int64_t>(value.data));
+    if (value.type == STANDART_TYPE::DOUBLE)
+        return Value((double)any_cast<NUMBER_ACCURACY>(value.data));
+    if (value.type == STANDART_TYPE::BOOL)
+        return Value(any_cast<bool>(value.data));
+    if (value.type == STANDART_TYPE::CHAR)
+        return Value(any_cast<char>(value.data));
+    if (value.type == STANDART_TYPE::STRING)
+        return Value(any_cast<const RuntimeString&>(value.data).str());
+    if (value.type.is_array_type()) {
+        vector<Value> items;
+        for (auto& element : any_cast<const Array&>(value.data).values)
+            items.push_back(ToHost(element));
+        return Value(std::move(items));
+    }
+    throw Error("Value of type `" + value.type.pool + "` can not be passed to the host");
+}
+
+// Текст ошибки Lumen для lumen::Error: позиция и сообщение, затем причины
+std::string Describe(const ::Error& err) {
+    std::ostringstream out;
+    out << err.pif << ": " << err.message;
+    for (auto cause = err.sub_error; cause; cause = cause->sub_error)
+        out << "\n" << cause->pif << ": " << cause->message;
+    return out.str();
+}
+
+// ---------- Program ----------
+
+// Функция, зарегистрированная через Program::define
+struct HostNative {
+    ::NativeFunction native;
+    NativeCallback callback;
+};
+
+::Value CallHost(NativeCall& call, void* data) {
+    vector<Value> host;
+    host.reserve(call.args.size());
+    for (auto& arg : call.args)
+        host.push_back(ToHost(arg));
+    return ToLumen(((HostNative*)data)->callback(host));
+}
+
+struct Program::Impl {
+    std::string name;
+    std::string source;
+    vector<Node*> nodes;
+    std::deque<HostNative> natives;     // адреса стабильны – на них ссылаются значения Native
+};
+
+Program::Program() : impl(std::make_unique<Impl>()) {}
+
+Program::~Program() {
+    for (auto node : impl->nodes)
+        delete node;
+}
+
+std::shared_ptr<Program> Program::compile(const std::string& name, const std::string& source,
+                                          std::string* diagnostics) {
+    std::shared_ptr<Program> program(new Program());
+    program->impl->name = name;
+    program->impl->source = source;
+
+    // Разбор – в отдельном контексте: ошибки не завершают процесс
+    RuntimeContext context;
+    std::ostringstream errors;
+    context.source = source;
+    context.diagnostics = &errors;
+    RuntimeContext::Scope scope(&context);
+
+    bool compiled = false;
+    NativeStack::run((size_t)COMPILE_STACK_MB * 1024 * 1024, [&](){
+        try {
+            program->impl->nodes = CompileProgram(name, source, true);
+            compiled = true;
+        } catch (::Error& err) {
+            err.print();
+        } catch (const ProgramExit&) {
+            // Сообщение уже выведено в errors
+        }
+    });
+    ReleaseObjects(context);
+
+    if (diagnostics)
+        *diagnostics = errors.str();
+    return compiled ? program : nullptr;
+}
+
+std::shared_ptr<Program> Program::compile_file(const std::string& path, std::string* diagnostics) {
+    return compile(path, OpenFile(path), diagnostics);
+}
+
+void Program::define(const std::string& name, int arity, NativeCallback callback) {
+    auto& entry = impl->natives.emplace_back();
+    entry.native = ::NativeFunction{name, arity, {}, CallHost, &entry};
+    entry.callback = std::move(callback);
+}
+
+// ---------- Context ----------
+
+struct Context::Impl {
+    std::shared_ptr<Program> program;
+    RuntimeContext context;
+    std::unique_ptr<Memory> memory;
+    std::string output;
+    std::string input;
+    std::ostringstream diagnostics;
+    int exit_code = 0;
+    bool started = false;
+};
+
+// Привязка контекста и границ стека к потоку хоста на время вызова
+struct HostCall {
+    RuntimeContext::Scope scope;
+    char* saved_base;
+    size_t saved_size;
+
+    explicit HostCall(RuntimeContext* context)
+        : scope(context), saved_base(NativeStack::base), saved_size(NativeStack::size) {
+        NativeStack::attach_current();
+    }
+
+    ~HostCall() {
+        OutputBuffer::flush();
+        NativeStack::base = saved_base;
+        NativeStack::size = saved_size;
+    }
+};
+
+Context::Context(std::shared_ptr<Program> program) : impl(std::make_unique<Impl>()) {
+    impl->program = std::move(program);
+    impl->context.source = impl->program->impl->source;
+    impl->context.output.capture = &impl->output;
+    impl->context.input.source = &impl->input;
+    impl->context.diagnostics = &impl->diagnostics;
+
+    RuntimeContext::Scope scope(&impl->context);
+    impl->memory = std::make_unique<Memory>();
+    GenerateStandartTypes(impl->memory.get(), impl->program->impl->name);
+    for (auto& entry : impl->program->impl->natives) {
+        auto object = CreateMemoryObject(NewNative(&entry.native), STANDART_TYPE::NATIVE, impl->memory.get(),
+            true, true, true, true, false, false);
+        impl->memory->add_object(entry.native.name, object);
+        STATIC_MEMORY.register_object(object);
+    }
+}
+
+Context::~Context() {
+    // Задачи spawn используют память контекста – дожидаемся их
+    {
+        RuntimeContext::Scope scope(&impl->context);
+        JoinTasks(false);
+    }
+    ReleaseObjects(impl->context);
+}
+
+bool Context::run() {
+    HostCall bind(&impl->context);
+    impl->started = true;
+    try {
+        for (auto node : impl->program->impl->nodes)
+            node->exec_from(impl->memory.get());
+        JoinTasks();
+    } catch (::Error& err) {
+        err.print();
+        impl->exit_code = 1;
+        return false;
+    } catch (const ProgramExit& exit) {
+        impl->exit_code = exit.fatal ? 1 : exit.code;
+        return impl->exit_code == 0;
+    }
+    return true;
+}
+
+Value Context::call(const std::string& name, const std::vector<Value>& args) {
+    if (!impl->started && !run())
+        throw Error("Program '" + impl->program->impl->name + "' failed before calling '" + name + "'");
+
+    HostCall bind(&impl->context);
+    auto object = impl->memory->get_variable(name);
+    auto builtin = object ? nullptr : NativeRegistry::find(Symbol(name));
+    if (!object && !builtin)
+        throw Error("'" + name + "' is not defined");
+    ::Value callee = object ? object->value : *builtin;
+
+    // Токены сигнатуры – позиция для сообщений об ошибках вызова
+    Token start, end;
+    if (callee.type.is_func()) {
+        auto func = any_cast<Function*>(callee.data);
+        start = func->start_args_token;
+        end = func->end_args_token;
+    } else if (callee.type == STANDART_TYPE::LAMBDA) {
+        auto lambda = any_cast<Lambda*>(callee.data);
+        start = lambda->start_args_token;
+        end = lambda->end_args_token;
+    } else if (callee.type != STANDART_TYPE::NATIVE) {
+        throw Error("'" + name + "' of type `" + callee.type.pool + "` is not callable");
+    }
+
+    vector<std::unique_ptr<Node>> holders;
+    vector<Node*> arg_nodes;
+    for (auto& arg : args) {
+        holders.push_back(std::make_unique<NodeValueHolder>(ToLumen(arg)));
+        arg_nodes.push_back(holders.back().get());
+    }
+    NodeValueHolder callable(callee);
+    NodeCall call(&callable, arg_nodes, start, end);
+
+    try {
+        auto result = call.invoke(callee, impl->memory.get());
+        JoinTasks();
+        return ToHost(result);
+    } catch (::Error& err) {
+        err.print();
+        throw Error(Describe(err));
+    } catch (const ProgramExit& exit) {
+        impl->exit_code = exit.fatal ? 1 : exit.code;
+        if (exit.fatal)
+            throw Error("Fatal error in '" + name + "', see diagnostics()");
+        throw Error("Program exited with code " + to_string(exit.code) + " in '" + name + "'");
+    }
+}
+
+void Context::set_input(std::string input) {
+    impl->input = std::move(input);
+    impl->context.input.source_offset = 0;
+    impl->context.input.begin = impl->context.input.end = 0;
+    impl->context.input.eof = false;
+}
+
+std::string Context::take_output() {
+    std::string output;
+    output.swap(impl->output);
+    return output;
+}
+
+std::string Context::diagnostics() const {
+    return impl->diagnostics.str();
+}
+
+int Context::exit_code() const {
+    return impl->exit_code;
+}
+
+}
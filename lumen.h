@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#pragma once
+
+/*
+ * lumen.h – C++ API для встраивания Lumen в приложение (bin/liblumen.a,
+ * собирается compile_all.py из liblumen.cpp).
+ *
+ * Программа разбирается один раз (Program::compile), после чего из одного
+ * AST создаётся сколько угодно лёгких контекстов выполнения (Context): у
+ * каждого своя глобальная память, реестр объектов, вывод и журнал ошибок.
+ * Разные контексты можно использовать одновременно из разных потоков; один
+ * контекст – из одного потока за раз.
+ *
+ *     std::string errors;
+ *     auto program = lumen::Program::compile("rules.lumen", source, &errors);
+ *     program->define("log", 1, [](const std::vector<lumen::Value>& args) {
+ *         std::cerr << args[0].string << std::endl;
+ *         return lumen::Value();
+ *     });
+ *
+ *     lumen::Context context(program);
+ *     context.run();                                  // верхний уровень программы
+ *     lumen::Value score = context.call("score", {lumen::Value(42), lumen::Value("gold")});
+ *
+ * Значения между приложением и Lumen передаются как lumen::Value: Null, Int,
+ * Double, Bool, Char, String и массивы из них. Ошибки Lumen при call()
+ * выбрасываются как lumen::Error (полный текст – в Context::diagnostics()).
+ */
+
+namespace lumen {
+
+struct Value {
+    enum class Kind { Null, Int, Double, Bool, Char, String, Array };
+
+    Kind kind = Kind::Null;
+    int64_t integer = 0;
+    double number = 0;
+    bool boolean = false;
+    char character = 0;
+    std::string string;
+    std::vector<Value> items;
+
+    Value() {}
+    Value(int value) : kind(Kind::Int), integer(value) {}
+    Value(long value) : kind(Kind::Int), integer(value) {}
+    Value(long long value) : kind(Kind::Int), integer(value) {}
+    Value(double value) : kind(Kind::Double), number(value) {}
+    Value(bool value) : kind(Kind::Bool), boolean(value) {}
+    Value(char value) : kind(Kind::Char), character(value) {}
+    Value(const char* value) : kind(Kind::String), string(value) {}
+    Value(std::string value) : kind(Kind::String), string(std::move(value)) {}
+    Value(std::vector<Value> values) : kind(Kind::Array), items(std::move(values)) {}
+
+    bool is_null() const { return kind == Kind::Null; }
+};
+
+struct Error : std::runtime_error {
+    explicit Error(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Нативная функция, вызываемая из Lumen. Исключение std::exception
+// становится ошибкой Lumen в месте вызова.
+using NativeCallback = std::function<Value(const std::vector<Value>&)>;
+
+class Program {
+public:
+    // Разбор исходного текста; при ошибке – nullptr, текст ошибки в diagnostics
+    static std::shared_ptr<Program> compile(const std::string& name, const std::string& source,
+                                            std::string* diagnostics = nullptr);
+    static std::shared_ptr<Program> compile_file(const std::string& path, std::string* diagnostics = nullptr);
+
+    // Регистрация нативной функции name (arity -1 – любое число аргументов).
+    // Вызывается до создания контекстов; callback может вызываться из
+    // нескольких потоков одновременно.
+    void define(const std::string& name, int arity, NativeCallback callback);
+
+    ~Program();
+
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+private:
+    Program();
+};
+
+class Context {
+public:
+    explicit Context(std::shared_ptr<Program> program);
+    ~Context();
+
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    // Выполнение верхнего уровня программы (объявления функций, переменных).
+    // false – ошибка или exit с ненулевым кодом.
+    bool run();
+
+    // Вызов функции, объявленной в программе (или нативной). Если run() ещё
+    // не вызывался, он выполняется первым.
+    Value call(const std::string& name, const std::vector<Value>& args = {});
+
+    // Данные для input (вместо stdin)
+    void set_input(std::string input);
+    // Вывод программы (out/outln) с прошлого вызова take_output()
+    std::string take_output();
+    // Сообщения об ошибках в формате терминала
+    std::string diagnostics() const;
+    int exit_code() const;
+
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+}
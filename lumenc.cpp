@@ -3,6 +3,10 @@
 #include "src/twist-utils.cpp"
 #include "src/twist-tokenwalker.cpp"
 #include "src/twist-parser.cpp"
+#include "src/twist-optimizer.cpp"
+#include "src/twist-instrument.cpp"
+#include "src/twist-bench.cpp"
+#include "src/twist-interpreter.cpp"
 
 #include "fstream"
 #include <filesystem>
@@ -20,6 +24,8 @@ void run_with(vector<Node*>* nodes, Memory* g_memory) {
     for (size_t i = 0; i < nodes->size(); i++) {
         (*nodes)[i]->exec_from(g_memory);
     }
+    // Программа завершается вместе со своими задачами spawn
+    JoinTasks();
 }
 
 void write_error_to_file(std::ostream& out, const Error& err) {
@@ -49,13 +55,15 @@ vector<Error> run_with_collect(vector<Node*>& nodes, Memory* mem) {
 }
 
 void language_server(const std::string& file_path, std::string file_name) {
-    Error::ClearBuffer();
+    // Отдельный контекст: состояние проверки не попадает в контекст процесса
+    RuntimeContext context;
+    RuntimeContext::Scope scope(&context);
+    NativeStack::attach_current();
     std::unique_ptr<Memory> g_memory = std::make_unique<Memory>();
 
     try {
         std::string source = OpenFile(file_path);
-        ERROR::PREPROCESSOR_OUTPUT = source;
-        ERROR_THROW::PREPROCESSOR_OUTPUT = source;
+        context.source = source;
 
         // 1. Лексирование (только основного файла)
         Lexer lexer(file_path, source);
@@ -88,6 +96,8 @@ void language_server(const std::string& file_path, std::string file_name) {
 
     } catch (const Error& err) {
         err.Write();
+    } catch (const ProgramExit&) {
+        // Фатальная ошибка уже выведена
     } catch (const std::exception& e) {
         // Игнорируем
     }
@@ -96,9 +106,6 @@ void language_server(const std::string& file_path, std::string file_name) {
     std::ofstream log(string("dbg/") + file_name + "_ls.dbg", std::ios::trunc);
     log << Error::GetBuffer();
     log.close();
-
-    GlobalMemory::all_objects.clear();
-    AddressManager::reset();
 }
 
 int main(int argc, char** argv) {
@@ -114,26 +121,30 @@ int main(int argc, char** argv) {
         // Обычный запуск или компиляция
         static string file_content = OpenFile(args_parser.file_path);
 
-        ERROR::PREPROCESSOR_OUTPUT = file_content;
-        ERROR_THROW::PREPROCESSOR_OUTPUT = file_content;
+        RuntimeContext::current().source = file_content;
 
         if (!args_parser.compile_mod) {
             if (args_parser.save_preprocessed)
                 SavePreprocessedFile("output.twist", file_content);
 
             static Lexer parser = Lexer(args_parser.file_path, file_content);
+            PhaseTimes phases;
 
-            TimeIt("Parse finished in ", [](){
-                parser.run();
+            phases.measure("lex", [](){
+                TimeIt("Parse finished in ", [](){
+                    parser.run();
+                });
             });
 
             Preprocessor preprocessor = Preprocessor();
             vector<Token> preprocessed_tokens;
-            try {
-                preprocessed_tokens = preprocessor.process(parser.tokens, args_parser.file_path);
-            } catch (Error& err) {
-                err.print();
-            }
+            phases.measure("preprocess", [&](){
+                try {
+                    preprocessed_tokens = preprocessor.process(parser.tokens, args_parser.file_path);
+                } catch (Error& err) {
+                    err.print();
+                }
+            });
             if (args_parser.save_token) {
                 SaveTokensFile("tokens.txt", parser.tokens);
                 SaveTokensFile("ptokens.txt", preprocessed_tokens);
@@ -143,39 +154,114 @@ int main(int argc, char** argv) {
 
             TokenWalker walker = TokenWalker(&parser.tokens);
             ASTGenerator generator = ASTGenerator(walker, args_parser.file_path);
+            unordered_map<Node*, PosInFile> statement_positions;
+            if (args_parser.profile)
+                generator.statement_positions = &statement_positions;
+
+            phases.measure("parse", [&](){
+                try {
+                    generator.parse();
+                } catch (Error& err) {
+                    err.print();
+                }
+            });
 
-            try {
-                generator.parse();
-            } catch (Error& err) {
-                err.print();
+            auto nodes = std::move(generator.nodes);
+            if (args_parser.optimize) {
+                phases.measure("optimize", [&](){
+                    ASTOptimizer optimizer;
+                    if (args_parser.profile)
+                        optimizer.statement_positions = &statement_positions;
+                    optimizer.optimize(nodes);
+                });
+            }
+            if (args_parser.profile) {
+                ASTInstrumenter instrumenter(statement_positions);
+                instrumenter.instrument(nodes);
             }
 
-            auto nodes = std::move(generator.nodes);
-            auto g_memory = new Memory();
-            GenerateStandartTypes(g_memory, args_parser.file_path);
-
-            if (args_parser.middle_run_time) {
-                middleTimeIt("Middle interpretation time compute", [&](){
-                    GenerateStandartTypes(g_memory, args_parser.file_path);
-                    run_with(&nodes, g_memory);
-                    g_memory->clear();
-                }, 100);
-                exit(0);
-            } else {
-                if (args_parser.run_time)
-                    TimeIt("Parse finished in ", [&](){
+            std::unique_ptr<Memory> g_memory = std::make_unique<Memory>();
+            GenerateStandartTypes(g_memory.get(), args_parser.file_path);
+
+            // Интерпретация выполняется в потоке с явно заданным размером стека,
+            // глубину рекурсии ограничивают -rl и реальный запас этого стека
+            max_recursion_depth = args_parser.recursion_limit;
+            memoize_pure_functions = args_parser.memoize;
+            quicken_nodes = args_parser.quicken;
+            jit_enabled = args_parser.jit;
+            MemoCache::default_capacity = args_parser.memo_capacity;
+            WorkerPool::threads = args_parser.threads;
+            OutputBuffer::attach(args_parser.out_fd);
+            if (args_parser.profile)
+                Profiler::start();
+            NativeStack::run(args_parser.stack_size_mb * 1024 * 1024, [&](){
+                if (args_parser.benchmark) {
+                    BenchmarkOptions options;
+                    options.warmup = args_parser.bench_warmup;
+                    options.iterations = args_parser.bench_iterations;
+                    options.time_budget_ms = args_parser.bench_time_ms;
+                    options.quiet = args_parser.bench_quiet;
+
+                    // Каждая итерация – с чистой памяти программы: объекты прошлой
+                    // итерации удаляются вместе с её глобальной памятью. Состояние
+                    // самих узлов AST (квикенинг) сохраняется между итерациями,
+                    // поэтому после прогрева замеряется уже специализированный код
+                    auto result = RunBenchmark(options, [&](){
+                        JoinTasks(false);
+                        ReleaseObjects(RuntimeContext::current());
+                        AddressManager::reset();
+                        MemoizedFunctions().clear();
+                        g_memory = std::make_unique<Memory>();
+                        GenerateStandartTypes(g_memory.get(), args_parser.file_path);
+                    }, [&](){
                         try {
-                            run_with(&nodes, g_memory);
+                            run_with(&nodes, g_memory.get());
                         } catch (Error& err) {
                             err.print();
                         }
                     });
-                else
-                    try {
-                        run_with(&nodes, g_memory);
-                    } catch (Error& err) {
-                        err.print();
-                    }
+
+                    PrintBenchmark(args_parser.file_name, options, result);
+                    if (!args_parser.bench_json.empty() &&
+                        !WriteBenchmarkJson(args_parser.bench_json, args_parser.file_name, options, result))
+                        cout << MT::ERROR << "Cannot write benchmark results to '" << args_parser.bench_json << "'" << endl;
+                    // Этап выполнения в режиме -bench – медиана замеров
+                    phases.add("execute", result.median_ns);
+                    if (!args_parser.phases_json.empty() && !phases.write_json(args_parser.phases_json))
+                        cout << MT::ERROR << "Cannot write phase times to '" << args_parser.phases_json << "'" << endl;
+                    exit(0);
+                } else {
+                    phases.measure("execute", [&](){
+                        if (args_parser.run_time)
+                            TimeIt("Parse finished in ", [&](){
+                                try {
+                                    run_with(&nodes, g_memory.get());
+                                } catch (Error& err) {
+                                    err.print();
+                                }
+                                OutputBuffer::flush();
+                            });
+                        else
+                            try {
+                                run_with(&nodes, g_memory.get());
+                            } catch (Error& err) {
+                                err.print();
+                            }
+                        OutputBuffer::flush();
+                    });
+                }
+            });
+
+            if (!args_parser.phases_json.empty() && !phases.write_json(args_parser.phases_json))
+                cout << MT::ERROR << "Cannot write phase times to '" << args_parser.phases_json << "'" << endl;
+
+            if (args_parser.memo_stats)
+                PrintMemoStats();
+            if (args_parser.stats)
+                RuntimeStats::print(cout);
+            if (args_parser.profile) {
+                Profiler::finish();
+                WriteProfile(args_parser.profile_format, args_parser.profile_output);
             }
         } else {
             // Компиляторный режим (без изменений)
@@ -213,6 +299,7 @@ int main(int argc, char** argv) {
                     out_file << "    for (size_t i = 0; i < nodes->size(); i++) {\n";
                     out_file << "        (*nodes)[i]->exec_from(g_memory);\n";
                     out_file << "    }\n";
+                    out_file << "    JoinTasks();\n";
                     out_file << "}\n\n";
 
                     out_file << "// ================================================================\n";
@@ -17,23 +17,25 @@ struct NodeAddressOf : public Node { NO_EXEC
         // Сначала вычислим выражение, чтобы получить его тип (нужен для указателя)
         Value val = expr->eval_from(_memory);
 
-        while (expr->NODE_TYPE == NodeTypes::NODE_SCOPES) {
-            expr = static_cast<NodeScopes*>(expr)->expression;
+        // Скобки снимаются в локальной переменной – узел не меняется при выполнении
+        Node* target = expr;
+        while (target->NODE_TYPE == NodeTypes::NODE_SCOPES) {
+            target = static_cast<NodeScopes*>(target)->expression;
         }
 
         // Обрабатываем литерал (простая переменная)
-        if (expr->NODE_TYPE == NodeTypes::NODE_LITERAL) {
-            NodeLiteral* lit = static_cast<NodeLiteral*>(expr);
+        if (target->NODE_TYPE == NodeTypes::NODE_LITERAL) {
+            NodeLiteral* lit = static_cast<NodeLiteral*>(target);
             int addr = _memory->get_variable(lit->name)->address;
             return NewPointer(addr, val.type);
         }
         // Обрабатываем разрешение имени (namespace::var)
-        else if (expr->NODE_TYPE == NodeTypes::NODE_NAME_RESOLUTION) {
-            auto [mem, var_name] = resolveTargetMemory(expr, _memory);
+        else if (target->NODE_TYPE == NodeTypes::NODE_NAME_RESOLUTION) {
+            auto [mem, var_name] = resolveTargetMemory(target, _memory);
             int addr = mem->get_variable(var_name)->address;
             return NewPointer(addr, val.type);
         }
 
-        throw ERROR_THROW::CanNotGetAddress(start, end, expr->NODE_TYPE);
+        throw ERROR_THROW::CanNotGetAddress(start, end, target->NODE_TYPE);
     }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-errors.cpp"
+#include "../twist-err.cpp"
 #include "../twist-array.cpp"
 
 #include "NodeObjectResolution.cpp"
@@ -7,6 +8,8 @@
 #include "NodeLiteral.cpp"
 #include "NodeDereference.cpp"
 
+#pragma once
+
 
 struct NodeArrayPush : public Node { NO_EXEC
     Node* left_expr;
@@ -17,12 +20,12 @@ struct NodeArrayPush : public Node { NO_EXEC
     NodeArrayPush(Node* left_expr, Node* right_expr, Token start_token, Token end_token)
         : left_expr(left_expr), right_expr(right_expr), start_token(start_token), end_token(end_token) {
         this->NODE_TYPE = NodeTypes::NODE_ARRAY_PUSH;
+        if (this->left_expr->NODE_TYPE == NodeTypes::NODE_SCOPES) {
+            this->left_expr = ((NodeScopes*)(this->left_expr))->expression;
+        }
     }
 
     Value eval_from(Memory* _memory) override {
-        if (left_expr->NODE_TYPE == NodeTypes::NODE_SCOPES) {
-            left_expr = ((NodeScopes*)(left_expr))->expression;
-        }
         // ОПТИМИЗАЦИЯ: Проверяем тип левого выражения
         // Если это простая переменная (NODE_LITERAL), модифицируем её в памяти напрямую
         if (left_expr->NODE_TYPE == NodeTypes::NODE_LITERAL) {
@@ -30,6 +33,8 @@ struct NodeArrayPush : public Node { NO_EXEC
             MemoryObject* var_obj = _memory->get_variable(var_name);
 
             if (var_obj && var_obj->value.type.is_array_type()) {
+                if (IsSharedObject(var_obj))
+                    throw ERROR_THROW::ParallelSharedWrite(start_token, end_token, var_name);
                 auto right_value = right_expr->eval_from(_memory);
                 // Проверка типа элемента массива
                 auto& arr = any_cast<Array&>(var_obj->value.data);
@@ -57,6 +62,8 @@ struct NodeArrayPush : public Node { NO_EXEC
                 if (ns.memory->check_literal(var_name)) {
                     MemoryObject* var_obj = ns.memory->get_variable(var_name);
                     if (var_obj && var_obj->value.type.is_array_type()) {
+                        if (IsSharedObject(var_obj))
+                            throw ERROR_THROW::ParallelSharedWrite(start_token, end_token, var_name);
                         auto right_value = right_expr->eval_from(_memory);
                         auto& arr = any_cast<Array&>(var_obj->value.data);
                         auto arr_type_pair = arr.type.parse_array_type();
@@ -96,6 +103,8 @@ struct NodeArrayPush : public Node { NO_EXEC
             if (!obj->value.type.is_array_type()) {
                 ERROR::InvalidArrayPushType(start_token, end_token, obj->value.type.pool);
             }
+            if (IsSharedObject(obj))
+                throw ERROR_THROW::ParallelSharedWrite(start_token, end_token, obj->var_name);
 
             auto right_value = right_expr->eval_from(_memory);
             auto& arr = any_cast<Array&>(obj->value.data);
@@ -30,7 +30,7 @@ struct NodeAssert : public Node { NO_EVAL
                 auto message_value = message_expr->eval_from(_memory);
                 if (message_value.type != STANDART_TYPE::STRING) 
                     throw ERROR_THROW::AssertionInvalidMessage(message_start, message_end);
-                throw ERROR_THROW::AssertionFailed(start_token, end_token, any_cast<string&>(message_value.data));
+                throw ERROR_THROW::AssertionFailed(start_token, end_token, any_cast<RuntimeString&>(message_value.data).str());
             }
             throw ERROR_THROW::AssertionFailed(start_token, end_token);
         }
@@ -1,10 +1,14 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-errors.cpp"
 #include "../twist-array.cpp"
+#include "../twist-map.cpp"
 #include "../twist-err.cpp"
+#include "../twist-quicken.cpp"
 
 #include "NodeLiteral.cpp"
 
+#pragma once
+
 /*
  * NodeBinary – узел бинарной операции.
  *
@@ -21,6 +25,8 @@
  * - Для указателей реализована арифметика (+, -) и сравнения.
  * - Для типов (Type) поддерживаются операции объединения (|), проверка подтипа (<<, >>)
  *   и сравнение на равенство.
+ * - `x in m` – проверка ключа Map / элемента Set; переменная справа читается
+ *   на месте, без копирования таблицы.
  * - В случае несовместимых типов или неподдерживаемого оператора генерируется
  *   ошибка времени выполнения.
  *
@@ -30,25 +36,149 @@
  *   start_token, end_token, op_token – токены для позиционирования ошибок.
  *
  * eval_from() вычисляет левый операнд, затем, если требуется, правый, и возвращает
- * результат операции в виде нового Value.
+ * результат операции в виде нового Value. Сама операция – compute().
+ *
+ * Квикенинг (twist-quicken.cpp): арифметика и сравнения после прогрева
+ * переключаются на вариант Int-Int, Double-Double или String-String (для
+ * строк – +, ==, !=), без цепочки сравнений типов и строк оператора.
+ * Специализированные варианты повторяют обобщённый путь, включая
+ * вычисления Double во float; деление и остаток на ноль уходят в compute().
  */
 
 struct NodeBinary : public Node { NO_EXEC
+    // Операторы со специализированными вариантами
+    enum QuickOp : uint8_t { Q_NONE, Q_ADD, Q_SUB, Q_MUL, Q_DIV, Q_POW, Q_MOD, Q_EQ, Q_NE, Q_LE, Q_GE, Q_LT, Q_GT };
+
     Node* left;
     Node* right;
     string op;
+    bool is_in;
+    QuickOp quick_op;
+    QuickeningState quickening;
 
     Token& start_token;
     Token& end_token;
     Token& op_token;
 
     NodeBinary(Node* left, const string& operation, Node* right, Token& start_token, Token& end_token, Token& op_token)
-        : left(left), right(right), op(operation), start_token(start_token), end_token(end_token), op_token(op_token) {
+        : left(left), right(right), op(operation), is_in(operation == "in"), quick_op(ParseQuickOp(operation)),
+          start_token(start_token), end_token(end_token), op_token(op_token) {
             this->NODE_TYPE = NodeTypes::NODE_BINARY;
+            if (quick_op == Q_NONE)
+                quickening.mode = QuickMode::GENERIC;
         }
 
+    static QuickOp ParseQuickOp(const string& op) {
+        if (op == "+") return Q_ADD;
+        if (op == "-") return Q_SUB;
+        if (op == "*") return Q_MUL;
+        if (op == "/") return Q_DIV;
+        if (op == "**") return Q_POW;
+        if (op == "%") return Q_MOD;
+        if (op == "==") return Q_EQ;
+        if (op == "!=") return Q_NE;
+        if (op == "<=") return Q_LE;
+        if (op == ">=") return Q_GE;
+        if (op == "<") return Q_LT;
+        if (op == ">") return Q_GT;
+        return Q_NONE;
+    }
+
+    // Выбор варианта по типам операндов после прогрева
+    void quicken(const Value& left_val, const Value& right_val) {
+        QuickMode mode = ObservePair(left_val, right_val);
+        if (mode == QuickMode::STRING_STRING && quick_op != Q_ADD && quick_op != Q_EQ && quick_op != Q_NE)
+            mode = QuickMode::GENERIC;
+        quickening.specialize(mode);
+    }
+
+    Value int_operation(int64_t l, int64_t r) {
+        switch (quick_op) {
+            case Q_ADD: return NewInt(l + r);
+            case Q_SUB: return NewInt(l - r);
+            case Q_MUL: return NewInt(l * r);
+            case Q_DIV: return NewInt(l / r);
+            case Q_POW: return NewInt(pow(l, r));
+            case Q_MOD: return NewInt(l % r);
+            case Q_EQ:  return NewBool(l == r);
+            case Q_NE:  return NewBool(l != r);
+            case Q_LE:  return NewBool(l <= r);
+            case Q_GE:  return NewBool(l >= r);
+            case Q_LT:  return NewBool(l < r);
+            default:    return NewBool(l > r);
+        }
+    }
+
+    // Как в compute(): операнды Double приводятся к float
+    Value double_operation(float l, float r) {
+        switch (quick_op) {
+            case Q_ADD: return NewDouble(l + r);
+            case Q_SUB: return NewDouble(l - r);
+            case Q_MUL: return NewDouble(l * r);
+            case Q_DIV: return NewDouble(l / r);
+            case Q_POW: return NewDouble(pow(l, r));
+            case Q_MOD: return NewDouble(l - floor(l / r) * r);
+            case Q_EQ:  return NewBool(l == r);
+            case Q_NE:  return NewBool(l != r);
+            case Q_LE:  return NewBool(l <= r);
+            case Q_GE:  return NewBool(l >= r);
+            case Q_LT:  return NewBool(l < r);
+            default:    return NewBool(l > r);
+        }
+    }
+
+    // Специализированный вариант; при промахе стража – деоптимизация и compute()
+    Value eval_quick(QuickMode mode, Memory* _memory) {
+        auto left_val = left->eval_from(_memory);
+        auto right_val = right->eval_from(_memory);
+        switch (mode) {
+            case QuickMode::INT_INT: {
+                auto l = QuickInt(left_val), r = QuickInt(right_val);
+                if (l && r && (*r != 0 || (quick_op != Q_DIV && quick_op != Q_MOD)))
+                    return int_operation(*l, *r);
+                break;
+            }
+            case QuickMode::DOUBLE_DOUBLE: {
+                auto l = QuickDouble(left_val), r = QuickDouble(right_val);
+                if (l && r && ((float)*r != 0 || quick_op != Q_DIV))
+                    return double_operation((float)*l, (float)*r);
+                break;
+            }
+            case QuickMode::STRING_STRING: {
+                auto l = QuickString(left_val), r = QuickString(right_val);
+                if (!l || !r)
+                    break;
+                if (quick_op == Q_EQ) return NewBool(*l == *r);
+                if (quick_op == Q_NE) return NewBool(*l != *r);
+                return NewString(RuntimeString::concat(*l, *r));
+            }
+            default:
+                break;
+        }
+        quickening.deoptimize();
+        return compute(left_val, right_val, _memory);
+    }
+
+    Value contains(const Value& key_val, const Value& table_val) {
+        if (table_val.type != STANDART_TYPE::MAP && table_val.type != STANDART_TYPE::SET)
+            throw ERROR_THROW::UnsupportedBinaryOperator(start_token, end_token, op_token, key_val.type, table_val.type);
+        TableKey key(key_val);
+        if (!key.valid())
+            throw ERROR_THROW::MapInvalidKeyType(start_token, end_token, key_val.type);
+        return NewBool(any_cast<const ValueTable&>(table_val.data).contains(key));
+    }
+
     Value eval_from(Memory* _memory) override {
+        auto mode = quickening.current();
+        if (mode != QuickMode::WARMUP && mode != QuickMode::GENERIC)
+            return eval_quick(mode, _memory);
+
         auto left_val = left->eval_from(_memory);
+        if (is_in) {
+            if (right->NODE_TYPE == NodeTypes::NODE_LITERAL)
+                return contains(left_val, ((NodeLiteral*)right)->lookup(_memory));
+            return contains(left_val, right->eval_from(_memory));
+        }
         if (left_val.type == STANDART_TYPE::BOOL) {
             bool l = any_cast<bool>(left_val.data);
             if ((op == "||" || op == "or") && l)
@@ -57,6 +187,13 @@ struct NodeBinary : public Node { NO_EXEC
                 return NewBool(false);
         }
         auto right_val = right->eval_from(_memory);
+        if (mode == QuickMode::WARMUP && quickening.tick())
+            quicken(left_val, right_val);
+        return compute(left_val, right_val, _memory);
+    }
+
+    // Операция над уже вычисленными операндами (также используется слитыми узлами)
+    Value compute(Value& left_val, Value& right_val, Memory* _memory) {
         if (left_val.type == STANDART_TYPE::INT && right_val.type == STANDART_TYPE::INT) {
             int64_t l = any_cast<int64_t>(left_val.data);
             int64_t r = any_cast<int64_t>(right_val.data);
@@ -167,13 +304,14 @@ struct NodeBinary : public Node { NO_EXEC
             throw ERROR_THROW::UnsupportedBinaryOperator(start_token, end_token, op_token, left_val.type, right_val.type);
         } else if (left_val.type == STANDART_TYPE::STRING && right_val.type == STANDART_TYPE::STRING) {
             if (op == "==")
-                return NewBool(any_cast<string>(left_val.data) == any_cast<string>(right_val.data));
+                return NewBool(any_cast<const RuntimeString&>(left_val.data) == any_cast<const RuntimeString&>(right_val.data));
 
             if (op == "!=")
-                return NewBool(any_cast<string>(left_val.data) != any_cast<string>(right_val.data));
+                return NewBool(any_cast<const RuntimeString&>(left_val.data) != any_cast<const RuntimeString&>(right_val.data));
 
             if (op == "+")
-                return NewString(any_cast<string>(left_val.data) + any_cast<string>(right_val.data));
+                return NewString(RuntimeString::concat(any_cast<const RuntimeString&>(left_val.data),
+                                                       any_cast<const RuntimeString&>(right_val.data)));
             throw ERROR_THROW::UnsupportedBinaryOperator(start_token, end_token, op_token, left_val.type, right_val.type);
 
         } else if (left_val.type == STANDART_TYPE::CHAR && right_val.type == STANDART_TYPE::CHAR) {
@@ -188,11 +326,12 @@ struct NodeBinary : public Node { NO_EXEC
             throw ERROR_THROW::UnsupportedBinaryOperator(start_token, end_token, op_token, left_val.type, right_val.type);
         } else if (left_val.type == STANDART_TYPE::STRING && right_val.type == STANDART_TYPE::INT) {
             if (op == "*") {
-                string dummy;
+                auto& str = any_cast<const RuntimeString&>(left_val.data);
+                RuntimeString dummy;
                 for (int i = 0; i < any_cast<int64_t>(right_val.data); i++) {
-                    dummy += any_cast<string>(left_val.data);
+                    dummy.append(str.data(), str.size());
                 }
-                return NewString(dummy);
+                return NewString(std::move(dummy));
             }
             throw ERROR_THROW::UnsupportedBinaryOperator(start_token, end_token, op_token, left_val.type, right_val.type);
 
@@ -10,7 +10,9 @@
  * Не содержит дополнительных полей.
  */
 
-struct Break {};
+struct Break {
+    Break() { STAT_INC(throws_break); }
+};
 
 struct NodeBreak : public Node { NO_EVAL
     NodeBreak() {
@@ -5,32 +5,71 @@
 #include "../twist-err.cpp"
 #include "../twist-lambda.cpp"
 #include "../twist-array.cpp"
+#include "../twist-map.cpp"
 #include "../twist-namespace.cpp"
+#include "../twist-native.cpp"
+#include "../twist-builtins.cpp"
+#include "../twist-generators.cpp"
 
 
 #include "NodeReturn.cpp"
+#include "NodeIf.cpp"
+#include "NodeScopes.cpp"
+#include "../twist-stack.cpp"
+#include "../twist-profiler.cpp"
 #include <any>
 #include <cstdint>
+#include <memory>
+
+#pragma once
 
 #define MAX_RECURSION 100
 
 // ---------- защита от переполнения стека вызовов ----------
-static int recursion_depth = 0;   // общий для всех функций/лямбд
+// Текущая глубина – RuntimeContext::recursion_depth (общая для всех функций/лямбд)
+static int max_recursion_depth = MAX_RECURSION;   // 0 – без ограничения по числу вызовов
 
 struct RecursionGuard {
     const Token& start;
     const Token& end;
     RecursionGuard(const Token& s, const Token& e) : start(s), end(e) {
         
-        if (recursion_depth >= MAX_RECURSION) {
+        int& recursion_depth = RuntimeContext::current().recursion_depth;
+        if (max_recursion_depth > 0 && recursion_depth >= max_recursion_depth) {
             throw ERROR_THROW::MaxRecursionDepthExceeded(start, end);
         }
+        if (NativeStack::exhausted()) {
+            throw ERROR_THROW::NativeStackExhausted(start, end);
+        }
         ++recursion_depth;
+        STAT_PEAK(peak_call_depth, recursion_depth);
     }
-    ~RecursionGuard() { --recursion_depth; }
+    ~RecursionGuard() { --RuntimeContext::current().recursion_depth; }
+};
+
+// Учёт выполняемых тел функций для NodeReturn (хвостовые вызовы)
+struct FunctionFrameGuard {
+    FunctionFrameGuard() { ++RuntimeContext::current().active_function_frames; }
+    ~FunctionFrameGuard() { --RuntimeContext::current().active_function_frames; }
 };
 // ----------------------------------------------------------
 
+// Записи профиля вызываемых объектов (nullptr, если --profile выключен
+// или поток не профилируется)
+static ProfileEntry* ProfileEntryOf(Function* func) {
+    if (!Profiler::recording()) return nullptr;
+    return Profiler::function_entry(func, func->name, func->start_args_token.pif);
+}
+
+static ProfileEntry* ProfileEntryOf(Lambda* lambda) {
+    if (!Profiler::recording()) return nullptr;
+    return Profiler::function_entry(lambda, lambda->name.empty() ? "lambda" : lambda->name,
+                                    lambda->start_args_token.pif);
+}
+
+
+// Определена в twist-jit.cpp (компилятору нужны все типы узлов)
+bool JitInvoke(Function* func, vector<Node*>& args, Memory* _memory, vector<Value>& evaluated, Value& result);
 
 struct NodeCall : public Node { NO_EXEC
     Node* callable;
@@ -58,14 +97,16 @@ struct NodeCall : public Node { NO_EXEC
         this->NODE_TYPE = NodeTypes::NODE_CALL;
     }
 
-    Value call_lambda(Value &value, Memory* _memory) {
+    // Создание памяти вызова лямбды и связывание аргументов.
+    // Аргументы берутся из узлов этого вызова и вычисляются в arg_memory.
+    Memory* bind_lambda_arguments(Value &value, Memory* arg_memory) {
         auto lambda = any_cast<Lambda*>(value.data);
 
         // Создаём новую память для этого вызова
         auto call_memory = new Memory();
 
         // Копируем глобальные объекты из памяти лямбды (разделяемое владение)
-        lambda->memory->link_objects(call_memory);
+        DeclarationMemory(lambda->memory)->link_objects(call_memory);
 
         // Добавляем саму лямбду в новую память, если у неё есть имя (для рекурсии)
         if (!lambda->name.empty()) {
@@ -82,14 +123,16 @@ struct NodeCall : public Node { NO_EXEC
 
         // Добавляем аргументы в новую память
         for (size_t i = 0; i < args.size(); i++) {
-            auto arg_value = args[i]->eval_from(_memory);
+            auto arg_value = args[i]->eval_from(arg_memory);
 
             // Проверка типа аргумента (используем исходную память лямбды для вычисления ожидаемого типа)
             if (lambda->arguments[i]->type_expr) {
-                auto expected_type_val = lambda->arguments[i]->type_expr->eval_from(lambda->memory);
-                Type expected = extract_type_from_value(expected_type_val,
+                Type evaluated;
+                const Type& expected = lambda->argument_type_cached[i] ?
+                    lambda->argument_types[i] :
+                    (evaluated = extract_type_from_value(lambda->arguments[i]->type_expr->eval_from(DeclarationMemory(lambda->memory)),
                                     lambda->start_args_token, lambda->end_args_token,
-                                    "parameter '" + lambda->arguments[i]->name + "'");
+                                    "parameter '" + lambda->arguments[i]->name + "'"));
                 if (!arg_value.type.is_sub_type(expected)) {
                     throw ERROR_THROW::InvalidLambdaArgumentType(start_callable, end_callable,
                         lambda->start_args_token, lambda->end_args_token,
@@ -97,66 +140,124 @@ struct NodeCall : public Node { NO_EXEC
                 }
             }
 
-            call_memory->add_object_in_lambda(lambda->arguments[i]->name, arg_value,
+            call_memory->add_object_in_lambda(lambda->arguments[i]->symbol, arg_value,
                                             lambda->arguments[i]->is_global);
         }
 
-        Value result = NewNull();
-        try {
-            result = ((Node*)(lambda->expr))->eval_from(call_memory);
-        }
-        catch (Error err) {
-            
-            if (err.message_type == 1) {
-                string saved_message = err.message;
-                err.message = "...";
-                throw ERROR_THROW::CallError(start_callable, end_callable, "anonymous-lambda", new Error(err), err.message_type, saved_message);
-            } else if (err.message_type == 2) {
-                string saved_message = err.message;
-                err.message = "...";
-                throw ERROR_THROW::CallError(start_callable, end_callable, "anonymous-lambda", err.message_type, saved_message);
-                
-            }
-            throw ERROR_THROW::CallError(start_callable, end_callable, "anonymous-lambda", new Error(err), err.message_type);
-        }
-
-        
+        return call_memory;
+    }
 
-        // Проверка типа возвращаемого значения (если задан)
+    // Проверка типа возвращаемого значения лямбды (если задан)
+    void check_lambda_return(Lambda* lambda, const Value& result) {
         if (lambda->return_type) {
-            auto expected_type_val = lambda->return_type->eval_from(lambda->memory);
-            Type expected = extract_type_from_value(expected_type_val,
+            Type evaluated;
+            const Type& expected = lambda->return_type_cached ?
+                lambda->cached_return_type :
+                (evaluated = extract_type_from_value(lambda->return_type->eval_from(DeclarationMemory(lambda->memory)),
                                 lambda->start_type_token, lambda->end_type_token,
-                                "return type");
+                                "return type"));
             if (!result.type.is_sub_type(expected)) {
                 throw ERROR_THROW::InvalidLambdaReturnType(start_callable, end_callable,
                     lambda->start_type_token, lambda->end_type_token,
                     expected, result.type);
             }
         }
+    }
 
-        return result;
+    // Узел в хвостовой позиции тела лямбды: спуск через скобки и if-выражения.
+    // nullptr – выбранной ветки нет (результат null).
+    static Node* select_tail(Node* node, Memory* _memory) {
+        while (node) {
+            if (node->NODE_TYPE == NodeTypes::NODE_SCOPES)
+                node = ((NodeScopes*)node)->expression;
+            else if (node->NODE_TYPE == NodeTypes::NODE_IF_EXPRESSION)
+                node = ((NodeIfExpr*)node)->select_branch(_memory);
+            else
+                break;
+        }
+        return node;
     }
 
-    Value call_function(Value &value, Memory* _memory) {
-        
-        auto func = any_cast<Function*>(value.data);
+    Value call_lambda(Value &value, Memory* _memory) {
+        if (NativeStack::exhausted())
+            throw ERROR_THROW::NativeStackExhausted(start_callable, end_callable);
+
+        auto lambda = any_cast<Lambda*>(value.data);
+        auto call_memory = bind_lambda_arguments(value, _memory);
+        ProfileScope profile(ProfileEntryOf(lambda));
+        STAT_INC(lambda_calls);
 
-        // 1. Создаём новую память для этого вызова
-        Memory call_memory;
+        // Тело лямбды – выражение; вызов другой лямбды в хвостовой позиции
+        // выполняется в этом же цикле без роста нативного стека
+        vector<Lambda*> pending_returns;
+        Value result = NewNull();
+        while (true) {
+            try {
+                Node* tail = select_tail((Node*)(lambda->expr), call_memory);
+                if (!tail)
+                    break;
+                if (tail->NODE_TYPE != NodeTypes::NODE_CALL) {
+                    result = tail->eval_from(call_memory);
+                    break;
+                }
+                auto call = (NodeCall*)tail;
+                Value next = call->callable->eval_from(call_memory);
+                if (next.type != STANDART_TYPE::LAMBDA) {
+                    result = call->invoke(next, call_memory);
+                    break;
+                }
+                auto next_memory = call->bind_lambda_arguments(next, call_memory);
+                if (find(pending_returns.begin(), pending_returns.end(), lambda) == pending_returns.end())
+                    pending_returns.push_back(lambda);
+                lambda = any_cast<Lambda*>(next.data);
+                call_memory = next_memory;
+                profile.switch_to(ProfileEntryOf(lambda));
+                STAT_INC(lambda_calls);
+            }
+            catch (Error err) {
+                
+                if (err.message_type == 1) {
+                    string saved_message = err.message;
+                    err.message = "...";
+                    throw ERROR_THROW::CallError(start_callable, end_callable, "anonymous-lambda", new Error(err), err.message_type, saved_message);
+                } else if (err.message_type == 2) {
+                    string saved_message = err.message;
+                    err.message = "...";
+                    throw ERROR_THROW::CallError(start_callable, end_callable, "anonymous-lambda", err.message_type, saved_message);
+                    
+                }
+                throw ERROR_THROW::CallError(start_callable, end_callable, "anonymous-lambda", new Error(err), err.message_type);
+            }
+        }
 
-        // 2. Линкуем в неё глобальные объекты из «статической» памяти функции
-        func->memory->link_objects(&call_memory);
+        // Проверка типов возврата: сначала последняя лямбда, затем те,
+        // что завершились хвостовым вызовом
+        check_lambda_return(lambda, result);
+        for (auto it = pending_returns.rbegin(); it != pending_returns.rend(); ++it) {
+            if (*it != lambda)
+                check_lambda_return(*it, result);
+        }
 
-        // 3. Добавляем саму функцию в call_memory (для рекурсивных вызовов)
-        call_memory.add_object(func->name, value, value.type,
+        return result;
+    }
+
+    // Связывание аргументов вызова функции в call_memory.
+    // Аргументы и параметры по умолчанию вычисляются в arg_memory;
+    // первые evaluated->size() аргументов уже вычислены (JitInvoke).
+    void bind_function_arguments(Value &value, Function* func, Memory* call_memory, Memory* arg_memory,
+                                 vector<Value>* evaluated = nullptr) {
+        // Линкуем в неё глобальные объекты из «статической» памяти функции
+        DeclarationMemory(func->memory)->link_objects(call_memory);
+
+        // Добавляем саму функцию в call_memory (для рекурсивных вызовов)
+        call_memory->add_object(func->name, value, value.type,
                             true, true, true, true, false);
 
         
 
         size_t arg_idx = 0;
 
-        // 4. Обрабатываем параметры, как и раньше, но кладём всё в call_memory
+        // Обрабатываем параметры, кладём всё в call_memory
         for (size_t param_idx = 0; param_idx < func->arguments.size(); ++param_idx) {
             Arg* param = func->arguments[param_idx];
 
@@ -164,45 +265,51 @@ struct NodeCall : public Node { NO_EXEC
                 // --- Обычный параметр ---
                 Value arg_value = NewNull();
                 if (arg_idx < args.size()) {
-                    arg_value = args[arg_idx]->eval_from(_memory);
+                    if (evaluated && arg_idx < evaluated->size())
+                        arg_value = std::move((*evaluated)[arg_idx]);
+                    else
+                        arg_value = args[arg_idx]->eval_from(arg_memory);
                     ++arg_idx;
                 } else if (param->default_parameter) {
-                    arg_value = param->default_parameter->eval_from(_memory);
+                    arg_value = param->default_parameter->eval_from(arg_memory);
                 } else {
                     throw ERROR_THROW::FuncArgumentMissing(start_callable, end_callable,
                         func->start_args_token, func->end_args_token,
                         param->name, param_idx);
                 }
 
-                Type expected;
+                Type evaluated;
+                const Type* expected = &evaluated;
                 if (param->type_expr) {
-                    auto expected_type_val = param->type_expr->eval_from(func->memory);
-                    expected = extract_type_from_value(expected_type_val,
+                    if (func->argument_type_cached[param_idx])
+                        expected = &func->argument_types[param_idx];
+                    else
+                        evaluated = extract_type_from_value(param->type_expr->eval_from(DeclarationMemory(func->memory)),
                                         func->start_args_token, func->end_args_token,
                                         "parameter '" + param->name + "'");
-                    if (!arg_value.type.is_sub_type(expected)) {
+                    if (!arg_value.type.is_sub_type(*expected)) {
                         throw ERROR_THROW::InvalidFuncArgumentType(start_callable, end_callable,
                             func->start_args_token, func->end_args_token,
-                            expected, arg_value.type, param->name, func->name);
+                            *expected, arg_value.type, param->name, func->name);
                     }
                 }
 
                 // Проверка на перекрытие глобала (теперь внутри call_memory)
-                if (call_memory.check_literal(param->name)) {
-                    MemoryObject* existing = call_memory.get_variable(param->name);
+                if (call_memory->check_literal(param->symbol)) {
+                    MemoryObject* existing = call_memory->get_variable(param->symbol);
                     if (existing->modifiers.is_global)
                         throw ERROR_THROW::FuncArgumentShadowsGlobal(start_callable, end_callable,
                             func->name, param->name);
                 }
 
-                call_memory.add_object_in_func(param->name, arg_value, expected,
+                call_memory->add_object_in_func(param->symbol, arg_value, *expected,
                     param->is_const, param->is_static,
                     param->is_final, param->is_global);
             } else {
                 // --- Variadic параметр (логика та же, адресация call_memory) ---
                 int64_t variadic_size = 0;
                 if (param->variadic_size) {
-                    Value size_val = param->variadic_size->eval_from(&call_memory);
+                    Value size_val = param->variadic_size->eval_from(call_memory);
                     if (size_val.type != STANDART_TYPE::INT) 
                         throw ERROR_THROW::InvalidFuncVariadicSizeExpression(start_callable, end_callable, size_val.type);
                     
@@ -225,12 +332,14 @@ struct NodeCall : public Node { NO_EXEC
                 bool has_explicit_type = (param->type_expr != nullptr);
 
                 if (has_explicit_type) {
-                    auto expected_type_val = param->type_expr->eval_from(func->memory);
-                    element_type = any_cast<Type>(expected_type_val.data);
+                    if (func->argument_type_cached[param_idx])
+                        element_type = func->argument_types[param_idx];
+                    else
+                        element_type = any_cast<Type>(param->type_expr->eval_from(DeclarationMemory(func->memory)).data);
                 }
 
                 for (int64_t i = 0; i < variadic_size; ++i) {
-                    Value elem = args[arg_idx + i]->eval_from(_memory);
+                    Value elem = args[arg_idx + i]->eval_from(arg_memory);
                     if (has_explicit_type && !elem.type.is_sub_type(element_type)) {
                         throw ERROR_THROW::InvalidFuncVariadicArgType(start_callable, end_callable,
                             element_type.pool, elem.type.pool, param->name);
@@ -250,15 +359,15 @@ struct NodeCall : public Node { NO_EXEC
                 Array arr(array_type, std::move(elements));
                 Value array_value(array_type, std::move(arr));
 
-                if (call_memory.check_literal(param->name)) {
-                    MemoryObject* existing = call_memory.get_variable(param->name);
+                if (call_memory->check_literal(param->symbol)) {
+                    MemoryObject* existing = call_memory->get_variable(param->symbol);
                     if (existing->modifiers.is_global) 
                         throw ERROR_THROW::FuncArgumentShadowsGlobal(start_callable, end_callable,
                             func->name, param->name);
                     
                 }
 
-                call_memory.add_object_in_func(param->name, array_value, array_value.type,
+                call_memory->add_object_in_func(param->symbol, array_value, array_value.type,
                     param->is_const, param->is_static,
                     param->is_final, param->is_global);
             }
@@ -269,40 +378,156 @@ struct NodeCall : public Node { NO_EXEC
                 func->start_args_token, func->end_args_token, func->name,
                 func->arguments.size(), args.size());
         }
+    }
 
-        // 5. Выполняем тело функции в её собственной call_memory
-        try {
-            
-            ((Node*)(func->body))->exec_from(&call_memory);
-            return NewNull();
+    // Проверка типа возвращаемого значения функции (если задан)
+    void check_function_return(Function* func, const Value& result) {
+        if (func->return_type) {
+            Type evaluated;
+            const Type& expected = func->return_type_cached ?
+                func->cached_return_type :
+                (evaluated = extract_type_from_value(func->return_type->eval_from(DeclarationMemory(func->memory)),
+                                func->start_return_type_token, func->end_return_type_token,
+                                "return type"));
+            if (!result.type.is_sub_type(expected)) {
+                throw ERROR_THROW::InvalidFuncReturnType(start_callable, end_callable,
+                    func->start_return_type_token, func->end_return_type_token,
+                    expected, result.type);
+            }
         }
-        catch (Error err) {
-            if (err.message_type == 1) {
-                string saved_message = err.message;
-                err.message = "...";
-                throw ERROR_THROW::CallError(start_callable, end_callable, func->name, new Error(err), err.message_type, saved_message);
-            } else if (err.message_type == 2) {
-                string saved_message = err.message;
-                err.message = "...";
-                throw ERROR_THROW::CallError(start_callable, end_callable, func->name, new Error(err), err.message_type, saved_message);
+    }
+
+    // Вызов функции-генератора: тело с уже связанными аргументами
+    // выполняется по запросам значений (см. twist-generators.cpp)
+    Value start_generator(Function* func, std::unique_ptr<Memory> call_memory) {
+        std::shared_ptr<Memory> memory(std::move(call_memory));
+        Token start = start_callable, end = end_callable;
+        return NewGenerator(std::make_shared<GeneratorState>(func, [func, memory, start, end]() {
+            try {
+                try {
+                    ((Node*)(func->body))->exec_from(memory.get());
+                }
+                catch (TailCall& tail) {
+                    tail.call->eval_from(tail.memory);
+                }
+            }
+            catch (Return) {}
+            catch (Error err) {
+                if (err.message_type == 1) {
+                    string saved_message = err.message;
+                    err.message = "...";
+                    throw ERROR_THROW::CallError(start, end, func->name, new Error(err), err.message_type, saved_message);
+                } else if (err.message_type == 2) {
+                    string saved_message = err.message;
+                    err.message = "...";
+                    throw ERROR_THROW::CallError(start, end, func->name, err.message_type, saved_message);
+                }
+                throw ERROR_THROW::CallError(start, end, func->name, new Error(err), err.message_type);
             }
-            throw ERROR_THROW::CallError(start_callable, end_callable, func->name, new Error(err), err.message_type);
+        }));
+    }
+
+    Value call_function(Value &value, Memory* _memory) {
+        
+        auto func = any_cast<Function*>(value.data);
+
+        // Горячая функция с машинным кодом (twist-jit.cpp)
+        vector<Value> evaluated;
+        Value jit_result = NewNull();
+        if (JitInvoke(func, args, _memory, evaluated, jit_result))
+            return jit_result;
+
+        // Память вызова; при хвостовом вызове заменяется памятью следующей функции
+        auto call_memory = std::make_unique<Memory>();
+        bind_function_arguments(value, func, call_memory.get(), _memory, &evaluated);
+        if (func->generator)
+            return start_generator(func, std::move(call_memory));
+        ProfileScope profile(ProfileEntryOf(func));
+        STAT_INC(function_calls);
+
+        // memo-функция: результат берётся из кэша по значениям параметров
+        MemoCache* memo = func->memo;
+        string memo_key;
+        if (memo) {
+            for (auto param : func->arguments) {
+                if (!MemoCache::AppendKey(call_memory->get_variable(param->symbol)->value, memo_key)) {
+                    memo = nullptr;
+                    break;
+                }
+            }
+            Value cached = NewNull();
+            if (memo && memo->lookup(memo_key, cached))
+                return cached;
         }
-        catch (Return _value) {
-            // Проверка возвращаемого типа (по‑прежнему используется func->memory для вычисления типа)
-            if (func->return_type) {
-                auto expected_ret = func->return_type->eval_from(func->memory);
-                Type expected = extract_type_from_value(expected_ret,
-                                    func->start_return_type_token, func->end_return_type_token,
-                                    "return type");
-                if (!_value.value.type.is_sub_type(expected)) {
-                    throw ERROR_THROW::InvalidFuncReturnType(start_callable, end_callable,
-                        func->start_return_type_token, func->end_return_type_token,
-                        expected, _value.value.type);
+
+        FunctionFrameGuard frame;
+        vector<Function*> pending_returns;   // функции, завершившиеся `ret f(...)`
+        Value result = NewNull();
+
+        // Выполняем тело функции в её собственной call_memory.
+        // `ret f(...)` приходит сюда как TailCall: стек тела уже раскручен,
+        // а память, в которой нужно вычислить аргументы, ещё жива – поэтому
+        // следующая функция выполняется в этом же цикле без роста стека.
+        TailCall tail{nullptr, nullptr};
+        while (true) {
+            try {
+                if (tail.call) {
+                    auto call = (NodeCall*)tail.call;
+                    Memory* arg_memory = tail.memory;
+                    tail.call = nullptr;
+
+                    Value next = call->callable->eval_from(arg_memory);
+                    if (!next.type.is_func())
+                        throw Return(call->invoke(next, arg_memory));
+
+                    auto next_func = any_cast<Function*>(next.data);
+                    auto next_memory = std::make_unique<Memory>();
+                    call->bind_function_arguments(next, next_func, next_memory.get(), arg_memory);
+                    if (find(pending_returns.begin(), pending_returns.end(), func) == pending_returns.end())
+                        pending_returns.push_back(func);
+                    func = next_func;
+                    if (func->generator) {
+                        result = start_generator(func, std::move(next_memory));
+                        break;
+                    }
+                    call_memory = std::move(next_memory);
+                    profile.switch_to(ProfileEntryOf(func));
+                    STAT_INC(function_calls);
                 }
+                ((Node*)(func->body))->exec_from(call_memory.get());
+                break;
             }
-            return _value.value;
+            catch (TailCall& next_call) {
+                tail = next_call;
+            }
+            catch (Error err) {
+                if (err.message_type == 1) {
+                    string saved_message = err.message;
+                    err.message = "...";
+                    throw ERROR_THROW::CallError(start_callable, end_callable, func->name, new Error(err), err.message_type, saved_message);
+                } else if (err.message_type == 2) {
+                    string saved_message = err.message;
+                    err.message = "...";
+                    throw ERROR_THROW::CallError(start_callable, end_callable, func->name, new Error(err), err.message_type, saved_message);
+                }
+                throw ERROR_THROW::CallError(start_callable, end_callable, func->name, new Error(err), err.message_type);
+            }
+            catch (Return _value) {
+                // Проверка возвращаемого типа (по‑прежнему используется func->memory для вычисления типа)
+                check_function_return(func, _value.value);
+                result = _value.value;
+                break;
+            }
+        }
+
+        // Функции, передавшие управление хвостовым вызовом, возвращают тот же результат
+        for (auto it = pending_returns.rbegin(); it != pending_returns.rend(); ++it) {
+            if (*it != func)
+                check_function_return(*it, result);
         }
+        if (memo)
+            memo->store(memo_key, result);
+        return result;
     }
 
     Value call_struct(Value &value, Memory* _memory) {
@@ -336,97 +561,40 @@ struct NodeCall : public Node { NO_EXEC
         return new_struct;
     }
 
-    Value call_string(Value &value_, Memory* _memory) {
-        if (args.size() != 1)
-            throw ERROR_THROW::InvalidStringArgumentCount(start_callable, end_callable, args.size());
-
-        string new_string;
-        auto value = args[0]->eval_from(_memory);
-        if (value.type == STANDART_TYPE::TYPE)
-            new_string = any_cast<Type&>(value.data).pool;
-        else if (value.type == STANDART_TYPE::STRING)
-            new_string = any_cast<string&>(value.data);
-        else if (value.type == STANDART_TYPE::CHAR)
-            new_string = any_cast<char>(value.data);
-        else if (value.type == STANDART_TYPE::BOOL) {
-            if (any_cast<bool>(value.data)) {
-                new_string = "true";
-            } else {
-                new_string = "false";
-            }
-        }
-        else if (value.type == STANDART_TYPE::INT) {
-            new_string = to_string(any_cast<int64_t>(value.data));
-        } 
-        else if (value.type == STANDART_TYPE::DOUBLE) {
-            new_string = to_string(any_cast<NUMBER_ACCURACY>(value.data));
-        }
-        else if (value.type == STANDART_TYPE::NULL_T) {
-            new_string = "null";
-        }
-        else if (value.type == STANDART_TYPE::NAMESPACE) {
-            new_string = "namespace " + any_cast<Namespace>(value.data).name;
+    // Нативная функция: аргументы вычисляются, проверяются по сигнатуре и
+    // передаются в body прямым вызовом
+    Value call_native(NativeFunction* native, const Value& callee, Memory* _memory) {
+        if (native->arity >= 0 && args.size() != (size_t)native->arity)
+            throw ERROR_THROW::InvalidNativeArgumentCount(start_callable, end_callable, native->name, native->arity, args.size());
+
+        vector<Value> values;
+        values.reserve(args.size());
+        for (auto arg : args)
+            values.push_back(arg->eval_from(_memory));
+
+        for (size_t i = 0; i < native->parameters.size(); i++) {
+            auto& expected = native->parameters[i];
+            if (expected != STANDART_TYPE::AUTO && !IsTypeCompatible(expected, values[i].type))
+                throw ERROR_THROW::InvalidNativeArgumentType(start_callable, end_callable, native->name, i, expected, values[i].type);
         }
-        else if (value.type == STANDART_TYPE::LAMBDA) {
-            new_string = "Lambda(";
-            auto lambda = any_cast<Lambda*>(value.data);
-            for (int i = 0; i < lambda->arguments.size(); i++) {
-                new_string = new_string + any_cast<Type>(lambda->arguments[i]->type_expr->eval_from(_memory).data).pool;
-                if (i != lambda->arguments.size() - 1) new_string = new_string + ", ";
-            }
-            new_string = new_string + ") -> ";
-            new_string = new_string + any_cast<Type>(lambda->return_type->eval_from(_memory).data).pool;
-        } else if (value.type.is_pointer()) {
-            new_string = value.type.pool + "[0x" + to_string(any_cast<int>(value.data)) + "]";
-        }
-
-        return NewString(new_string);
-    }
 
-    Value call_int(Value &value_, Memory* _memory) {
-        if (args.size() != 1)
-            throw ERROR_THROW::InvalidIntArgumentCount(start_callable, end_callable, args.size());
-
-
-        auto value = args[0]->eval_from(_memory);
-        if (value.type == STANDART_TYPE::INT) 
-            return value;
-        else if (value.type == STANDART_TYPE::DOUBLE) 
-            return NewInt(any_cast<NUMBER_ACCURACY>(value.data));
-        else if (value.type == STANDART_TYPE::STRING) 
-            return NewInt(stoll(any_cast<string&>(value.data)));
-        else if (value.type == STANDART_TYPE::CHAR) 
-            return NewInt(stoll(to_string(any_cast<char>(value.data))));
-        
-        throw ERROR_THROW::InvalidIntArgumentType(start_callable, end_callable, value.type);
-    }
-
-    Value call_ptr(Value &value_, Memory* _memory) {
-        
-       
-        auto value = args[0]->eval_from(_memory);
-
-        if (value.type != STANDART_TYPE::INT) 
-            throw ERROR_THROW::InvalidPtrFirstArgumentType(start_callable, end_callable, value.type);
-        
-        if (args.size() == 1)
-            return NewPointerValue(any_cast<int64_t>(value.data), STANDART_TYPE::NULL_T);
-        else if (args.size() == 2) {
-            auto t = args[1]->eval_from(_memory);
-            if (t.type == STANDART_TYPE::TYPE)    
-                return NewPointerValue(any_cast<int64_t>(value.data), any_cast<Type&>(t.data));
-            if (!t.type.is_sub_type(STANDART_TYPE::TYPES)) {
-                return NewPointerValue(any_cast<int64_t>(value.data), any_cast<Struct*>(t.data)->type);
-            }
-            throw ERROR_THROW::InvalidPtrSecondArgumentType(start_callable, end_callable, value.type);
+        NativeCall call{callee, values, _memory, start_callable, end_callable};
+        try {
+            return native->body(call, native->data);
+        } catch (const Error&) {
+            throw;
+        } catch (const std::exception& e) {
+            throw ERROR_THROW::NativeFunctionFailed(start_callable, end_callable, native->name, e.what());
         }
-        
-        throw ERROR_THROW::InvalidPtrArgumentCount(start_callable, end_callable, args.size());
     }
 
     Value eval_from(Memory* _memory) override {
-
         auto value = callable->eval_from(_memory);
+        return invoke(value, _memory);
+    }
+
+    // Вызов уже вычисленного вызываемого значения
+    Value invoke(Value &value, Memory* _memory) {
 
         // if (value.type == STANDART_TYPE::METHOD) {
         //     auto method = any_cast<Method>(value.data);
@@ -439,21 +607,21 @@ struct NodeCall : public Node { NO_EXEC
         // }
 
         
+        // Функции – самый частый случай, проверяются первыми
+        if (value.type.is_func()) {
+            RecursionGuard guard(start_callable, end_callable);  // <<< контроль глубины
+            return call_function(value, _memory);
+        }
         if (value.type == STANDART_TYPE::LAMBDA) {
             return call_lambda(value, _memory);
         }
-        if (value.type == STANDART_TYPE::TYPE && any_cast<Type>(value.data).pool == "String") {
-            return call_string(value, _memory);
-        }
-        if (value.type == STANDART_TYPE::TYPE && any_cast<Type>(value.data).pool == "Int") {
-            return call_int(value, _memory);
+        if (value.type == STANDART_TYPE::NATIVE) {
+            return call_native(any_cast<NativeFunction*>(value.data), value, _memory);
         }
-        if (value.type == STANDART_TYPE::TYPE && any_cast<Type>(value.data).pool == "ptr") {
-            return call_ptr(value, _memory);
-        }
-        else if (value.type.is_func()) {
-            RecursionGuard guard(start_callable, end_callable);  // <<< контроль глубины
-            return call_function(value, _memory);
+        // Тип как функция: String(x), Int(x), ptr(...), Map(), [T](m) – см. NativeRegistry
+        if (value.type == STANDART_TYPE::TYPE) {
+            if (auto constructor = NativeRegistry::constructor(any_cast<const Type&>(value.data)))
+                return call_native(constructor, value, _memory);
         }
         else if (!value.type.is_sub_type(STANDART_TYPE::TYPES)) {
             return call_struct(value, _memory);
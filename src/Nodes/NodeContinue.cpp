@@ -8,7 +8,9 @@
  * узлами циклов для немедленного перехода к проверке условия или обновлению.
  */
 
-struct Continue {};
+struct Continue {
+    Continue() { STAT_INC(throws_continue); }
+};
 
 struct NodeContinue : public Node { NO_EVAL
     NodeContinue() {
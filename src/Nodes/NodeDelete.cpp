@@ -1,7 +1,10 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-errors.cpp"
+#include "../twist-err.cpp"
 #include "NodeDereference.cpp"
 #include "TargetResolver.cpp"
+#include "NodeGetIndex.cpp"
+#include "../twist-map.cpp"
 
 struct NodeDelete : public Node { NO_EVAL
     Node* target;
@@ -13,7 +16,35 @@ struct NodeDelete : public Node { NO_EVAL
         this->NODE_TYPE = NodeTypes::NODE_DELETE;
     }
 
+    // del m[k] / del s[x] – удаление ключа из переменной Map или Set
+    void delete_key(NodeGetIndex* index, Memory* _memory) {
+        auto key_value = index->index_expr->eval_from(_memory);
+        pair<Memory*, Symbol> target_info = resolveTargetMemory(index->expr, _memory);
+        if (!target_info.first)
+            ERROR::InvalidDeleteInstruction(start_token, end_token);
+        if (target_info.first->is_private(target_info.second))
+            ERROR::PrivateVariableAccess(start_token, end_token, target_info.second.name());
+        if (target_info.first->is_const(target_info.second))
+            throw ERROR_THROW::VariableConstRedefinition(start_token, end_token, target_info.second.name());
+
+        auto object = target_info.first->get_variable(target_info.second);
+        if (IsSharedObject(object))
+            throw ERROR_THROW::ParallelSharedWrite(start_token, end_token, target_info.second.name());
+        auto& value = object->value;
+        if (value.type != STANDART_TYPE::MAP && value.type != STANDART_TYPE::SET)
+            ERROR::InvalidDeleteInstruction(start_token, end_token);
+        TableKey key(key_value);
+        if (!key.valid())
+            throw ERROR_THROW::MapInvalidKeyType(start_token, end_token, key_value.type);
+        any_cast<ValueTable&>(value.data).erase(key);
+    }
+
     void exec_from(Memory* _memory) override {
+        if (target->NODE_TYPE == NodeTypes::NODE_GET_BY_INDEX) {
+            delete_key((NodeGetIndex*)target, _memory);
+            return;
+        }
+
         if (target->NODE_TYPE != NodeTypes::NODE_LITERAL && 
             target->NODE_TYPE != NodeTypes::NODE_NAME_RESOLUTION && 
             target->NODE_TYPE != NodeTypes::NODE_DEREFERENCE) {
@@ -33,6 +64,8 @@ struct NodeDelete : public Node { NO_EVAL
             if (!obj) {
                 ERROR::CanNotDeleteUndereferencedValue(start_token, end_token);
             }
+            if (IsSharedObject(obj))
+                throw ERROR_THROW::ParallelSharedWrite(start_token, end_token, obj->var_name);
 
             // Если объект принадлежит какой-то памяти и имеет имя, удаляем через владельца
             if (obj->owner && !obj->var_name.empty()) {
@@ -45,17 +78,19 @@ struct NodeDelete : public Node { NO_EVAL
             return;
         } else {
             // Удаление по имени (переменная или пространство имён) – остаётся без изменений
-            pair<Memory*, string> target_info = resolveTargetMemory(target, _memory);
+            pair<Memory*, Symbol> target_info = resolveTargetMemory(target, _memory);
             Memory* target_memory = target_info.first;
-            string target_name = target_info.second;
+            Symbol target_name = target_info.second;
 
             if (!target_memory->check_literal(target_name)) {
                 ERROR::UndefinedVariable(start_token);
             }
 
             if (target_memory->is_private(target_name)) {
-                ERROR::PrivateVariableAccess(start_token, end_token, target_name);
+                ERROR::PrivateVariableAccess(start_token, end_token, target_name.name());
             }
+            if (IsSharedObject(target_memory->get_variable(target_name)))
+                throw ERROR_THROW::ParallelSharedWrite(start_token, end_token, target_name.name());
 
             target_memory->delete_variable(target_name);
         }
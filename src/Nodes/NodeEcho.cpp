@@ -27,7 +27,7 @@ struct NodeEcho : public Node { NO_EVAL
             if (value.type == STANDART_TYPE::TYPE)
                 echo_message = echo_message + any_cast<Type&>(value.data).pool;
             else if (value.type == STANDART_TYPE::STRING)
-                echo_message = echo_message + any_cast<string&>(value.data);
+                echo_message = echo_message + any_cast<RuntimeString&>(value.data).str();
             else if (value.type == STANDART_TYPE::CHAR)
                 echo_message = echo_message + any_cast<char>(value.data);
             else if (value.type == STANDART_TYPE::BOOL) {
@@ -1,5 +1,6 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-err.cpp"
+#include "../twist-output.cpp"
 
 struct NodeExit : public Node { NO_EVAL
     Node* expr;
@@ -17,13 +18,15 @@ struct NodeExit : public Node { NO_EVAL
             if (value.type != STANDART_TYPE::INT) 
                 throw ERROR_THROW::ExitInvalidCode(start_token, end_token, value.type);
             #ifndef SERVER
-            exit(any_cast<int64_t>(value.data));
+            OutputBuffer::flush();
+            ExitProgram((int)any_cast<int64_t>(value.data));
             #else
             ERROR_THROW::ExitWarning(start_token, end_token, any_cast<int64_t>(value.data)).Write();
             #endif
         } else {
             #ifndef SERVER
-            exit(0);
+            OutputBuffer::flush();
+            ExitProgram(0);
             #else
             ERROR_THROW::ExitWarning(start_token, end_token, 0).Write();
             #endif
@@ -4,6 +4,7 @@
 #include "NodeContinue.cpp"
 
 #include "../twist-err.cpp"
+#include "../twist-quicken.cpp"
 
 /*
  * NodeFor – цикл со счётчиком (for).
@@ -24,7 +25,8 @@
  *         - Break – выход из цикла.
  *         - Continue – выполнение update_state и переход к следующей итерации.
  *      b. Если не было continue, выполняется update_state.
- *   3. Условие вычисляется по тем же правилам, что и в NodeWhile.
+ *   3. Условие вычисляется по тем же правилам, что и в NodeWhile
+ *      (в том числе через QuickCondition).
  */
 
 struct NodeFor : public Node { NO_EVAL
@@ -32,6 +34,7 @@ struct NodeFor : public Node { NO_EVAL
     Node* condition;
     Node* update_state;
     Node* body;
+    QuickeningState quickening;
 
     Token body_token;
 
@@ -49,7 +52,11 @@ struct NodeFor : public Node { NO_EVAL
 
         while (true) {
             auto value = condition->eval_from(_memory);
-            if (value.type == STANDART_TYPE::BOOL) {
+            bool truth;
+            if (QuickCondition(quickening, value, truth)) {
+                if (!truth)
+                    break;
+            } else if (value.type == STANDART_TYPE::BOOL) {
                 if (any_cast<bool>(value.data) == false)
                     break;
             } else if (value.type == STANDART_TYPE::INT) {
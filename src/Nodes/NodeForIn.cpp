@@ -0,0 +1,170 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-generators.cpp"
+#include "../twist-array.cpp"
+#include "../twist-map.cpp"
+
+#include "NodeBreak.cpp"
+#include "NodeContinue.cpp"
+#include "NodeLiteral.cpp"
+
+#include "../twist-err.cpp"
+
+#include <memory>
+
+#pragma once
+
+/*
+ * NodeForIn – цикл по элементам.
+ *
+ *     for (x in arr) body          // элементы массива
+ *     for (c in str) body          // символы строки (Char)
+ *     for (i in a..b) body         // Int от a до b, b не входит
+ *     for (k in m) body            // ключи Map, элементы Set
+ *     for (x in numbers(10)) body  // значения генератора
+ *
+ * Перебор идёт счётчиком C++: условие и шаг не вычисляются как выражения
+ * Lumen, элемент не копирует массив. Массив из переменной читается на
+ * месте и перечитывается на каждой итерации, поэтому тело может менять его
+ * (элементы, добавленные в конец, тоже будут перебраны); массив из другого
+ * выражения, строка, Map и Set вычисляются один раз (Map и Set – значения:
+ * изменения в теле цикла на перебор не влияют; ключи идут в порядке
+ * вставки). Границы диапазона вычисляются один раз. Значения генератора
+ * запрашиваются по одному (см. twist-generators.cpp), поэтому
+ * последовательность не хранится целиком.
+ *
+ * Переменная цикла объявляется в текущей памяти, как `let`, один раз и
+ * получает значения напрямую; присваивание ей в теле не меняет следующих
+ * значений, после цикла она сохраняет последнее. Поддерживает break и
+ * continue; после break генератор можно продолжить в следующем цикле, если
+ * значение генератора сохранено в переменной.
+ *
+ * Поля:
+ *   var_name, var_symbol – имя переменной цикла.
+ *   iterable – перебираемое выражение (начало диапазона).
+ *   range_end – конец диапазона a..b, nullptr – не диапазон.
+ *   body – тело цикла.
+ */
+
+struct NodeForIn : public Node { NO_EVAL
+    string var_name;
+    Symbol var_symbol;
+    Node* iterable;
+    Node* range_end;
+    Node* body;
+
+    Token start_token;
+    Token end_token;
+
+    NodeForIn(const string& var_name, Node* iterable, Node* range_end, Node* body, Token start_token, Token end_token)
+        : var_name(var_name), var_symbol(Symbol(var_name)), iterable(iterable), range_end(range_end), body(body),
+          start_token(start_token), end_token(end_token) {
+        this->NODE_TYPE = NodeTypes::NODE_FOR_IN;
+    }
+
+    // Объявление переменной цикла по правилам let
+    MemoryObject* declare(Memory* _memory) {
+        if (auto existing = _memory->get_variable(var_symbol)) {
+            if (existing->modifiers.is_final)
+                throw ERROR_THROW::VariableAlreadyDefined(start_token);
+            if (existing->modifiers.is_global && !existing->modifiers.is_shadow)
+                throw ERROR_THROW::VariableShadowsGlobal(start_token, var_name);
+            if (IsSharedObject(existing))
+                _memory->string_pool.erase(var_symbol);
+            else
+                _memory->delete_variable(var_symbol);
+        }
+        auto object = CreateMemoryObject(NewNull(), STANDART_TYPE::AUTO, _memory,
+            false, false, false, false, false, false, var_name, _memory);
+        STATIC_MEMORY.register_object(object);
+        _memory->add_object(var_symbol, object);
+        return object;
+    }
+
+    // Тело могло переобъявить или удалить переменную цикла
+    MemoryObject* variable_in(Memory* _memory, MemoryObject* variable) {
+        auto it = _memory->string_pool.find(var_symbol);
+        if (it != _memory->string_pool.end() && it->second == variable)
+            return variable;
+        return declare(_memory);
+    }
+
+    // Итерация со значением value; false – break
+    bool step(Memory* _memory, MemoryObject*& variable, Value value) {
+        variable = variable_in(_memory, variable);
+        variable->value = std::move(value);
+        try {
+            body->exec_from(_memory);
+        }
+        catch (Break) { return false; }
+        catch (Continue) {}
+        return true;
+    }
+
+    int64_t bound(Node* node, Memory* _memory) {
+        auto value = node->eval_from(_memory);
+        if (value.type != STANDART_TYPE::INT)
+            throw ERROR_THROW::ForInInvalidRangeBound(start_token, end_token, value.type);
+        return any_cast<int64_t>(value.data);
+    }
+
+    void exec_from(Memory* _memory) override {
+        if (range_end) {
+            int64_t first = bound(iterable, _memory);
+            int64_t last = bound(range_end, _memory);
+            auto variable = declare(_memory);
+            for (int64_t i = first; i < last; i++)
+                if (!step(_memory, variable, NewInt(i))) break;
+            return;
+        }
+
+        // Массив из переменной – на месте, без копии
+        // (for (a in a) переобъявляет a, такой массив копируется)
+        if (iterable->NODE_TYPE == NodeTypes::NODE_LITERAL && ((NodeLiteral*)iterable)->symbol != var_symbol) {
+            auto literal = (NodeLiteral*)iterable;
+            if (literal->lookup(_memory).type.is_array_type()) {
+                auto variable = declare(_memory);
+                for (size_t i = 0; ; i++) {
+                    auto& source = literal->lookup(_memory);
+                    if (!source.type.is_array_type())
+                        break;
+                    auto& values = any_cast<const Array&>(source.data).values;
+                    if (i >= values.size() || !step(_memory, variable, values[i]))
+                        break;
+                }
+                return;
+            }
+        }
+
+        auto source = iterable->eval_from(_memory);
+        if (source.type.is_array_type()) {
+            auto& values = any_cast<const Array&>(source.data).values;
+            auto variable = declare(_memory);
+            for (size_t i = 0; i < values.size(); i++)
+                if (!step(_memory, variable, values[i])) break;
+            return;
+        }
+        if (source.type == STANDART_TYPE::STRING) {
+            auto& str = any_cast<const RuntimeString&>(source.data);
+            auto variable = declare(_memory);
+            for (size_t i = 0; i < str.size(); i++)
+                if (!step(_memory, variable, NewChar(str[i]))) break;
+            return;
+        }
+        if (source.type == STANDART_TYPE::MAP || source.type == STANDART_TYPE::SET) {
+            auto& entries = any_cast<const ValueTable&>(source.data).entries;
+            auto variable = declare(_memory);
+            for (size_t i = 0; i < entries.size(); i++)
+                if (entries[i].alive && !step(_memory, variable, entries[i].key)) break;
+            return;
+        }
+        if (source.type != STANDART_TYPE::GENERATOR)
+            throw ERROR_THROW::ForInNotIterable(start_token, end_token, source.type);
+
+        // Копия держит генератор, даже если тело перезапишет переменную с ним
+        auto generator = any_cast<std::shared_ptr<GeneratorState>>(source.data);
+        auto variable = declare(_memory);
+        Value value = NewNull();
+        while (generator->next(value, start_token, end_token))
+            if (!step(_memory, variable, std::move(value))) break;
+    }
+};
@@ -3,8 +3,70 @@
 #include "../twist-functions.cpp"
 #include "../twist-err.cpp"
 
+#include "NodeLiteral.cpp"
+#include "NodeScopes.cpp"
+#include "NodeBinary.cpp"
+
 #pragma once
 
+// Выражение типа константно, если состоит только из имён константных
+// объектов памяти (Int, String, ...), объединений через | и скобок.
+// Такое выражение при каждом вычислении даёт один и тот же тип.
+bool IsConstantTypeExpression(Node* expr, Memory* _memory) {
+    if (!expr) return false;
+    switch (expr->NODE_TYPE) {
+        case NodeTypes::NODE_LITERAL: {
+            auto object = _memory->get_variable(((NodeLiteral*)expr)->name);
+            return object && object->modifiers.is_const;
+        }
+        case NodeTypes::NODE_SCOPES:
+            return IsConstantTypeExpression(((NodeScopes*)expr)->expression, _memory);
+        case NodeTypes::NODE_BINARY: {
+            auto binary = (NodeBinary*)expr;
+            return binary->op == "|" &&
+                   IsConstantTypeExpression(binary->left, _memory) &&
+                   IsConstantTypeExpression(binary->right, _memory);
+        }
+        default:
+            return false;
+    }
+}
+
+// Вычисление константного выражения типа один раз. Возвращает false,
+// если выражение не константно или его значение не является Type.
+bool ResolveConstantType(Node* expr, Memory* _memory, Type& result) {
+    if (!IsConstantTypeExpression(expr, _memory))
+        return false;
+    try {
+        auto value = expr->eval_from(_memory);
+        if (value.type != STANDART_TYPE::TYPE)
+            return false;
+        result = any_cast<Type&>(value.data);
+        return true;
+    } catch (...) {
+        // Ошибка будет выброшена при вызове с исходными позициями
+        return false;
+    }
+}
+
+// Кэширование типов сигнатуры Function / Lambda при объявлении.
+// _memory – память, в которой выражения типов вычисляются при вызове.
+template <typename Callable>
+void CacheSignatureTypes(Callable* callable, Memory* _memory) {
+    size_t count = callable->arguments.size();
+    callable->argument_types.assign(count, Type());
+    callable->argument_type_cached.assign(count, false);
+    for (size_t i = 0; i < count; ++i) {
+        callable->argument_type_cached[i] = ResolveConstantType(
+            callable->arguments[i]->type_expr, _memory, callable->argument_types[i]);
+    }
+    callable->return_type_cached = ResolveConstantType(
+        callable->return_type, _memory, callable->cached_return_type);
+}
+
+// Определена в twist-purity.cpp (анализу нужны все типы узлов)
+bool EnableFunctionMemo(Function* func, string& reason);
+
 struct NodeFunctionDeclaration : public Node { NO_EVAL
     string name;
     vector<Arg*> args;
@@ -17,6 +79,8 @@ struct NodeFunctionDeclaration : public Node { NO_EVAL
     bool is_global = false;
     bool is_private = false;
     bool is_shadow = false;
+    bool is_memo = false;
+    bool is_generator = false;      // в теле есть yield
 
     Token start_args_token;
     Token end_args_token;
@@ -85,6 +149,14 @@ struct NodeFunctionDeclaration : public Node { NO_EVAL
         _memory->link_objects(new_function_memory);
         
         auto func = NewFunction(name, new_function_memory, body, args, return_type, function_type, start_args_token, end_args_token, start_return_token, end_return_token);
+        CacheSignatureTypes(any_cast<Function*>(func.data), new_function_memory);
+        any_cast<Function*>(func.data)->generator = is_generator;
+
+        if (is_memo || memoize_pure_functions) {
+            string reason;
+            if (!EnableFunctionMemo(any_cast<Function*>(func.data), reason) && is_memo)
+                throw ERROR_THROW::MemoImpureFunction(start_args_token, end_args_token, name, reason);
+        }
         
         auto object = CreateMemoryObject(func, function_type,&new_function_memory, is_const, is_static, is_final, is_global, is_private, is_shadow);
         if (_memory->check_literal(name))
@@ -0,0 +1,180 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-errors.cpp"
+#include "../twist-err.cpp"
+#include "../twist-array.cpp"
+#include "../twist-quicken.cpp"
+
+#include "NodeLiteral.cpp"
+#include "NodeBinary.cpp"
+#include "NodeVariableEqual.cpp"
+#include "NodeArrayPush.cpp"
+
+#pragma once
+
+/*
+ * Слитые узлы – замена частых шаблонов циклов одним узлом (создаются
+ * ASTOptimizer, см. twist-optimizer.cpp):
+ *
+ *   NodeIncrementLocal – `x = x + 1;`, `x = x - 2;` (шаг – константа Int);
+ *   NodeCompareLocal   – `i < n`, `i != 10` (слева имя, справа имя или Int);
+ *   NodePushLocal      – `arr <- value;` как оператор;
+ *   NodeAddLocal       – `x = x + expr;`, `x = x - expr;`.
+ *
+ * Обычный путь – несколько виртуальных вызовов, промежуточные Value и по
+ * поиску в памяти на каждую проверку (const, private, static ...); слитый
+ * узел находит переменную один раз и меняет Int на месте (тип проверяется
+ * стражем QuickInt из twist-quicken.cpp). Быстрый путь
+ * работает, только пока переменная – изменяемая локальная (см.
+ * IsWritableLocal) и значения имеют ожидаемый тип (Int, массив). Иначе
+ * выполняется исходный узел (fallback), с теми же результатами и ошибками;
+ * исходное поддерево также видят анализ чистоты и IsSideEffectFree.
+ *
+ * Порядок вычисления сохраняется: в `x = x + expr` значение x читается до
+ * expr, переменная ищется заново после expr (expr мог её удалить).
+ */
+
+// Переменную можно изменить на месте без проверок NodeVariableEqual.
+// static допустим: результат быстрого пути имеет тот же тип, что и значение.
+inline bool IsWritableLocal(MemoryObject* object) {
+    return object && !object->modifiers.is_const && !object->modifiers.is_private && !IsSharedObject(object);
+}
+
+struct NodeIncrementLocal : public Node { NO_EVAL
+    Symbol symbol;
+    int64_t delta;
+    NodeVariableEqual* fallback;
+
+    NodeIncrementLocal(Symbol symbol, int64_t delta, NodeVariableEqual* fallback)
+        : symbol(symbol), delta(delta), fallback(fallback) {
+        this->NODE_TYPE = NodeTypes::NODE_INCREMENT_LOCAL;
+    }
+
+    void exec_from(Memory* _memory) override {
+        auto object = _memory->get_variable(symbol);
+        if (IsWritableLocal(object) && QuickInt(object->value)) {
+            *any_cast<int64_t>(&object->value.data) += delta;
+            return;
+        }
+        fallback->exec_from(_memory);
+    }
+};
+
+struct NodeCompareLocal : public Node { NO_EXEC
+    enum Operation { LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL };
+
+    Symbol left;
+    Symbol right;               // пусто, если справа константа
+    int64_t right_constant = 0;
+    bool constant;
+    Operation operation;
+    NodeBinary* fallback;
+
+    NodeCompareLocal(Symbol left, Symbol right, int64_t right_constant, bool constant,
+                     Operation operation, NodeBinary* fallback)
+        : left(left), right(right), right_constant(right_constant), constant(constant),
+          operation(operation), fallback(fallback) {
+        this->NODE_TYPE = NodeTypes::NODE_COMPARE_LOCAL;
+    }
+
+    // Оператор сравнения по строке NodeBinary::op; false – не сравнение
+    static bool ParseOperation(const string& op, Operation& operation) {
+        if (op == "<") operation = LESS;
+        else if (op == "<=") operation = LESS_EQUAL;
+        else if (op == ">") operation = GREATER;
+        else if (op == ">=") operation = GREATER_EQUAL;
+        else if (op == "==") operation = EQUAL;
+        else if (op == "!=") operation = NOT_EQUAL;
+        else return false;
+        return true;
+    }
+
+    Value eval_from(Memory* _memory) override {
+        auto l = _memory->get_variable(left);
+        auto left_value = l ? QuickInt(l->value) : nullptr;
+        if (!left_value)
+            return fallback->eval_from(_memory);
+        int64_t r = right_constant;
+        if (!constant) {
+            auto object = _memory->get_variable(right);
+            auto right_value = object ? QuickInt(object->value) : nullptr;
+            if (!right_value)
+                return fallback->eval_from(_memory);
+            r = *right_value;
+        }
+        int64_t value = *left_value;
+        switch (operation) {
+            case LESS:          return NewBool(value < r);
+            case LESS_EQUAL:    return NewBool(value <= r);
+            case GREATER:       return NewBool(value > r);
+            case GREATER_EQUAL: return NewBool(value >= r);
+            case EQUAL:         return NewBool(value == r);
+            default:            return NewBool(value != r);
+        }
+    }
+};
+
+struct NodePushLocal : public Node { NO_EVAL
+    Symbol symbol;
+    Node* value_expr;
+    NodeArrayPush* fallback;
+
+    NodePushLocal(Symbol symbol, NodeArrayPush* fallback)
+        : symbol(symbol), value_expr(fallback->right_expr), fallback(fallback) {
+        this->NODE_TYPE = NodeTypes::NODE_PUSH_LOCAL;
+    }
+
+    static bool IsPushable(MemoryObject* object) {
+        return object && object->value.type.is_array_type() && !IsSharedObject(object);
+    }
+
+    void exec_from(Memory* _memory) override {
+        if (!IsPushable(_memory->get_variable(symbol))) {
+            fallback->eval_from(_memory);
+            return;
+        }
+        auto value = value_expr->eval_from(_memory);
+        auto object = _memory->get_variable(symbol);
+        if (!IsPushable(object))
+            ERROR::InvalidArrayPushType(fallback->start_token, fallback->end_token,
+                                        object ? object->value.type.pool : "undefined");
+
+        // Тип элемента – из Type массива напрямую, без разбора строки типа
+        auto& arr = any_cast<Array&>(object->value.data);
+        auto& element_type = get<ArrayType>(arr.type.m_data).element_type;
+        if (element_type && !IsTypeCompatible(*element_type, value.type))
+            ERROR::InvalidArrayElementTypeOnPush(fallback->start_token, fallback->end_token,
+                                                 element_type->pool, value.type.pool);
+        arr.values.emplace_back(std::move(value));
+    }
+};
+
+struct NodeAddLocal : public Node { NO_EVAL
+    Symbol symbol;
+    bool subtract;
+    NodeBinary* binary;
+    NodeVariableEqual* fallback;
+
+    NodeAddLocal(Symbol symbol, NodeBinary* binary, NodeVariableEqual* fallback)
+        : symbol(symbol), subtract(binary->op == "-"), binary(binary), fallback(fallback) {
+        this->NODE_TYPE = NodeTypes::NODE_ADD_LOCAL;
+    }
+
+    void exec_from(Memory* _memory) override {
+        auto object = _memory->get_variable(symbol);
+        if (!IsWritableLocal(object) || !QuickInt(object->value)) {
+            fallback->exec_from(_memory);
+            return;
+        }
+        int64_t left = any_cast<int64_t>(object->value.data);
+        auto right_value = binary->right->eval_from(_memory);
+
+        object = _memory->get_variable(symbol);
+        auto right = QuickInt(right_value);
+        if (right && IsWritableLocal(object) && QuickInt(object->value)) {
+            *any_cast<int64_t>(&object->value.data) = subtract ? left - *right : left + *right;
+            return;
+        }
+        Value left_value = NewInt(left);
+        fallback->assign(binary->compute(left_value, right_value, _memory), _memory);
+    }
+};
@@ -1,6 +1,10 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-array.cpp"
+#include "../twist-map.cpp"
 #include "../twist-err.cpp"
+#include "NodeLiteral.cpp"
+
+#pragma once
 
 
 struct NodeGetIndex : public Node { NO_EXEC
@@ -15,8 +19,31 @@ struct NodeGetIndex : public Node { NO_EXEC
     }
 
     Value eval_from(Memory* _memory) override {
+        // Переменная индексируется на месте, без копирования всего массива;
+        // индекс вычисляется первым, так как может изменить переменную
+        if (expr->NODE_TYPE == NodeTypes::NODE_LITERAL) {
+            auto index_value = index_expr->eval_from(_memory);
+            return get(((NodeLiteral*)expr)->lookup(_memory), index_value);
+        }
         auto value = expr->eval_from(_memory);
         auto index_value = index_expr->eval_from(_memory);
+        return get(value, index_value);
+    }
+
+    Value get(const Value& value, const Value& index_value) {
+        // Map – значение по ключу, Set – принадлежность (Bool)
+        if (!value.type.is_array_type() && (value.type == STANDART_TYPE::MAP || value.type == STANDART_TYPE::SET)) {
+            TableKey key(index_value);
+            if (!key.valid())
+                throw ERROR_THROW::MapInvalidKeyType(start_token, end_token, index_value.type);
+            auto& table = any_cast<const ValueTable&>(value.data);
+            if (value.type == STANDART_TYPE::SET)
+                return NewBool(table.contains(key));
+            auto found = table.find(key);
+            if (!found)
+                throw ERROR_THROW::MapKeyNotFound(start_token, end_token, TableKeyRepr(index_value));
+            return *found;
+        }
 
         if (index_value.type != STANDART_TYPE::INT) 
             throw ERROR_THROW::ArrayInvalidIndexType(start_token, end_token, index_value.type);
@@ -25,21 +52,22 @@ struct NodeGetIndex : public Node { NO_EXEC
 
         // Обработка для массивов
         if (value.type.is_array_type()) {
-            auto arr = any_cast<Array>(value.data);
+            auto& arr = any_cast<const Array&>(value.data);
 
             // Отрицательный индекс: отсчёт с конца
+            int64_t size = (int64_t)arr.values.size();
             if (idx < 0) 
-                idx = arr.get_size() + idx;
+                idx = size + idx;
 
             // Проверка после пересчёта
-            if (idx < 0 || idx >= arr.get_size()) 
-                throw ERROR_THROW::ArrayIndexOutOfRange(start_token, end_token, idx, arr.get_size());
+            if (idx < 0 || idx >= size) 
+                throw ERROR_THROW::ArrayIndexOutOfRange(start_token, end_token, idx, size);
 
             return arr.values[idx];
         }
         // Обработка для строк
         else if (value.type == STANDART_TYPE::STRING) {
-            auto& str = any_cast<string&>(value.data);
+            auto& str = any_cast<const RuntimeString&>(value.data);
 
             if (idx < 0) 
                 idx = static_cast<int64_t>(str.size()) + idx;
@@ -1,4 +1,7 @@
 #include "../twist-nodetemp.cpp"
+#include "../twist-quicken.cpp"
+
+#pragma once
 
 /*
  * NodeIf – условный оператор if-else.
@@ -20,12 +23,16 @@
  *   - NULL_T: false.
  *   - POINTER: нулевой адрес → false, иначе → true.
  *   - остальные типы (Namespace, Type, Array, Function, Lambda) считаются true.
+ *
+ * Горячее условие Bool или Int проверяется без цепочки сравнений типов
+ * (QuickCondition, см. twist-quicken.cpp).
  */
 
 struct NodeIf : public Node { NO_EVAL
     Node* expr;
     Node* true_body;
     Node* else_body = nullptr;
+    QuickeningState quickening;
 
     NodeIf(Node* condition, Node* true_statement, Node* else_statement = nullptr) :
         expr(condition), true_body(true_statement),
@@ -38,7 +45,10 @@ struct NodeIf : public Node { NO_EVAL
 
         bool condition = false;
 
-        if (value.type == STANDART_TYPE::BOOL) {
+        if (QuickCondition(quickening, value, condition)) {
+            // специализированный путь
+        }
+        else if (value.type == STANDART_TYPE::BOOL) {
             condition = any_cast<bool>(value.data);
         }
         else if (value.type == STANDART_TYPE::INT) {
@@ -48,7 +58,7 @@ struct NodeIf : public Node { NO_EVAL
             condition = any_cast<float>(value.data) != 0.0f;
         }
         else if (value.type == STANDART_TYPE::STRING) {
-            condition = !any_cast<string>(value.data).empty();
+            condition = !any_cast<const RuntimeString&>(value.data).empty();
         }
         else if (value.type == STANDART_TYPE::CHAR) {
             condition = any_cast<char>(value.data) != '\0';
@@ -79,18 +89,24 @@ struct NodeIfExpr : public Node { NO_EXEC
     Node* expr;
     Node* true_expr;
     Node* else_expr;
+    QuickeningState quickening;
 
     NodeIfExpr(Node* condition, Node* true_expr, Node* else_expr)
         : expr(condition), true_expr(true_expr), else_expr(else_expr) {
             this->NODE_TYPE = NodeTypes::NODE_IF_EXPRESSION;
     }
 
-    Value eval_from(Memory* _memory) override {
+    // Вычисляет условие и возвращает выбранную ветку (nullptr – ветки нет).
+    // Используется также вызовом лямбды для хвостовых вызовов в ветках.
+    Node* select_branch(Memory* _memory) {
         auto value = expr->eval_from(_memory);
 
         bool condition = false;
 
-        if (value.type == STANDART_TYPE::BOOL) {
+        if (QuickCondition(quickening, value, condition)) {
+            // специализированный путь
+        }
+        else if (value.type == STANDART_TYPE::BOOL) {
             condition = any_cast<bool>(value.data);
         }
         else if (value.type == STANDART_TYPE::INT) {
@@ -100,7 +116,7 @@ struct NodeIfExpr : public Node { NO_EXEC
             condition = any_cast<float>(value.data) != 0.0f;
         }
         else if (value.type == STANDART_TYPE::STRING) {
-            condition = !any_cast<string>(value.data).empty();
+            condition = !any_cast<const RuntimeString&>(value.data).empty();
         }
         else if (value.type == STANDART_TYPE::CHAR) {
             condition = any_cast<char>(value.data) != '\0';
@@ -117,12 +133,15 @@ struct NodeIfExpr : public Node { NO_EXEC
             condition = true;
         }
 
-        if (condition) {
-            return true_expr->eval_from(_memory);
-        }
-        else if (else_expr) {
-            return else_expr->eval_from(_memory);
-        }
+        if (condition)
+            return true_expr;
+        return else_expr;
+    }
+
+    Value eval_from(Memory* _memory) override {
+        Node* branch = select_branch(_memory);
+        if (branch)
+            return branch->eval_from(_memory);
         return NewNull();
     }
 };
\ No newline at end of file
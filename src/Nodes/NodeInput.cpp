@@ -1,5 +1,18 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-err.cpp"
+#include "../twist-input.cpp"
+
+/*
+ * NodeInput – чтение строки со стандартного ввода.
+ *
+ *   input / input(prompt) – одна строка; пустая строка и конец ввода – null.
+ *
+ * Строки берутся из InputBuffer (см. twist-input.cpp). Пакетное чтение –
+ * встроенная функция input_lines (twist-builtins.cpp).
+ *
+ * Поля:
+ *   expr – приглашение (String или Char), может отсутствовать.
+ */
 
 struct NodeInput : public Node { NO_EXEC
     Node* expr;
@@ -13,27 +26,29 @@ struct NodeInput : public Node { NO_EXEC
 
     Value eval_from(Memory* _memory) override {
         #ifndef SERVER
+            if (RuntimeContext::current().task)
+                throw ERROR_THROW::ParallelInput(start_token, end_token);
+
             if (expr) {
 
                 auto value = expr->eval_from(_memory);
 
                 if (value.type == STANDART_TYPE::STRING) {
-                    cout << any_cast<string>(value.data);
+                    auto& str = any_cast<const RuntimeString&>(value.data);
+                    OutputBuffer::write(str.data(), str.size());
                 } else if (value.type == STANDART_TYPE::CHAR) {
-                    cout << any_cast<char>(value.data);
+                    OutputBuffer::put(any_cast<char>(value.data));
                 } else {
                     throw ERROR_THROW::IncompartableInputType(start_token, end_token, value.type);
                 }
             }
 
-            string _input;
-            getline(cin, _input);
-
-            if (_input.empty()) 
+            // Вывод сбрасывается в InputBuffer перед блокирующим чтением
+            string_view line;
+            if (!InputBuffer::next_line(line) || line.empty())
                 return NewNull();
-            
-            auto value = NewString(_input);
-            return NewString(_input);
+
+            return NewString(RuntimeString(line));
             
         #else
             ERROR_THROW::InputWarning(start_token, end_token).Write();
@@ -3,6 +3,8 @@
 #include "../twist-lambda.cpp"
 #include "../twist-err.cpp"
 
+#include "NodeFunctionDeclaration.cpp"
+
 struct NodeLambda : public Node { NO_EXEC
     vector<Arg*> args;
     Node* return_type;
@@ -47,6 +49,7 @@ struct NodeLambda : public Node { NO_EXEC
         
         auto lambda = NewLambda(new_lambda_memory, body, args, return_type, name,
                                 start_args_token, end_args_token, start_type_token, end_type_token);
+        CacheSignatureTypes(any_cast<Lambda*>(lambda.data), new_lambda_memory);
 
         if (name != "") {
             // Добавляем лямбду в её собственную память под заданным именем
@@ -1,32 +1,45 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-err.cpp"
+#include "../twist-native.cpp"
 #pragma once
 
 /*
  * NodeLiteral – доступ к переменной по имени.
  *
- * Вычисляет значение переменной, хранящейся в текущей памяти.
- * Если переменная не определена, генерирует ошибку.
+ * Вычисляет значение переменной, хранящейся в текущей памяти. Имя, которого
+ * нет в памяти, ищется среди встроенных функций (NativeRegistry); если нет и
+ * там – ошибка.
  *
  * Поля:
  *   name – имя переменной.
+ *   symbol – интернированное имя (ключ Memory::string_pool).
  *   token – токен для позиционирования ошибки.
  */
 
 struct NodeLiteral : public Node { NO_EXEC
     string name;
+    Symbol symbol;
     Token& token;
    
 
     NodeLiteral(Token& token) : token(token) {
         name = token.value;
+        symbol = Symbol(name);
         this->NODE_TYPE = NODE_LITERAL;
     }
 
     Value eval_from(Memory* _memory) override {
-        if (!_memory->check_literal(name))
-            throw ERROR_THROW::VariableUndefined(token);
+        return lookup(_memory);
+    }
 
-        return _memory->get_variable(name)->value;
+    // Значение переменной без копирования (для индексации и sizeof)
+    const Value& lookup(Memory* _memory) {
+        auto object = _memory->get_variable(symbol);
+        if (!object) {
+            if (auto native = NativeRegistry::find(symbol))
+                return *native;
+            throw ERROR_THROW::VariableUndefined(token);
+        }
+        return object->value;
     }
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-err.cpp"
+#include "../twist-map.cpp"
+
+/*
+ * NodeMap – литерал Map{k: v, ...} или Set{a, b, ...}.
+ *
+ * Элементы вычисляются слева направо; повторный ключ заменяет значение
+ * (для Set – игнорируется). Порядок обхода – порядок первой вставки.
+ *
+ * Поля:
+ *   keys   – выражения ключей (с токенами для ошибок).
+ *   values – выражения значений; пуст для Set.
+ *   is_set – литерал Set.
+ */
+
+struct NodeMap : public Node { NO_EXEC
+    vector<tuple<Node*, Token, Token>> keys;
+    vector<Node*> values;
+    bool is_set;
+
+    NodeMap(vector<tuple<Node*, Token, Token>> keys, vector<Node*> values, bool is_set)
+        : keys(std::move(keys)), values(std::move(values)), is_set(is_set) {
+        this->NODE_TYPE = NodeTypes::NODE_MAP;
+    }
+
+    Value eval_from(Memory* _memory) override {
+        ValueTable table;
+        for (size_t i = 0; i < keys.size(); i++) {
+            auto key_value = get<0>(keys[i])->eval_from(_memory);
+            TableKey key(key_value);
+            if (!key.valid())
+                throw ERROR_THROW::MapInvalidKeyType(get<1>(keys[i]), get<2>(keys[i]), key_value.type);
+            if (is_set) {
+                if (!table.contains(key)) table.set(key, NewNull());
+            } else {
+                table.set(key, values[i]->eval_from(_memory));
+            }
+        }
+        return Value(is_set ? STANDART_TYPE::SET : STANDART_TYPE::MAP, std::move(table));
+    }
+};
@@ -19,11 +19,12 @@
 struct NodeNamespaceResolution : public Node { NO_EXEC
     Node*            namespace_expr;
     string           name;
+    Symbol           symbol;
     Token            start;
     Token            end;
 
     NodeNamespaceResolution(Node* namespace_expr, const string& name, Token start, Token end)
-        : namespace_expr(namespace_expr), name(name), start(start), end(end) {
+        : namespace_expr(namespace_expr), name(name), symbol(name), start(start), end(end) {
         NODE_TYPE = NodeTypes::NODE_NAME_RESOLUTION;
     }
 
@@ -41,10 +42,10 @@ struct NodeNamespaceResolution : public Node { NO_EXEC
         Memory* ns_memory = ns->memory;
 
         // Проверяем существование имени
-        if (!ns_memory->check_literal(name))
+        auto result = ns_memory->get_variable(symbol);
+        if (!result)
             throw ERROR_THROW::NamespaceUndefinedVariable(start, end, name);
 
-        auto result = ns_memory->get_variable(name);
         if (result->modifiers.is_private)
             throw ERROR_THROW::PrivateVariableAccess(start, end, name);
 
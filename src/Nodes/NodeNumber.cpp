@@ -26,6 +26,11 @@ struct NodeNumber : public Node { NO_EXEC
         this->NODE_TYPE = NodeTypes::NODE_NUMBER;
     }
 
+    // Готовое значение (используется при свёртке констант)
+    NodeNumber(const Value& value) : value(value) {
+        this->NODE_TYPE = NodeTypes::NODE_NUMBER;
+    }
+
     NodeNumber(Token& token) {
         this->NODE_TYPE = NodeTypes::NODE_NUMBER;
 
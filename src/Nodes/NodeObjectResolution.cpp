@@ -28,12 +28,13 @@
 struct NodeObjectResolution : public Node { NO_EXEC
     Node*    obj_expr;
     string              current_name;
+    Symbol              current_symbol;
 
     Token               start;  // токен имени (для ошибок)
     Token               end;    // он же
 
     NodeObjectResolution(Node* obj_expr, const string& current_name, Token start, Token end)
-        : obj_expr(obj_expr), current_name(current_name), start(start), end(end) {
+        : obj_expr(obj_expr), current_name(current_name), current_symbol(current_name), start(start), end(end) {
         this->NODE_TYPE = NodeTypes::NODE_OBJECT_RESOLUTION;
     }
 
@@ -47,11 +48,10 @@ struct NodeObjectResolution : public Node { NO_EXEC
         auto obj = any_cast<Struct*>(obj_value.data);
         
 
-        if (!obj->memory->check_literal(current_name))
+        auto result = obj->memory->get_variable(current_symbol);
+        if (!result)
             throw ERROR_THROW::VariableUndefined(start, end, current_name);
 
-        auto result = obj->memory->get_variable(current_name);
-
         if (result->modifiers.is_private)
             throw ERROR_THROW::PrivateVariableAccess(start, end, current_name);
 
@@ -3,88 +3,109 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-lambda.cpp"
 #include "../twist-array.cpp"
+#include "../twist-map.cpp"
+#include "../twist-native.cpp"
+#include "../twist-output.cpp"
 
 #include <any>
-#include <iomanip>   
-#include <limits>    
 
 /*
  * NodeBaseOut / NodeBaseOutLn – узлы вывода в консоль (out и outln).
  *
- * Принимают список выражений, вычисляют их и выводят результат в std::cout.
- * NodeBaseOutLn дополнительно выводит перевод строки и сбрасывает буфер.
+ * Принимают список выражений, вычисляют их и пишут результат в OutputBuffer
+ * (см. twist-output.cpp). NodeBaseOutLn дополнительно выводит перевод строки;
+ * сброс буфера выполняет OutputBuffer (на терминале – построчно).
  *
  * Поля:
  *   expression – вектор выражений для вывода.
  *
- * print() обрабатывает различные типы значений:
+ * PrintValue() обрабатывает различные типы значений:
  *   - INT, DOUBLE, BOOL, TYPE, NULL_T, NAMESPACE, STRING, CHAR – прямое строковое представление.
- *   - LAMBDA – "Lambda(arg1, arg2, ...)".
+ *   - LAMBDA – "Lambda(arg1, arg2, ...)", NATIVE – "Native'имя'".
  *   - POINTER – "<тип>[0x<адрес>]".
+ *   - ARRAY – "<тип>[<размер>]", MAP / SET – "Map[<размер>]" / "Set[<размер>]".
+ *   - FUTURE, CHANNEL, GENERATOR – имя типа.
  *   - FUNCTION – "Func'имя'(arg1:тип, ...) -> возврат".
  *
- * Для DOUBLE используется максимальная точность через std::setprecision.
+ * Для DOUBLE используется максимальная точность (max_digits10), числа
+ * форматируются без учёта локали. В сборке языкового сервера (SERVER)
+ * вывода нет.
  */
 
+#ifndef SERVER
+static void PrintValue(const Value& value, Memory* _memory) {
+    if (value.type == STANDART_TYPE::INT) {
+        OutputBuffer::write_int(any_cast<int64_t>(value.data));
+    } else if (value.type == STANDART_TYPE::DOUBLE) {
+        OutputBuffer::write_double(any_cast<NUMBER_ACCURACY>(value.data));
+    } else if (value.type == STANDART_TYPE::BOOL) {
+        OutputBuffer::write(any_cast<bool>(value.data) ? "true" : "false");
+    } else if (value.type == STANDART_TYPE::TYPE) {
+        OutputBuffer::write(any_cast<const Type&>(value.data).pool);
+    } else if (value.type == STANDART_TYPE::NULL_T) {
+        OutputBuffer::write("null");
+    } else if (value.type == STANDART_TYPE::NAMESPACE) {
+        OutputBuffer::write(any_cast<const Namespace&>(value.data).name);
+    } else if (value.type == STANDART_TYPE::STRING) {
+        auto& str = any_cast<const RuntimeString&>(value.data);
+        OutputBuffer::write(str.data(), str.size());
+    } else if (value.type == STANDART_TYPE::CHAR) {
+        OutputBuffer::put(any_cast<char>(value.data));
+    } else if (value.type == STANDART_TYPE::LAMBDA) {
+        OutputBuffer::write("Lambda(");
+        auto lambda = any_cast<Lambda*>(value.data);
+        for (int i = 0; i < lambda->arguments.size(); i++) {
+            OutputBuffer::write(lambda->arguments[i]->name);
+            if (i != lambda->arguments.size() - 1) OutputBuffer::write(", ");
+        }
+        OutputBuffer::put(')');
+    } else if (value.type == STANDART_TYPE::NATIVE) {
+        OutputBuffer::write("Native'" + any_cast<NativeFunction*>(value.data)->name + "'");
+    } else if (value.type.is_pointer()) {
+        OutputBuffer::write(value.type.pool);
+        OutputBuffer::write("[0x");
+        OutputBuffer::write_int(any_cast<int>(value.data));
+        OutputBuffer::put(']');
+    } else if (value.type.is_func()) {
+        auto f = any_cast<Function*>(value.data);
+        OutputBuffer::write("Func'" + f->name + "'(");
+        for (int i = 0; i < f->arguments.size(); i++) {
+            auto arg_type_val = f->arguments[i]->type_expr->eval_from(_memory);
+            OutputBuffer::write(f->arguments[i]->name + ":" + any_cast<Type>(arg_type_val.data).pool);
+            if (i != f->arguments.size() - 1) OutputBuffer::write(", ");
+        }
+        auto ret_type_val = f->return_type->eval_from(_memory);
+        OutputBuffer::write(") -> " + any_cast<Type>(ret_type_val.data).pool);
+    } else if (value.type.is_array_type()) {
+        OutputBuffer::write(value.type.pool);
+        OutputBuffer::put('[');
+        OutputBuffer::write_int((int64_t)any_cast<const Array&>(value.data).values.size());
+        OutputBuffer::put(']');
+    } else if (value.type == STANDART_TYPE::MAP || value.type == STANDART_TYPE::SET) {
+        OutputBuffer::write(value.type.pool);
+        OutputBuffer::put('[');
+        OutputBuffer::write_int((int64_t)any_cast<const ValueTable&>(value.data).size());
+        OutputBuffer::put(']');
+    } else if (value.type == STANDART_TYPE::FUTURE || value.type == STANDART_TYPE::CHANNEL ||
+               value.type == STANDART_TYPE::GENERATOR) {
+        OutputBuffer::write(value.type.pool);
+    }
+}
+#endif
+
 struct NodeBaseOut : public Node { NO_EVAL
     vector<Node*> expression;
     NodeBaseOut(vector<Node*> expr) : expression(expr) {
         this->NODE_TYPE = NodeTypes::NODE_OUT;
     }
 
-    void print(std::ostream& buf, Value value, Memory* _memory) {
-        if (value.type == STANDART_TYPE::INT) {
-            buf << any_cast<int64_t&>(value.data);
-        } else if (value.type == STANDART_TYPE::DOUBLE) {
-            buf << std::setprecision(std::numeric_limits<NUMBER_ACCURACY>::max_digits10) << any_cast<NUMBER_ACCURACY>(value.data);
-        } else if (value.type == STANDART_TYPE::BOOL) {
-            buf << (any_cast<bool&>(value.data) ? "true" : "false");
-        } else if (value.type == STANDART_TYPE::TYPE) {
-            buf << any_cast<Type&>(value.data).pool;
-        } else if (value.type == STANDART_TYPE::NULL_T) {
-            buf << "null";
-        } else if (value.type == STANDART_TYPE::NAMESPACE) {
-            buf << any_cast<Namespace&>(value.data).name;
-        } else if (value.type == STANDART_TYPE::STRING) {
-            buf << any_cast<string&>(value.data);
-        } else if (value.type == STANDART_TYPE::CHAR) {
-            buf << any_cast<char>(value.data);
-        } else if (value.type == STANDART_TYPE::LAMBDA) {
-            buf << "Lambda(";
-            auto lambda = any_cast<Lambda*>(value.data);
-            for (int i = 0; i < lambda->arguments.size(); i++) {
-                buf << lambda->arguments[i]->name;
-                if (i != lambda->arguments.size() - 1) buf << ", ";
-            }
-            buf << ")";
-        } else if (value.type.is_pointer()) {
-            buf << value.type.pool << "[0x" << any_cast<int>(value.data) << "]";
-        } else if (value.type.is_func()) {
-            auto f = any_cast<Function*>(value.data);
-            buf << "Func'" + f->name + "'(";
-            // ОПТИМИЗАЦИЯ: Кэшируем eval_from результаты вне цикла
-            for (int i = 0; i < f->arguments.size(); i++) {
-                auto arg_type_val = f->arguments[i]->type_expr->eval_from(_memory);
-                buf << f->arguments[i]->name << ":" << any_cast<Type>(arg_type_val.data).pool;
-
-                if (i != f->arguments.size() - 1) buf << ", ";
-            }
-            auto ret_type_val = f->return_type->eval_from(_memory);
-            buf << ") -> " << any_cast<Type>(ret_type_val.data).pool;
-        } else if (value.type.is_array_type()) {
-            buf << value.type.pool << "[" << any_cast<Array&>(value.data).values.size() << "]";
-        }
-    }
-
     void exec_from(Memory* _memory) override {
-        
-            for (auto& expr : expression) {
-                auto value = expr->eval_from(_memory);
-                #ifndef SERVER
-                    print(std::cout, value, _memory);
-                #endif
-            }
-        
+        for (auto& expr : expression) {
+            auto value = expr->eval_from(_memory);
+            #ifndef SERVER
+                PrintValue(value, _memory);
+            #endif
+        }
     }
 };
 
@@ -94,64 +115,15 @@ struct NodeBaseOutLn : public Node { NO_EVAL
         this->NODE_TYPE = NodeTypes::NODE_OUTLN;
     }
 
-    void print(std::ostream& buf, Value value, Memory* _memory) {
-        if (value.type == STANDART_TYPE::INT) {
-            buf << any_cast<int64_t>(value.data);
-        } else if (value.type == STANDART_TYPE::DOUBLE) {
-            buf << std::setprecision(std::numeric_limits<NUMBER_ACCURACY>::max_digits10) << any_cast<NUMBER_ACCURACY>(value.data);
-        } else if (value.type == STANDART_TYPE::BOOL) {
-            buf << (any_cast<bool>(value.data) ? "true" : "false");
-        } else if (value.type == STANDART_TYPE::TYPE) {
-            buf << any_cast<Type>(value.data).pool;
-        } else if (value.type == STANDART_TYPE::NULL_T) {
-            buf << "null";
-        } else if (value.type == STANDART_TYPE::NAMESPACE) {
-            buf << any_cast<Namespace>(value.data).name;
-        } else if (value.type == STANDART_TYPE::STRING) {
-            buf << any_cast<string>(value.data);
-        } else if (value.type == STANDART_TYPE::CHAR) {
-            buf << any_cast<char>(value.data);
-        } else if (value.type == STANDART_TYPE::LAMBDA) {
-            buf << "Lambda(";
-            auto lambda = any_cast<Lambda*>(value.data);
-            for (int i = 0; i < lambda->arguments.size(); i++) {
-                buf << lambda->arguments[i]->name;
-                if (i != lambda->arguments.size() - 1) buf << ", ";
-            }
-            buf << ")";
-            
-        } else if (value.type.is_pointer()) {
-            buf << value.type.pool << "[0x" << any_cast<int>(value.data) << "]";
-        } else if (value.type.is_func()) {
-            auto f = any_cast<Function*>(value.data);
-            buf << "Func'" + f->name + "'(";
-            // ОПТИМИЗАЦИЯ: Кэшируем eval_from результаты вне цикла
-            for (int i = 0; i < f->arguments.size(); i++) {
-                auto arg_type_val = f->arguments[i]->type_expr->eval_from(_memory);
-                buf << f->arguments[i]->name << ":" << any_cast<Type>(arg_type_val.data).pool;
-
-                if (i != f->arguments.size() - 1) buf << ", ";
-            }
-            auto ret_type_val = f->return_type->eval_from(_memory);
-            buf << ") -> " << any_cast<Type>(ret_type_val.data).pool;
-        } else if (value.type.is_array_type()) {
-            buf << value.type.pool << "[" << any_cast<Array&>(value.data).values.size() << "]";
-        }
-    }
-
     void exec_from(Memory* _memory) override {
-        
-            for (auto& expr : expression) {
-                auto value = expr->eval_from(_memory);
-                #ifndef SERVER
-                    print(std::cout, value, _memory);
-                #endif
-            }
+        for (auto& expr : expression) {
+            auto value = expr->eval_from(_memory);
             #ifndef SERVER
-                std::cout << '\n';
-                std::cout.flush();
+                PrintValue(value, _memory);
             #endif
-            
-        
+        }
+        #ifndef SERVER
+            OutputBuffer::newline();
+        #endif
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,124 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-parallel.cpp"
+#include "../twist-native.cpp"
+
+#include "NodeBreak.cpp"
+#include "NodeContinue.cpp"
+#include "NodeReturn.cpp"
+#include "NodeCall.cpp"
+#include "NodeValueHolder.cpp"
+
+#include "../twist-err.cpp"
+
+#pragma once
+
+/*
+ * NodeParallelFor – параллельный цикл со счётчиком (parallel for).
+ *
+ *     parallel for (let i = from; i < to; i = i + 1;) body
+ *
+ * Парсер принимает только такой вид цикла (условие < или <=, шаг 1), поэтому
+ * число итераций известно заранее: границы вычисляются один раз, и диапазон
+ * делится на части, которые выполняются в пуле потоков (см. ParallelFor).
+ *
+ * Каждая часть выполняется в своей памяти: она видит все имена внешней
+ * памяти, но её объявления и счётчик цикла – свои. Менять внешние объекты
+ * нельзя (ошибка, а не гонка); вывод выводится в порядке итераций.
+ * continue переходит к следующей итерации; break, ret и выход из функции
+ * через цикл – ошибка: порядок итераций не определён.
+ *
+ * Поля:
+ *   var_name, var_symbol – имя счётчика.
+ *   from, to – границы (Int).
+ *   inclusive – условие <=.
+ *   body – тело цикла.
+ */
+
+struct NodeParallelFor : public Node { NO_EVAL
+    string var_name;
+    Symbol var_symbol;
+    Node* from;
+    Node* to;
+    bool inclusive;
+    Node* body;
+
+    Token start_token;
+    Token end_token;
+
+    NodeParallelFor(const string& var_name, Node* from, Node* to, bool inclusive, Node* body,
+                    Token start_token, Token end_token)
+        : var_name(var_name), var_symbol(Symbol(var_name)), from(from), to(to), inclusive(inclusive),
+          body(body), start_token(start_token), end_token(end_token) {
+        this->NODE_TYPE = NodeTypes::NODE_PARALLEL_FOR;
+    }
+
+    int64_t bound(Node* node, Memory* _memory) {
+        auto value = node->eval_from(_memory);
+        if (value.type != STANDART_TYPE::INT)
+            throw ERROR_THROW::ParallelForInvalidBound(start_token, end_token, value.type);
+        return any_cast<int64_t>(value.data);
+    }
+
+    void exec_from(Memory* _memory) override {
+        int64_t first = bound(from, _memory);
+        int64_t last = bound(to, _memory) + (inclusive ? 1 : 0);
+        if (last <= first)
+            return;
+
+        ParallelFor((size_t)(last - first), [&](size_t begin, size_t end) {
+            Memory frame;
+            frame.string_pool = _memory->string_pool;
+            frame.string_pool.erase(var_symbol);
+
+            auto counter = CreateMemoryObject(NewInt(first + (int64_t)begin), STANDART_TYPE::INT, &frame,
+                false, false, false, false, false, false, var_name, &frame);
+            STATIC_MEMORY.register_object(counter);
+            frame.add_object(var_symbol, counter);
+
+            for (size_t i = begin; i < end; i++) {
+                counter->value = NewInt(first + (int64_t)i);
+                try {
+                    body->exec_from(&frame);
+                }
+                catch (Continue) {}
+                catch (Break) { throw ERROR_THROW::ParallelForEscape(start_token, end_token, "break"); }
+                catch (Return) { throw ERROR_THROW::ParallelForEscape(start_token, end_token, "ret"); }
+                catch (TailCall) { throw ERROR_THROW::ParallelForEscape(start_token, end_token, "ret"); }
+            }
+        });
+    }
+};
+
+namespace BUILTINS {
+
+    // pmap(array, fn) – [fn(a[0]), fn(a[1]), ...], вызовы fn выполняются параллельно
+    Value ParallelMap(NativeCall& call, void*) {
+        if (!call.args[0].type.is_array_type())
+            throw ERROR_THROW::InvalidNativeArgumentType(call.start, call.end, "pmap", 0, Type("[auto, ~]"), call.args[0].type);
+        auto& source = any_cast<const Array&>(call.args[0].data).values;
+        auto& callee = call.args[1];
+        vector<Value> results(source.size(), NewNull());
+
+        ParallelFor(source.size(), [&](size_t begin, size_t end) {
+            NodeValueHolder callable(callee);
+            NodeValueHolder element(NewNull());
+            NodeCall invoke(&callable, { &element }, call.start, call.end);
+            Value function = callee;
+            for (size_t i = begin; i < end; i++) {
+                element.value = source[i];
+                results[i] = invoke.invoke(function, call.memory);
+            }
+        });
+
+        // Тип результата – объединение типов элементов, как у литерала [a, b, ...]
+        Type T = Type();
+        for (size_t i = 0; i < results.size(); i++)
+            T = i == 0 ? results[i].type : T | results[i].type;
+        T = Type("[" + T.pool + ", ~]");
+        return Value(T, Array(T, std::move(results)));
+    }
+
+    NativeFunction PMAP { "pmap", 2, {}, ParallelMap };
+
+    const bool PARALLEL_REGISTERED = NativeRegistry::define(&PMAP);
+}
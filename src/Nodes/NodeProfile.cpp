@@ -0,0 +1,34 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-profiler.cpp"
+
+#pragma once
+
+/*
+ * NodeProfile – обёртка оператора для --profile.
+ *
+ * Добавляется проходом ASTInstrumenter только при включённом профилировании
+ * и учитывает выполнение обёрнутого узла в записи строки исходника.
+ *
+ * Поля:
+ *   node  – исходный оператор.
+ *   entry – запись профиля строки, на которой начинается оператор.
+ */
+
+struct NodeProfile : public Node {
+    Node* node;
+    ProfileEntry* entry;
+
+    NodeProfile(Node* node, ProfileEntry* entry) : node(node), entry(entry) {
+        this->NODE_TYPE = NodeTypes::NODE_PROFILE;
+    }
+
+    Value eval_from(Memory* _memory) override {
+        ProfileScope scope(entry);
+        return node->eval_from(_memory);
+    }
+
+    void exec_from(Memory* _memory) override {
+        ProfileScope scope(entry);
+        node->exec_from(_memory);
+    }
+};
@@ -5,9 +5,20 @@
 
 struct Return {
     Value value;
-    Return(Value value) : value(value) {}
+    Return(Value value) : value(value) { STAT_INC(throws_return); }
 };
 
+// Хвостовой вызов `ret f(...)`: вызов не выполняется на месте, а передаётся
+// в call_function вместе с памятью, в которой вычисляются аргументы. Память
+// вызова к этому моменту ещё жива, а нативный стек тела функции уже раскручен.
+struct TailCall {
+    Node* call;
+    Memory* memory;
+};
+
+// Число выполняемых сейчас тел функций – RuntimeContext::active_function_frames
+// (вне функции ret – обычный Return)
+
 struct NodeReturn : public Node { NO_EVAL
     Node* expr;
     Token start_token;
@@ -21,6 +32,10 @@ struct NodeReturn : public Node { NO_EVAL
     void exec_from(Memory* _memory) override {
         if (!expr)
             throw Return(NewNull());
+        if (expr->NODE_TYPE == NodeTypes::NODE_CALL && RuntimeContext::current().active_function_frames > 0) {
+            STAT_INC(throws_tail_call);
+            throw TailCall{expr, _memory};
+        }
         auto value = expr->eval_from(_memory);
         throw Return(value);
     }
@@ -1,7 +1,9 @@
 #include "../twist-nodetemp.cpp"
 #include "../twist-array.cpp"
+#include "../twist-map.cpp"
 #include "../twist-namespace.cpp"
 #include "../twist-err.cpp"
+#include "NodeLiteral.cpp"
 
 struct NodeSizeof : public Node { NO_EXEC
     Node* expr;
@@ -16,7 +18,13 @@ struct NodeSizeof : public Node { NO_EXEC
         if (!expr)
             throw ERROR_THROW::UnexpectedToken(expr_token, "expression");
 
-        auto value = expr->eval_from(_memory);
+        // Переменная читается на месте – sizeof массива не копирует его
+        if (expr->NODE_TYPE == NodeTypes::NODE_LITERAL)
+            return size_of(((NodeLiteral*)expr)->lookup(_memory));
+        return size_of(expr->eval_from(_memory));
+    }
+
+    Value size_of(const Value& value) {
         if (value.type == STANDART_TYPE::INT)
             return NewInt(sizeof(int64_t));
         if (value.type == STANDART_TYPE::DOUBLE)
@@ -24,7 +32,7 @@ struct NodeSizeof : public Node { NO_EXEC
         if (value.type == STANDART_TYPE::CHAR)
             return NewInt(sizeof(char));
         if (value.type == STANDART_TYPE::STRING)
-            return NewInt(any_cast<string&>(value.data).size());
+            return NewInt(any_cast<const RuntimeString&>(value.data).size());
         if (value.type == STANDART_TYPE::BOOL)
             return NewInt(sizeof(bool));
         if (value.type == STANDART_TYPE::TYPE)
@@ -34,8 +42,10 @@ struct NodeSizeof : public Node { NO_EXEC
         if (value.type == STANDART_TYPE::NULL_T)
             return NewInt(sizeof(Null));
         if (value.type.is_array_type()) {
-            return NewInt(any_cast<Array&>(value.data).values.size());
+            return NewInt(any_cast<const Array&>(value.data).values.size());
         }
+        if (value.type == STANDART_TYPE::MAP || value.type == STANDART_TYPE::SET)
+            return NewInt(any_cast<const ValueTable&>(value.data).size());
 
         return NewInt(sizeof(std::any));
     }
@@ -0,0 +1,93 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-tasks.cpp"
+
+#include "NodeCall.cpp"
+#include "NodeValueHolder.cpp"
+
+#include "../twist-err.cpp"
+
+#include <memory>
+
+#pragma once
+
+/*
+ * NodeSpawn – запуск вызова в отдельной задаче (см. twist-tasks.cpp).
+ *
+ *     let future = spawn f(a, b);
+ *
+ * Вызываемое значение и аргументы вычисляются на месте, сам вызов
+ * выполняется в пуле задач. Результат – Future для await.
+ *
+ * Поля:
+ *   call – вызов (NodeCall), его callable и args.
+ */
+
+struct NodeSpawn : public Node { NO_EXEC
+    NodeCall* call;
+
+    Token start_token;
+    Token end_token;
+
+    NodeSpawn(NodeCall* call, Token start_token, Token end_token)
+        : call(call), start_token(start_token), end_token(end_token) {
+        this->NODE_TYPE = NodeTypes::NODE_SPAWN;
+    }
+
+    // Вызов в потоке задачи: аргументы – готовые значения
+    static Value invoke(const Value& callee, const vector<Value>& args, Memory* memory,
+                        const Token& start, const Token& end) {
+        vector<std::unique_ptr<NodeValueHolder>> holders;
+        vector<Node*> arg_nodes;
+        for (auto& arg : args) {
+            holders.push_back(std::make_unique<NodeValueHolder>(arg));
+            arg_nodes.push_back(holders.back().get());
+        }
+        NodeValueHolder callable(callee);
+        NodeCall task_call(&callable, arg_nodes, start, end);
+        Value function = callee;
+        return task_call.invoke(function, memory);
+    }
+
+    Value eval_from(Memory* _memory) override {
+        auto callee = call->callable->eval_from(_memory);
+        if (!callee.type.is_func() && callee.type != STANDART_TYPE::LAMBDA && callee.type != STANDART_TYPE::NATIVE)
+            throw ERROR_THROW::SpawnNotCallable(start_token, end_token, callee.type);
+
+        vector<Value> args;
+        args.reserve(call->args.size());
+        for (auto arg : call->args) {
+            args.push_back(arg->eval_from(_memory));
+            CheckTransfer(args.back(), true, "argument of 'spawn'", start_token, end_token);
+        }
+        return NewFuture(SpawnTask(std::move(callee), std::move(args), invoke, start_token, end_token));
+    }
+};
+
+/*
+ * NodeAwait – ожидание задачи: await future.
+ *
+ * Возвращает результат задачи; ошибка в задаче – ошибка здесь. Вывод задачи
+ * попадает в вывод в месте первого await.
+ *
+ * Поля:
+ *   expr – выражение типа Future.
+ */
+
+struct NodeAwait : public Node { NO_EXEC
+    Node* expr;
+
+    Token start_token;
+    Token end_token;
+
+    NodeAwait(Node* expr, Token start_token, Token end_token)
+        : expr(expr), start_token(start_token), end_token(end_token) {
+        this->NODE_TYPE = NodeTypes::NODE_AWAIT;
+    }
+
+    Value eval_from(Memory* _memory) override {
+        auto future = expr->eval_from(_memory);
+        if (future.type != STANDART_TYPE::FUTURE)
+            throw ERROR_THROW::AwaitNotFuture(start_token, end_token, future.type);
+        return any_cast<const std::shared_ptr<TaskState>&>(future.data)->take();
+    }
+};
@@ -12,7 +12,12 @@
 struct NodeString : public Node { NO_EXEC
     Value value;  // Храним сразу Value
 
-    NodeString(string& val) : value(NewString(std::move(val))) {
+    NodeString(string& val) : value(NewString(val)) {
+        this->NODE_TYPE = NodeTypes::NODE_STRING;
+    }
+
+    // Литерал из уже вычисленной строки (свёртка констант) – буфер общий
+    NodeString(const RuntimeString& val) : value(NewString(val)) {
         this->NODE_TYPE = NodeTypes::NODE_STRING;
     }
 
@@ -18,7 +18,7 @@ struct NodeValueHolder : public Node { NO_EXEC
         this->NODE_TYPE = NodeTypes::NODE_VALUE_HOLDER;
     }
 
-    Value eval_from(Memory& _memory) override {
+    Value eval_from(Memory*) override {
         return value;
     }
 };
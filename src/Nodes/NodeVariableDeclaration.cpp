@@ -33,6 +33,7 @@
 
 struct NodeVariableDeclaration : public Node { NO_EVAL
     string var_name;
+    Symbol var_symbol;  // интернированное var_name
 
     Node* value_expr;
     Node* type_expr = nullptr;
@@ -56,7 +57,7 @@ struct NodeVariableDeclaration : public Node { NO_EVAL
 
     NodeVariableDeclaration(const string& name, Node* expr, Token decl_token, Node* type_expr,
                             Token type_start_token, Token type_end_token, bool nullable, Token start_expr_token, Token end_expr_token)
-        : var_name(name), decl_token(decl_token), type_start_token(type_start_token), type_end_token(type_end_token),
+        : var_name(name), var_symbol(name), decl_token(decl_token), type_start_token(type_start_token), type_end_token(type_end_token),
         nullable(nullable), start_expr_token(start_expr_token), end_expr_token(end_expr_token) {
             this->NODE_TYPE = NodeTypes::NODE_VARIABLE_DECLARATION;
             this->value_expr = expr;
@@ -67,16 +68,20 @@ struct NodeVariableDeclaration : public Node { NO_EVAL
 
         Value value = value_expr->eval_from(_memory);
 
-        if (_memory->check_literal(var_name)) {
-            if (_memory->is_final(var_name)) {
+        if (auto existing = _memory->get_variable(var_symbol)) {
+            if (existing->modifiers.is_final) {
                 throw ERROR_THROW::VariableAlreadyDefined(decl_token);
             }
-            if (_memory->is_global(var_name) && !_memory->is_shadow(var_name)) {
+            if (existing->modifiers.is_global && !existing->modifiers.is_shadow) {
                 throw ERROR_THROW::VariableShadowsGlobal(decl_token, var_name);
             }
-            auto addr = _memory->get_variable(var_name)->address;
-            STATIC_MEMORY.unregister_object(addr);
-            _memory->delete_variable(var_name);
+            if (IsSharedObject(existing)) {
+                // Параллельная задача: внешний объект только скрывается в её памяти
+                _memory->string_pool.erase(var_symbol);
+            } else {
+                STATIC_MEMORY.unregister_object(existing->address);
+                _memory->delete_variable(var_symbol);
+            }
         }
 
         Type static_type = value.type;
@@ -107,6 +112,6 @@ struct NodeVariableDeclaration : public Node { NO_EVAL
 
         MemoryObject* object = CreateMemoryObject(value, static_type, _memory, is_const, is_static, is_final, is_global, is_private, is_shadow, var_name, _memory);
         STATIC_MEMORY.register_object(object);
-        _memory->add_object(var_name, object);
+        _memory->add_object(var_symbol, object);
     }
 };
@@ -2,7 +2,37 @@
 #include "../twist-err.cpp"
 #include "NodeDereference.cpp"
 #include "TargetResolver.cpp"
+#include "NodeBinary.cpp"
+#include "NodeGetIndex.cpp"
+#include "../twist-map.cpp"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#pragma once
+
+// Определена в twist-purity.cpp (анализу нужны все типы узлов)
+bool IsSideEffectFree(Node* node, vector<string>& type_callees);
+
+/*
+ * NodeVariableEqual – присваивание переменной, полю, элементу или через *.
+ *
+ * Быстрый путь для строк: `s = s + a + b ...` дописывает части прямо в строку
+ * переменной вместо создания новой строки на каждом +, поэтому сборка строки
+ * в цикле линейна. Условия проверяются один раз (prepare_append, под
+ * call_once – AST может выполняться из нескольких потоков): слева –
+ * имя, справа – цепочка + от этого же имени, части без побочных эффектов.
+ * При выполнении переменная должна быть строкой без const/private, а все
+ * части – строками; иначе выполняется обычное присваивание (с теми же
+ * ошибками). Части вычисляются до изменения строки – `s = s + s` корректно.
+ *
+ * Присваивание элементу (`a[i] = v`, `m[k] = v`, `s[x] = true/false`,
+ * `a[i][j] = v`) изменяет значение переменной на месте: все индексы
+ * вычисляются заранее, затем цепочка проходится по ссылкам без копирования
+ * массивов и таблиц. Map вставляет или заменяет ключ, Set добавляет (true)
+ * или удаляет (false) элемент.
+ */
 
 struct NodeVariableEqual : public Node { NO_EVAL
     Node* expression;
@@ -14,6 +44,11 @@ struct NodeVariableEqual : public Node { NO_EVAL
     Token start_value_token;
     Token end_value_token;
 
+    std::atomic<int> append_state{-1};  // -1 – не проверено, 0 – не подходит, 1 – быстрый путь
+    std::once_flag append_prepared;
+    vector<Node*> append_parts;
+    vector<string> append_type_callees;
+
     NodeVariableEqual(Node* variable, Node* expression,
                       Token start_left_value_token, Token end_left_value_token,
                       Token start_value_token, Token end_value_token)
@@ -23,10 +58,156 @@ struct NodeVariableEqual : public Node { NO_EVAL
         this->NODE_TYPE = NodeTypes::NODE_VARIABLE_EQUAL;
     }
 
+    void prepare_append() {
+        append_state = 0;
+        if (variable->NODE_TYPE != NODE_LITERAL)
+            return;
+        Node* node = expression;
+        vector<Node*> parts;
+        while (node && node->NODE_TYPE == NODE_BINARY && ((NodeBinary*)node)->op == "+") {
+            parts.push_back(((NodeBinary*)node)->right);
+            node = ((NodeBinary*)node)->left;
+        }
+        if (parts.empty() || !node || node->NODE_TYPE != NODE_LITERAL ||
+            ((NodeLiteral*)node)->name != ((NodeLiteral*)variable)->name)
+            return;
+        for (auto part : parts)
+            if (!IsSideEffectFree(part, append_type_callees))
+                return;
+        reverse(parts.begin(), parts.end());
+        append_parts = std::move(parts);
+        append_state = 1;
+    }
+
+    bool try_append(Memory* _memory) {
+        if (append_state == -1)
+            std::call_once(append_prepared, [this](){ prepare_append(); });
+        if (append_state != 1)
+            return false;
+
+        auto object = _memory->get_variable(((NodeLiteral*)variable)->symbol);
+        if (!object || object->value.type != STANDART_TYPE::STRING ||
+            object->modifiers.is_const || object->modifiers.is_private || IsSharedObject(object))
+            return false;
+        for (auto& callee : append_type_callees) {
+            auto callee_object = _memory->get_variable(callee);
+            if (!callee_object || callee_object->value.type != STANDART_TYPE::TYPE)
+                return false;
+        }
+
+        vector<Value> values;
+        values.reserve(append_parts.size());
+        for (auto part : append_parts) {
+            values.push_back(part->eval_from(_memory));
+            if (values.back().type != STANDART_TYPE::STRING)
+                return false;
+        }
+        // Буфер дописывается на месте, только если им больше никто не владеет
+        auto& str = any_cast<RuntimeString&>(object->value.data);
+        for (auto& value : values)
+            str.append(any_cast<const RuntimeString&>(value.data));
+        return true;
+    }
+
+    // Значение переменной (имя, поле, элемент namespace) для изменения на месте
+    Value& resolve_root(Node* node, Memory* _memory) {
+        pair<Memory*, Symbol> target = resolveTargetMemory(node, _memory);
+        if (!target.first)
+            throw ERROR_THROW::InvalidNodeType(start_left_value_token, "variable", get_node_type_name(node->NODE_TYPE));
+        if (target.first->is_private(target.second))
+            throw ERROR_THROW::PrivateVariableAccess(start_left_value_token, end_value_token, target.second.name());
+        if (target.first->is_const(target.second))
+            throw ERROR_THROW::VariableConstRedefinition(start_left_value_token, end_value_token, target.second.name());
+        auto object = target.first->get_variable(target.second);
+        if (IsSharedObject(object))
+            throw ERROR_THROW::ParallelSharedWrite(start_left_value_token, end_left_value_token, target.second.name());
+        return object->value;
+    }
+
+    // Ссылка на существующий элемент массива или значение Map
+    Value& element(Value& base, const Value& index_value) {
+        if (base.type.is_array_type()) {
+            if (index_value.type != STANDART_TYPE::INT)
+                throw ERROR_THROW::ArrayInvalidIndexType(start_left_value_token, end_left_value_token, index_value.type);
+            auto& arr = any_cast<Array&>(base.data);
+            int64_t idx = any_cast<int64_t>(index_value.data);
+            int64_t size = (int64_t)arr.values.size();
+            if (idx < 0)
+                idx = size + idx;
+            if (idx < 0 || idx >= size)
+                throw ERROR_THROW::ArrayIndexOutOfRange(start_left_value_token, end_left_value_token, idx, size);
+            return arr.values[idx];
+        }
+        if (base.type == STANDART_TYPE::MAP) {
+            TableKey key(index_value);
+            if (!key.valid())
+                throw ERROR_THROW::MapInvalidKeyType(start_left_value_token, end_left_value_token, index_value.type);
+            auto found = any_cast<ValueTable&>(base.data).find(key);
+            if (!found)
+                throw ERROR_THROW::MapKeyNotFound(start_left_value_token, end_left_value_token, TableKeyRepr(index_value));
+            return *found;
+        }
+        throw ERROR_THROW::InvalidIndexAssignment(start_left_value_token, end_left_value_token, base.type);
+    }
+
+    void assign_index(Value right_value, Memory* _memory) {
+        // Цепочка a[i][j]...: индексы вычисляются слева направо до изменения
+        vector<NodeGetIndex*> chain;
+        Node* root = variable;
+        while (root->NODE_TYPE == NODE_GET_BY_INDEX) {
+            chain.push_back((NodeGetIndex*)root);
+            root = ((NodeGetIndex*)root)->expr;
+        }
+        reverse(chain.begin(), chain.end());
+        vector<Value> indexes;
+        indexes.reserve(chain.size());
+        for (auto index : chain)
+            indexes.push_back(index->index_expr->eval_from(_memory));
+
+        Value* base = &resolve_root(root, _memory);
+        for (size_t i = 0; i + 1 < indexes.size(); i++)
+            base = &element(*base, indexes[i]);
+
+        const Value& index_value = indexes.back();
+        if (base->type == STANDART_TYPE::MAP || base->type == STANDART_TYPE::SET) {
+            TableKey key(index_value);
+            if (!key.valid())
+                throw ERROR_THROW::MapInvalidKeyType(start_left_value_token, end_left_value_token, index_value.type);
+            auto& table = any_cast<ValueTable&>(base->data);
+            if (base->type == STANDART_TYPE::MAP) {
+                table.set(key, std::move(right_value));
+                return;
+            }
+            if (right_value.type != STANDART_TYPE::BOOL)
+                throw ERROR_THROW::SetInvalidMembershipValue(start_value_token, end_value_token, right_value.type);
+            if (!any_cast<bool>(right_value.data))
+                table.erase(key);
+            else if (!table.contains(key))
+                table.set(key, NewNull());
+            return;
+        }
+
+        auto& slot = element(*base, index_value);
+        auto elem_type_str = any_cast<Array&>(base->data).type.parse_array_type().first;
+        if (elem_type_str != "" && !IsTypeCompatible(Type(elem_type_str), right_value.type))
+            throw ERROR_THROW::ArrayInvalidElementType(start_value_token, end_value_token, Type(elem_type_str), right_value.type,
+                                                       (size_t)any_cast<int64_t>(index_value.data));
+        slot = std::move(right_value);
+    }
+
     void exec_from(Memory* _memory) override {
-        auto right_value = expression->eval_from(_memory);
-        
-        
+        if (append_state != 0 && try_append(_memory))
+            return;
+
+        assign(expression->eval_from(_memory), _memory);
+    }
+
+    // Присваивание уже вычисленного значения (также используется слитыми узлами)
+    void assign(Value right_value, Memory* _memory) {
+        if (variable->NODE_TYPE == NODE_GET_BY_INDEX) {
+            assign_index(std::move(right_value), _memory);
+            return;
+        }
         
         if (variable->NODE_TYPE == NODE_DEREFERENCE) {
             auto left_value = ((NodeDereference*)variable)->expr->eval_from(_memory);
@@ -45,6 +226,8 @@ struct NodeVariableEqual : public Node { NO_EVAL
             // Проверяем константность
             if (modifiers.is_const) 
                 throw ERROR_THROW::PointerToConstRedefinition(start_left_value_token, end_left_value_token);
+            if (IsSharedObject(object))
+                throw ERROR_THROW::ParallelSharedWrite(start_left_value_token, end_left_value_token, object->var_name);
             
 
             // Проверяем типизацию для статических переменных
@@ -63,20 +246,20 @@ struct NodeVariableEqual : public Node { NO_EVAL
             return;
         }
 
-        pair<Memory*, string> target = resolveTargetMemory(variable, _memory);
+        pair<Memory*, Symbol> target = resolveTargetMemory(variable, _memory);
 
         Memory* target_memory = target.first;
-        string target_var_name = target.second;
+        Symbol target_var_name = target.second;
 
         if (target_memory->is_private(target_var_name)) 
-            throw ERROR_THROW::PrivateVariableAccess(start_left_value_token, end_value_token, target_var_name);
+            throw ERROR_THROW::PrivateVariableAccess(start_left_value_token, end_value_token, target_var_name.name());
         
 
         if (!target_memory->check_literal(target_var_name))
-            throw ERROR_THROW::VariableUndefined(start_left_value_token, end_left_value_token, target_var_name);
+            throw ERROR_THROW::VariableUndefined(start_left_value_token, end_left_value_token, target_var_name.name());
 
         if (target_memory->is_const(target_var_name)) 
-            throw ERROR_THROW::VariableConstRedefinition(start_left_value_token, end_value_token, target_var_name);
+            throw ERROR_THROW::VariableConstRedefinition(start_left_value_token, end_value_token, target_var_name.name());
         
 
         if (target_memory->is_static(target_var_name)) {
@@ -87,7 +270,10 @@ struct NodeVariableEqual : public Node { NO_EVAL
             
         }
 
-        target_memory->set_object_value(target_var_name, right_value);
+        auto object = target_memory->get_variable(target_var_name);
+        if (IsSharedObject(object))
+            throw ERROR_THROW::ParallelSharedWrite(start_left_value_token, end_left_value_token, target_var_name.name());
+        object->value = right_value;
     }
 
 };
\ No newline at end of file
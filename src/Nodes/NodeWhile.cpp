@@ -2,6 +2,7 @@
 #include "NodeBreak.cpp"
 #include "NodeContinue.cpp"
 #include "../twist-err.cpp"
+#include "../twist-quicken.cpp"
 
 #define MAX_LSP_ITER_COUNT 10
 
@@ -20,12 +21,14 @@
  *     1. Вычисляет условие, преобразует к булеву значению.
  *     2. Если условие ложно – выход.
  *     3. Выполняет тело с перехватом Break и Continue.
- *   Преобразование условия аналогично NodeDoWhile.
+ *   Преобразование условия аналогично NodeDoWhile; горячее условие Bool или
+ *   Int проверяется через QuickCondition (twist-quicken.cpp).
  */
 
 struct NodeWhile : public Node { NO_EVAL
     Node* condition;
     Node* body;
+    QuickeningState quickening;
 
     Token start;
     Token end;
@@ -42,7 +45,11 @@ struct NodeWhile : public Node { NO_EVAL
         while (true) {
             if (condition) {
                 auto value = condition->eval_from(_memory);
-                if (value.type == STANDART_TYPE::BOOL) {
+                bool truth;
+                if (QuickCondition(quickening, value, truth)) {
+                    if (!truth)
+                        break;
+                } else if (value.type == STANDART_TYPE::BOOL) {
                     if (any_cast<bool>(value.data) == false)
                         break;
                 } else if (value.type == STANDART_TYPE::INT) {
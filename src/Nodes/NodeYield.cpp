@@ -0,0 +1,49 @@
+#include "../twist-nodetemp.cpp"
+#include "../twist-generators.cpp"
+
+#include "../twist-err.cpp"
+
+#pragma once
+
+/*
+ * NodeYield – передача значения из генератора: yield expr;
+ *
+ * Приостанавливает тело генератора до следующего запроса значения (см.
+ * twist-generators.cpp). Значение проверяется по объявленному типу
+ * результата функции.
+ *
+ * Поля:
+ *   expr – передаваемое значение.
+ */
+
+struct NodeYield : public Node { NO_EVAL
+    Node* expr;
+
+    Token start_token;
+    Token end_token;
+
+    NodeYield(Node* expr, Token start_token, Token end_token)
+        : expr(expr), start_token(start_token), end_token(end_token) {
+        this->NODE_TYPE = NodeTypes::NODE_YIELD;
+    }
+
+    void exec_from(Memory* _memory) override {
+        auto value = expr->eval_from(_memory);
+
+        auto generator = GeneratorState::active();
+        if (!generator || generator->context != &RuntimeContext::current())
+            throw ERROR_THROW::YieldOutsideGenerator(start_token, end_token);
+
+        auto func = generator->function;
+        if (func->return_type) {
+            Type evaluated;
+            const Type& expected = func->return_type_cached ?
+                func->cached_return_type :
+                (evaluated = any_cast<Type>(func->return_type->eval_from(DeclarationMemory(func->memory)).data));
+            if (!value.type.is_sub_type(expected))
+                throw ERROR_THROW::InvalidYieldType(start_token, end_token, func->name, expected, value.type);
+        }
+
+        generator->yield(std::move(value));
+    }
+};
@@ -8,14 +8,15 @@
 #ifndef TARGET_RESOLVER_CPP
 #define TARGET_RESOLVER_CPP
 
-pair<Memory*, string> resolveTargetMemory(Node* node, Memory* current_memory) {
+// Память и интернированное имя цели присваивания / удаления / взятия адреса
+pair<Memory*, Symbol> resolveTargetMemory(Node* node, Memory* current_memory) {
     if (node->NODE_TYPE == NodeTypes::NODE_LITERAL) {
         NodeLiteral* lit = static_cast<NodeLiteral*>(node);
 
-        if (!current_memory->check_literal(lit->name))
+        if (!current_memory->check_literal(lit->symbol))
             throw ERROR_THROW::VariableUndefined(lit->token);
         
-        return {current_memory, lit->name};
+        return {current_memory, lit->symbol};
     }
     else if (node->NODE_TYPE == NodeTypes::NODE_OBJECT_RESOLUTION) {
         NodeObjectResolution* resolution = static_cast<NodeObjectResolution*>(node);
@@ -24,7 +25,7 @@ pair<Memory*, string> resolveTargetMemory(Node* node, Memory* current_memory) {
             ERROR::InvalidAccessorType(resolution->start, resolution->end, obj_value.type.pool);
         }
         auto obj = any_cast<Struct*>(obj_value.data);
-        return {obj->memory, resolution->current_name};
+        return {obj->memory, resolution->current_symbol};
     }
     else if (node->NODE_TYPE == NodeTypes::NODE_NAME_RESOLUTION) {
         NodeNamespaceResolution* resolution = static_cast<NodeNamespaceResolution*>(node);
@@ -33,13 +34,13 @@ pair<Memory*, string> resolveTargetMemory(Node* node, Memory* current_memory) {
             ERROR::InvalidAccessorType(resolution->start, resolution->end, ns_value.type.pool);
         }
         auto ns = any_cast<Namespace*>(ns_value.data);
-        if (!ns->memory->check_literal(resolution->name)) 
+        if (!ns->memory->check_literal(resolution->symbol)) 
             throw ERROR_THROW::VariableUndefined(resolution->end);
-        return {ns->memory, resolution->name};
+        return {ns->memory, resolution->symbol};
     }
     else {
         // Неподдерживаемый тип узла
-        return {nullptr, ""}; // заглушка
+        return {nullptr, Symbol()}; // заглушка
     }
 }
 
@@ -9,6 +9,7 @@ struct Arg {
     Node* type_expr = nullptr;
     Node* default_parameter = nullptr;
     string name;
+    Symbol symbol;      // интернированное name для Memory
     
     bool is_const = false;
     bool is_final = false;
@@ -19,7 +20,7 @@ struct Arg {
     bool is_variadic = false;
     Node* variadic_size = nullptr;
 
-    Arg(string name) : name(name) {}
+    Arg(string name) : name(name), symbol(name) {}
 };
 
 
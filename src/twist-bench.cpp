@@ -0,0 +1,205 @@
+#include "twist-utils.cpp"
+#include "twist-output.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#pragma once
+
+/*
+ * Benchmark – режим измерения времени интерпретации (-bench, бывший -mrt).
+ *
+ * Каждая итерация состоит из подготовки (setup) и измеряемого запуска (run).
+ * setup не входит в замер и должен вернуть интерпретатор в исходное
+ * состояние: новая глобальная память, очищенные реестры объектов и адресов.
+ * Первые warmup итераций выполняются, но не учитываются.
+ *
+ * Замеры останавливаются, когда выполнено iterations итераций или исчерпан
+ * бюджет времени time_budget_ms (если задан) – но не раньше MIN_BENCH_SAMPLES.
+ * По выборке считаются min/max/mean/median/p90/p99/stddev, результат
+ * выводится текстом и в JSON для сравнения версий (WriteBenchmarkJson).
+ *
+ * Вывод программы во время итераций подавляется (quiet): в замер входит
+ * форматирование, но не запись в терминал.
+ */
+
+// Минимальное число замеров, даже если бюджет времени исчерпан
+#define MIN_BENCH_SAMPLES 3
+
+struct BenchmarkOptions {
+    int warmup = 3;
+    int iterations = 30;
+    double time_budget_ms = 0;      // 0 – без ограничения по времени
+    bool quiet = true;
+};
+
+struct BenchmarkResult {
+    vector<uint64_t> samples_ns;
+    uint64_t min_ns = 0, max_ns = 0;
+    double mean_ns = 0, stddev_ns = 0;
+    uint64_t median_ns = 0, p90_ns = 0, p99_ns = 0;
+    uint64_t total_ns = 0;
+
+    // Перцентиль по методу ближайшего ранга
+    static uint64_t Percentile(const vector<uint64_t>& sorted, double p) {
+        if (sorted.empty()) return 0;
+        size_t rank = (size_t)ceil(p / 100.0 * sorted.size());
+        if (rank == 0) rank = 1;
+        return sorted[min(rank, sorted.size()) - 1];
+    }
+
+    void compute() {
+        if (samples_ns.empty()) return;
+        vector<uint64_t> sorted = samples_ns;
+        sort(sorted.begin(), sorted.end());
+        min_ns = sorted.front();
+        max_ns = sorted.back();
+        total_ns = 0;
+        for (auto sample : sorted) total_ns += sample;
+        mean_ns = (double)total_ns / sorted.size();
+        double variance = 0;
+        for (auto sample : sorted) variance += (sample - mean_ns) * (sample - mean_ns);
+        stddev_ns = sorted.size() > 1 ? sqrt(variance / (sorted.size() - 1)) : 0;
+        median_ns = sorted.size() % 2 ? sorted[sorted.size() / 2] :
+                    (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2;
+        p90_ns = Percentile(sorted, 90);
+        p99_ns = Percentile(sorted, 99);
+    }
+};
+
+// Подавление std::cout на время жизни объекта
+struct QuietOutput {
+    struct NullBuffer : streambuf {
+        int overflow(int c) override { return c; }
+    };
+    NullBuffer null_buffer;
+    streambuf* saved = nullptr;
+
+    QuietOutput(bool enabled) {
+        if (enabled) saved = cout.rdbuf(&null_buffer);
+    }
+    ~QuietOutput() {
+        if (saved) cout.rdbuf(saved);
+    }
+};
+
+BenchmarkResult RunBenchmark(const BenchmarkOptions& options,
+                             const function<void()>& setup,
+                             const function<void()>& run) {
+    using namespace std::chrono;
+    BenchmarkResult result;
+
+    for (int i = 0; i < options.warmup; i++) {
+        setup();
+        QuietOutput quiet(options.quiet);
+        run();
+        OutputBuffer::flush();
+    }
+
+    auto budget_start = steady_clock::now();
+    for (int i = 0; i < options.iterations; i++) {
+        setup();
+        steady_clock::time_point start, end;
+        {
+            QuietOutput quiet(options.quiet);
+            start = steady_clock::now();
+            run();
+            OutputBuffer::flush();
+            end = steady_clock::now();
+        }
+        result.samples_ns.push_back((uint64_t)duration_cast<nanoseconds>(end - start).count());
+
+        if (options.time_budget_ms > 0 && result.samples_ns.size() >= MIN_BENCH_SAMPLES &&
+            duration_cast<milliseconds>(steady_clock::now() - budget_start).count() >= options.time_budget_ms)
+            break;
+    }
+
+    result.compute();
+    return result;
+}
+
+void PrintBenchmark(const string& name, const BenchmarkOptions& options, const BenchmarkResult& result) {
+    auto line = [](const string& label, uint64_t ns) {
+        cout << MT::INFO << label << TERMINAL_COLORS::GREEN;
+        printDuration(chrono::nanoseconds(ns));
+        cout << TERMINAL_COLORS::RESET << endl;
+    };
+    cout << MT::INFO << "Benchmark " << name << ": " << result.samples_ns.size() << " iterations, "
+         << options.warmup << " warmup" << endl;
+    line("  median: ", result.median_ns);
+    line("  mean:   ", (uint64_t)result.mean_ns);
+    line("  stddev: ", (uint64_t)result.stddev_ns);
+    line("  min:    ", result.min_ns);
+    line("  p90:    ", result.p90_ns);
+    line("  p99:    ", result.p99_ns);
+    line("  max:    ", result.max_ns);
+}
+
+bool WriteBenchmarkJson(const string& path, const string& name,
+                        const BenchmarkOptions& options, const BenchmarkResult& result) {
+    ostringstream json;
+    json << "{\n"
+         << "  \"name\": " << JsonString(name) << ",\n"
+         << "  \"warmup\": " << options.warmup << ",\n"
+         << "  \"iterations\": " << result.samples_ns.size() << ",\n"
+         << "  \"unit\": \"ns\",\n"
+         << "  \"min\": " << result.min_ns << ",\n"
+         << "  \"max\": " << result.max_ns << ",\n"
+         << "  \"mean\": " << (uint64_t)result.mean_ns << ",\n"
+         << "  \"median\": " << result.median_ns << ",\n"
+         << "  \"p90\": " << result.p90_ns << ",\n"
+         << "  \"p99\": " << result.p99_ns << ",\n"
+         << "  \"stddev\": " << (uint64_t)result.stddev_ns << ",\n"
+         << "  \"samples\": [";
+    for (size_t i = 0; i < result.samples_ns.size(); i++)
+        json << (i ? ", " : "") << result.samples_ns[i];
+    json << "]\n}\n";
+
+    if (path == "-") {
+        cout << json.str();
+        return true;
+    }
+    return SaveFile(path, json.str());
+}
+
+/*
+ * PhaseTimes – время этапов одного запуска (-phases): лексер, препроцессор,
+ * парсер, оптимизатор, выполнение. Используется раннером benchmarks/run.py,
+ * чтобы видеть, на каком этапе теряется время.
+ */
+struct PhaseTimes {
+    vector<pair<string, uint64_t>> phases;
+
+    template <typename F>
+    void measure(const string& name, F&& fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        add(name, (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+                      chrono::steady_clock::now() - start).count());
+    }
+
+    void add(const string& name, uint64_t ns) {
+        phases.push_back({name, ns});
+    }
+
+    bool write_json(const string& path) const {
+        ostringstream json;
+        json << "{\n  \"unit\": \"ns\"";
+        for (auto& [name, ns] : phases)
+            json << ",\n  " << JsonString(name) << ": " << ns;
+        json << "\n}\n";
+
+        if (path == "-") {
+            cout << json.str();
+            return true;
+        }
+        return SaveFile(path, json.str());
+    }
+};
@@ -0,0 +1,274 @@
+#include "twist-native.cpp"
+#include "twist-err.cpp"
+#include "twist-output.cpp"
+#include "twist-input.cpp"
+#include "twist-lambda.cpp"
+#include "twist-structs.cpp"
+#include "twist-array.cpp"
+#include "twist-map.cpp"
+#include "twist-namespace.cpp"
+
+#include <cctype>
+#include <cmath>
+#include <string>
+
+#pragma once
+
+/*
+ * Встроенные нативные функции (см. NativeRegistry).
+ *
+ * Конструкторы типов – String(x), Int(x), ptr(a, T), Map(...), Set(...),
+ * [T](m) – сами проверяют число аргументов и выдают свои сообщения об
+ * ошибках. Свободные функции объявляют сигнатуру, её проверяет NodeCall.
+ *
+ * Чтобы добавить функцию, достаточно описать NativeFunction и
+ * зарегистрировать её здесь – NodeCall менять не нужно.
+ */
+
+namespace BUILTINS {
+
+    // ---------- конструкторы типов ----------
+
+    Value String(NativeCall& call, void*) {
+        if (call.args.size() != 1)
+            throw ERROR_THROW::InvalidStringArgumentCount(call.start, call.end, call.args.size());
+
+        string new_string;
+        auto& value = call.args[0];
+        if (value.type == STANDART_TYPE::TYPE)
+            new_string = any_cast<Type&>(value.data).pool;
+        else if (value.type == STANDART_TYPE::STRING)
+            return NewString(any_cast<const RuntimeString&>(value.data));   // общий буфер, без копии
+        else if (value.type == STANDART_TYPE::CHAR)
+            new_string = any_cast<char>(value.data);
+        else if (value.type == STANDART_TYPE::BOOL)
+            new_string = any_cast<bool>(value.data) ? "true" : "false";
+        else if (value.type == STANDART_TYPE::INT)
+            new_string = to_string(any_cast<int64_t>(value.data));
+        else if (value.type == STANDART_TYPE::DOUBLE)
+            new_string = to_string(any_cast<NUMBER_ACCURACY>(value.data));
+        else if (value.type == STANDART_TYPE::NULL_T)
+            new_string = "null";
+        else if (value.type == STANDART_TYPE::NAMESPACE)
+            new_string = "namespace " + any_cast<Namespace>(value.data).name;
+        else if (value.type == STANDART_TYPE::LAMBDA) {
+            new_string = "Lambda(";
+            auto lambda = any_cast<Lambda*>(value.data);
+            for (size_t i = 0; i < lambda->arguments.size(); i++) {
+                new_string = new_string + any_cast<Type>(lambda->arguments[i]->type_expr->eval_from(call.memory).data).pool;
+                if (i != lambda->arguments.size() - 1) new_string = new_string + ", ";
+            }
+            new_string = new_string + ") -> ";
+            new_string = new_string + any_cast<Type>(lambda->return_type->eval_from(call.memory).data).pool;
+        } else if (value.type.is_pointer()) {
+            new_string = value.type.pool + "[0x" + to_string(any_cast<int>(value.data)) + "]";
+        }
+
+        return NewString(new_string);
+    }
+
+    Value Int(NativeCall& call, void*) {
+        if (call.args.size() != 1)
+            throw ERROR_THROW::InvalidIntArgumentCount(call.start, call.end, call.args.size());
+
+        auto& value = call.args[0];
+        if (value.type == STANDART_TYPE::INT)
+            return value;
+        else if (value.type == STANDART_TYPE::DOUBLE)
+            return NewInt(any_cast<NUMBER_ACCURACY>(value.data));
+        else if (value.type == STANDART_TYPE::STRING)
+            return NewInt(stoll(any_cast<const RuntimeString&>(value.data).str()));
+        else if (value.type == STANDART_TYPE::CHAR)
+            return NewInt(stoll(to_string(any_cast<char>(value.data))));
+
+        throw ERROR_THROW::InvalidIntArgumentType(call.start, call.end, value.type);
+    }
+
+    Value Ptr(NativeCall& call, void*) {
+        if (call.args.empty() || call.args.size() > 2)
+            throw ERROR_THROW::InvalidPtrArgumentCount(call.start, call.end, call.args.size());
+
+        auto& value = call.args[0];
+        if (value.type != STANDART_TYPE::INT)
+            throw ERROR_THROW::InvalidPtrFirstArgumentType(call.start, call.end, value.type);
+
+        if (call.args.size() == 1)
+            return NewPointerValue(any_cast<int64_t>(value.data), STANDART_TYPE::NULL_T);
+
+        auto& t = call.args[1];
+        if (t.type == STANDART_TYPE::TYPE)
+            return NewPointerValue(any_cast<int64_t>(value.data), any_cast<Type&>(t.data));
+        if (!t.type.is_sub_type(STANDART_TYPE::TYPES))
+            return NewPointerValue(any_cast<int64_t>(value.data), any_cast<Struct*>(t.data)->type);
+        throw ERROR_THROW::InvalidPtrSecondArgumentType(call.start, call.end, value.type);
+    }
+
+    // Map() / Set() – пустая таблица; Map(m), Set(s) – копия; Set(array), Set(map) – элементы / ключи
+    Value Table(NativeCall& call, void*) {
+        auto& type = any_cast<const Type&>(call.callee.data);
+        if (call.args.size() > 1)
+            throw ERROR_THROW::InvalidTableArgumentCount(call.start, call.end, type.pool, call.args.size());
+        if (call.args.empty())
+            return Value(type, ValueTable());
+
+        auto& value = call.args[0];
+        if (value.type == type)
+            return value;
+        if (type != STANDART_TYPE::SET ||
+            (!value.type.is_array_type() && value.type != STANDART_TYPE::MAP))
+            throw ERROR_THROW::InvalidTableConversion(call.start, call.end, type.pool, value.type);
+
+        ValueTable table;
+        auto add = [&](const Value& element) {
+            TableKey key(element);
+            if (!key.valid())
+                throw ERROR_THROW::MapInvalidKeyType(call.start, call.end, element.type);
+            if (!table.contains(key)) table.set(key, NewNull());
+        };
+        if (value.type.is_array_type()) {
+            for (auto& element : any_cast<const Array&>(value.data).values)
+                add(element);
+        } else {
+            any_cast<const ValueTable&>(value.data).for_each([&](const ValueTable::Entry& entry) { add(entry.key); });
+        }
+        return Value(STANDART_TYPE::SET, std::move(table));
+    }
+
+    // [T](m) – ключи Map / элементы Set в порядке вставки
+    Value ArrayOf(NativeCall& call, void*) {
+        auto& type = any_cast<const Type&>(call.callee.data);
+        if (call.args.size() != 1)
+            throw ERROR_THROW::InvalidTableArgumentCount(call.start, call.end, type.pool, call.args.size());
+        auto& value = call.args[0];
+        if (value.type != STANDART_TYPE::MAP && value.type != STANDART_TYPE::SET)
+            throw ERROR_THROW::InvalidTableConversion(call.start, call.end, type.pool, value.type);
+
+        Type elem_type(type.parse_array_type().first);
+        bool check = !elem_type.pool.empty();
+        vector<Value> elements;
+        elements.reserve(any_cast<const ValueTable&>(value.data).size());
+        any_cast<const ValueTable&>(value.data).for_each([&](const ValueTable::Entry& entry) {
+            if (check && !IsTypeCompatible(elem_type, entry.key.type))
+                throw ERROR_THROW::ArrayInvalidElementType(call.start, call.end, elem_type, entry.key.type, elements.size());
+            elements.push_back(entry.key);
+        });
+        Type T = Type("[" + elem_type.pool + ", ~]");
+        return Value(T, Array(T, std::move(elements)));
+    }
+
+    // ---------- математика ----------
+
+    NUMBER_ACCURACY Number(const Value& value) {
+        if (value.type == STANDART_TYPE::INT)
+            return (NUMBER_ACCURACY)any_cast<int64_t>(value.data);
+        return any_cast<NUMBER_ACCURACY>(value.data);
+    }
+
+    Value Sqrt(NativeCall& call, void*) {
+        auto x = Number(call.args[0]);
+        if (x < 0)
+            throw std::domain_error("square root of a negative number");
+        return NewDouble(std::sqrt(x));
+    }
+
+    Value Pow(NativeCall& call, void*) {
+        return NewDouble(std::pow(Number(call.args[0]), Number(call.args[1])));
+    }
+
+    Value Abs(NativeCall& call, void*) {
+        auto& x = call.args[0];
+        if (x.type == STANDART_TYPE::INT)
+            return NewInt(std::llabs(any_cast<int64_t>(x.data)));
+        return NewDouble(std::fabs(any_cast<NUMBER_ACCURACY>(x.data)));
+    }
+
+    Value Floor(NativeCall& call, void*) {
+        return NewInt((int64_t)std::floor(Number(call.args[0])));
+    }
+
+    Value Ceil(NativeCall& call, void*) {
+        return NewInt((int64_t)std::ceil(Number(call.args[0])));
+    }
+
+    // ---------- строки ----------
+
+    Value Upper(NativeCall& call, void*) {
+        string s = any_cast<const RuntimeString&>(call.args[0].data).str();
+        for (auto& c : s) c = (char)toupper((unsigned char)c);
+        return NewString(s);
+    }
+
+    Value Lower(NativeCall& call, void*) {
+        string s = any_cast<const RuntimeString&>(call.args[0].data).str();
+        for (auto& c : s) c = (char)tolower((unsigned char)c);
+        return NewString(s);
+    }
+
+    // ---------- ввод-вывод ----------
+
+    Value Flush(NativeCall&, void*) {
+        OutputBuffer::flush();
+        return NewNull();
+    }
+
+    // input_lines(n) – до n строк stdin, input_lines() – все оставшиеся;
+    // [String, ~], в конце ввода массив короче (пустые строки сохраняются)
+    Value InputLines(NativeCall& call, void*) {
+        if (call.args.size() > 1)
+            throw ERROR_THROW::InvalidNativeArgumentCount(call.start, call.end, "input_lines", 1, call.args.size());
+        int64_t limit = -1;
+        if (!call.args.empty()) {
+            auto& count = call.args[0];
+            if (count.type != STANDART_TYPE::INT)
+                throw ERROR_THROW::InputInvalidBatchSize(call.start, call.end, count.type);
+            limit = max<int64_t>(any_cast<int64_t>(count.data), 0);
+        }
+
+        vector<Value> lines;
+        #ifndef SERVER
+            if (RuntimeContext::current().task)
+                throw ERROR_THROW::ParallelInput(call.start, call.end);
+            if (limit > 0) lines.reserve((size_t)min<int64_t>(limit, 4096));
+            string_view line;
+            while ((limit < 0 || (int64_t)lines.size() < limit) && InputBuffer::next_line(line))
+                lines.push_back(NewString(RuntimeString(line)));
+        #endif
+
+        Type T = Type("[" + STANDART_TYPE::STRING.pool + ", ~]");
+        return Value(T, Array(T, std::move(lines)));
+    }
+
+    const Type NUMBER = STANDART_TYPE::INT | STANDART_TYPE::DOUBLE;
+
+    NativeFunction STRING_CONSTRUCTOR { "String", -1, {}, String };
+    NativeFunction INT_CONSTRUCTOR    { "Int",    -1, {}, Int };
+    NativeFunction PTR_CONSTRUCTOR    { "ptr",    -1, {}, Ptr };
+    NativeFunction MAP_CONSTRUCTOR    { "Map",    -1, {}, Table };
+    NativeFunction SET_CONSTRUCTOR    { "Set",    -1, {}, Table };
+    NativeFunction ARRAY_CONSTRUCTOR  { "Array",  -1, {}, ArrayOf };
+
+    NativeFunction SQRT  { "sqrt",  1, { NUMBER },         Sqrt,  nullptr, true };
+    NativeFunction POW   { "pow",   2, { NUMBER, NUMBER }, Pow,   nullptr, true };
+    NativeFunction ABS   { "abs",   1, { NUMBER },         Abs,   nullptr, true };
+    NativeFunction FLOOR { "floor", 1, { NUMBER },         Floor, nullptr, true };
+    NativeFunction CEIL  { "ceil",  1, { NUMBER },         Ceil,  nullptr, true };
+    NativeFunction UPPER { "upper", 1, { STANDART_TYPE::STRING }, Upper, nullptr, true };
+    NativeFunction LOWER { "lower", 1, { STANDART_TYPE::STRING }, Lower, nullptr, true };
+    NativeFunction FLUSH { "flush", 0, {},                 Flush };
+    NativeFunction INPUT_LINES { "input_lines", -1, {},    InputLines };
+
+    bool Register() {
+        NativeRegistry::define_constructor("String", &STRING_CONSTRUCTOR);
+        NativeRegistry::define_constructor("Int", &INT_CONSTRUCTOR);
+        NativeRegistry::define_constructor("ptr", &PTR_CONSTRUCTOR);
+        NativeRegistry::define_constructor("Map", &MAP_CONSTRUCTOR);
+        NativeRegistry::define_constructor("Set", &SET_CONSTRUCTOR);
+        NativeRegistry::array_constructor() = &ARRAY_CONSTRUCTOR;
+
+        for (auto native : { &SQRT, &POW, &ABS, &FLOOR, &CEIL, &UPPER, &LOWER, &FLUSH, &INPUT_LINES })
+            NativeRegistry::define(native);
+        return true;
+    }
+
+    const bool REGISTERED = Register();
+}
@@ -0,0 +1,135 @@
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#pragma once
+
+/*
+ * RuntimeContext – состояние одного запуска программы Lumen.
+ *
+ * Всё, что раньше было глобальным для процесса, хранится здесь:
+ *   - objects / next_address – реестр объектов по адресу (GlobalMemory)
+ *                              и счётчик адресов (AddressManager);
+ *   - recursion_depth, active_function_frames – глубина вызовов;
+ *   - memoized_functions – функции с memo-кэшем (--memo-stats);
+ *   - source       – текст программы для вывода строк в ошибках;
+ *   - error_buffer – журнал ошибок языкового сервера (Error::Write);
+ *   - output, input – буферы вывода и ввода программы;
+ *   - diagnostics  – поток для сообщений об ошибках (nullptr – std::cout);
+ *   - parent, task – контекст части parallel for / pmap (см. twist-parallel.cpp)
+ *                    или задачи spawn (twist-tasks.cpp): внешний контекст и
+ *                    номер задачи, 0 – не задача. Адреса часть берёт блоками
+ *                    из address_source;
+ *   - reads_parent – объекты parent видны задаче (parent ждёт её завершения);
+ *   - memories     – снимок памяти объявлений задачи spawn (DeclarationMemory);
+ *   - tasks        – задачи spawn запуска, хранятся в корневом контексте.
+ *
+ * Контекст привязывается к потоку (Scope). Код интерпретатора обращается к
+ * состоянию через current(): привязанный к потоку контекст или, если его нет,
+ * общий контекст процесса – так работает обычный запуск lumenc. Поэтому в
+ * одном процессе может параллельно выполняться несколько программ, каждая в
+ * своём потоке и со своим контекстом (см. Interpreter).
+ *
+ * Узлы AST и Memory принадлежат одной программе; общие между контекстами
+ * только неизменяемые данные (типы STANDART_TYPE) и таблица имён SymbolTable.
+ */
+
+struct MemoryObject;
+struct Function;
+struct Memory;
+struct TaskState;
+
+// Состояние OutputBuffer
+struct OutputState {
+    std::vector<char> data;         // выделяется при первом выводе
+    size_t size = 0;
+    int fd = -1;
+    bool line_buffered = false;
+    std::string* capture = nullptr; // не nullptr – вывод дописывается в строку
+};
+
+// Состояние InputBuffer
+struct InputState {
+    std::vector<char> data;         // выделяется при первом чтении
+    size_t begin = 0, end = 0;
+    bool eof = false;
+    std::string carry;
+    const std::string* source = nullptr;    // не nullptr – ввод из строки, а не из stdin
+    size_t source_offset = 0;
+};
+
+struct RuntimeContext {
+    std::unordered_map<int, MemoryObject*> objects;
+    int next_address = 0;
+
+    int recursion_depth = 0;
+    int active_function_frames = 0;
+    std::vector<Function*> memoized_functions;
+
+    std::string source;
+    std::string error_buffer;
+
+    OutputState output;
+    InputState input;
+    std::ostream* diagnostics = nullptr;
+
+    RuntimeContext* parent = nullptr;
+    uint32_t task = 0;
+    bool reads_parent = false;
+    int address_limit = INT_MAX;
+    std::atomic<int>* address_source = nullptr;
+    const std::unordered_map<Memory*, Memory*>* memories = nullptr;
+
+    std::mutex task_lock;
+    std::vector<std::shared_ptr<TaskState>> tasks;
+
+    // Контекст, привязанный к текущему потоку (nullptr – не привязан)
+    static RuntimeContext*& bound() {
+        static thread_local RuntimeContext* context = nullptr;
+        return context;
+    }
+
+    // Общий контекст процесса – для запуска без Interpreter
+    static RuntimeContext& process_default() {
+        static RuntimeContext context;
+        return context;
+    }
+
+    static RuntimeContext& current() {
+        auto context = bound();
+        return context ? *context : process_default();
+    }
+
+    // Привязка контекста к потоку на время жизни объекта
+    struct Scope {
+        RuntimeContext* previous;
+
+        explicit Scope(RuntimeContext* context) : previous(bound()) { bound() = context; }
+        ~Scope() { bound() = previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+// Текст программы текущего запуска (для вывода строки с ошибкой)
+inline const std::string& CurrentSource() {
+    auto context = &RuntimeContext::current();
+    while (context->parent) context = context->parent;
+    return context->source;
+}
+
+// Завершение программы (exit, фатальная ошибка), см. ExitProgram и
+// ExitOnError в twist-output.cpp
+struct ProgramExit {
+    int code;
+    bool fatal;     // завершение из-за ошибки (ERROR::)
+};
@@ -2,6 +2,8 @@
 #include "twist-tokens.cpp"
 #include "twist-utils.cpp"
 #include "twist-values.cpp"
+#include "twist-output.cpp"
+#include "twist-context.cpp"
 #include <string>
 #include "sstream"
 
@@ -21,7 +23,6 @@ typedef string ErrorType;
 
 
 struct Error {
-    static std::string error_buffer;
     string message;
     PosInFile pif;
     ErrorType type;
@@ -37,6 +38,7 @@ struct Error {
         this->pif = pif;
         this->type = type;
         this->code = code;
+        STAT_INC(throws_error);
     }
 
     static std::string escape_message(const std::string& msg) {
@@ -70,16 +72,18 @@ struct Error {
         return oss.str();
     }
 
+    // Журнал ошибок – в контексте текущего запуска
     void Write() const {
-        error_buffer += ToString();
-        error_buffer += "\n";
+        auto& buffer = RuntimeContext::current().error_buffer;
+        buffer += ToString();
+        buffer += "\n";
     }
 
     static void ClearBuffer() {
-        error_buffer.clear();
+        RuntimeContext::current().error_buffer.clear();
     }
     static const std::string& GetBuffer() {
-        return error_buffer;
+        return RuntimeContext::current().error_buffer;
     }
 
 
@@ -97,12 +101,16 @@ struct Error {
         this->pif = new_pif;
         this->type = type;
         this->code = code;
+        STAT_INC(throws_error);
     }
 
     void print() {
+        // Сообщение об ошибке – после уже выведенного программой текста
+        OutputBuffer::flush();
         if (sub_error)
             sub_error->print();
 
+        auto& out = DiagnosticStream();
         auto color = TM::RED;
         auto err = MT::ERROR;
         if (message_type == 1) {
@@ -110,38 +118,36 @@ struct Error {
             err = MT::WARNING;
         }
 
-        cout << color << ".- " << TM::RESET << err << ">> " << this->type << " >> " << pif << endl;
+        out << color << ".- " << TM::RESET << err << ">> " << this->type << " >> " << pif << endl;
         vector<string> lines = SplitString(this->code, '\n');
-        cout << color << "|" << TM::RESET << endl;
-        cout << color << "| " << TM::CYAN << pif.line << " | " << TM::RESET << lines[pif.global_line - 1] << endl;
-        cout << color << "| " << string(to_string(pif.line).length() + 3, ' ') << string(pif.index, ' ') << color << string(pif.lenght, '^') << " " << this->message << endl;
-        cout << color << "`" << string(to_string(pif.line).length() + 4, '-') << string(pif.index, '-') << "'" << TM::RESET << endl;
-        cout << endl;
+        out << color << "|" << TM::RESET << endl;
+        out << color << "| " << TM::CYAN << pif.line << " | " << TM::RESET << lines[pif.global_line - 1] << endl;
+        out << color << "| " << string(to_string(pif.line).length() + 3, ' ') << string(pif.index, ' ') << color << string(pif.lenght, '^') << " " << this->message << endl;
+        out << color << "`" << string(to_string(pif.line).length() + 4, '-') << string(pif.index, '-') << "'" << TM::RESET << endl;
+        out << endl;
     }
 };
 
-std::string Error::error_buffer = "";
 namespace ERROR_THROW {
-    static string PREPROCESSOR_OUTPUT;
 
     // PREPROCESSOR ERRORS
     Error PreprocessorWaitedEqual(const Token& pos) {
-        Error err = Error("Waited '='", pos.pif, ErrorTypes::PREPROCESS_ERROR, PREPROCESSOR_OUTPUT);
+        Error err = Error("Waited '='", pos.pif, ErrorTypes::PREPROCESS_ERROR, CurrentSource());
         return err;
     }
 
     Error PreprocessorMaxIterations(const Token& pos) {
-        Error err = Error("Waited ';' but you use max iterations", pos.pif, ErrorTypes::PREPROCESS_ERROR, PREPROCESSOR_OUTPUT);
+        Error err = Error("Waited ';' but you use max iterations", pos.pif, ErrorTypes::PREPROCESS_ERROR, CurrentSource());
         return err;
     }
 
     Error PreprocessorWaitFilePath(const Token& pos) {
-        Error err = Error("Waited \"file path\"", pos.pif, ErrorTypes::PREPROCESS_ERROR, PREPROCESSOR_OUTPUT);
+        Error err = Error("Waited \"file path\"", pos.pif, ErrorTypes::PREPROCESS_ERROR, CurrentSource());
         return err;
     }
 
     Error PreprocessorWaitLiteral(const Token& pos) {
-        Error err = Error("Waited literal", pos.pif, ErrorTypes::PREPROCESS_ERROR, PREPROCESSOR_OUTPUT);
+        Error err = Error("Waited literal", pos.pif, ErrorTypes::PREPROCESS_ERROR, CurrentSource());
         return err;
     }
 
@@ -150,7 +156,7 @@ namespace ERROR_THROW {
         err.pif = token.pif;
         err.message = "Expected " + expected + ", but found '" + token.value + "'";
         err.type = ErrorTypes::SYNTAX;
-        err.code = PREPROCESSOR_OUTPUT;
+        err.code = CurrentSource();
         return err;
     }
 
@@ -159,7 +165,7 @@ namespace ERROR_THROW {
         err.pif = token.pif;
         err.message = "Expected declaration statement [let, func, struct, namespace], but found '" + token.value + "'";
         err.type = ErrorTypes::SEMANTIC;
-        err.code = PREPROCESSOR_OUTPUT;
+        err.code = CurrentSource();
         return err;
     }
 
@@ -168,16 +174,16 @@ namespace ERROR_THROW {
         err.pif = token.pif;
         err.message = "Expected expression, but found '" + token.value + "'";
         err.type = ErrorTypes::SEMANTIC;
-        err.code = PREPROCESSOR_OUTPUT;
+        err.code = CurrentSource();
         return err;
     }
 
     Error CallError(const Token& start, const Token& stop, string name, Error* sub_error, int is_warning = 0, string message = "") {
         Error err;
         if (is_warning) {
-            err = Error(message, start.pif, stop.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+            err = Error(message, start.pif, stop.pif, ErrorTypes::EXECUTION, CurrentSource());
         } else {
-            err = Error("Call error in function '" + name + "'", start.pif, stop.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+            err = Error("Call error in function '" + name + "'", start.pif, stop.pif, ErrorTypes::EXECUTION, CurrentSource());
         }
 
         err.sub_error = sub_error;
@@ -188,9 +194,9 @@ namespace ERROR_THROW {
     Error CallError(const Token& start, const Token& stop, string name, int is_warning = 0, string message = "") {
         Error err;
         if (is_warning) {
-            err = Error(message, start.pif, stop.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+            err = Error(message, start.pif, stop.pif, ErrorTypes::EXECUTION, CurrentSource());
         } else {
-            err = Error("Call error in function '" + name + "'", start.pif, stop.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+            err = Error("Call error in function '" + name + "'", start.pif, stop.pif, ErrorTypes::EXECUTION, CurrentSource());
         }
 
         err.message_type = is_warning;
@@ -198,320 +204,439 @@ namespace ERROR_THROW {
     }
 
     Error UncallableType(const Token& start, const Token& stop, Type type) {
-        Error err = Error("Uncallable type `" + type.pool + "`", start.pif, stop.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Uncallable type `" + type.pool + "`", start.pif, stop.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error IncompartableInputType(const Token& start, const Token& end, Type found_type) {
-        Error err = Error("Input instruction wait `String` or `Char` type but found `" + found_type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Input instruction wait `String` or `Char` type but found `" + found_type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+        return err;
+    }
+
+    Error InputInvalidBatchSize(const Token& start, const Token& end, Type found_type) {
+        Error err = Error("Input batch size must be `Int` but found `" + found_type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error AssertionInvalidArgument(const Token& start, const Token& end) {
-        Error err = Error("Invalid assertion argument, waited `Bool` type", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid assertion argument, waited `Bool` type", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidNodeType(const Token& start, string wait_node, string node) {
-        Error err = Error("Waited " + wait_node + ", but found " + node, start.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Waited " + wait_node + ", but found " + node, start.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error AssertionInvalidMessage(const Token& start, const Token& end) {
-        Error err = Error("Invalid assertion message, waited `String` type, or `Char` type", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid assertion message, waited `String` type, or `Char` type", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error AssertionFailed(const Token& start, const Token& end) {
-        Error err = Error("Assertion failed", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Assertion failed", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         err.message_type = 1;
         return err;
     }
 
     Error InputWarning(const Token& start, const Token& end) {
-        Error err = Error("Input is run time instruction. Default return - null", start.pif, end.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error("Input is run time instruction. Default return - null", start.pif, end.pif, ErrorTypes::SEMANTIC, CurrentSource());
         err.message_type = 1;
         return err;
     }
 
     Error InfinityLoopWarning(const Token& start, const Token& end) {
-        Error err = Error("Infinity loop", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Infinity loop", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         err.message_type = 1;
         return err;
     }
 
     Error UnusedLoopWarning(const Token& start, const Token& end) {
-        Error err = Error("Unused loop", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Unused loop", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         err.message_type = 1;
         return err;
     }
 
     Error ExitWarning(const Token& start, const Token& end, int code) {
-        Error err = Error("Program exited with code " + to_string(code), start.pif, end.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error("Program exited with code " + to_string(code), start.pif, end.pif, ErrorTypes::SEMANTIC, CurrentSource());
         err.message_type = 1;
         return err;
     }
 
     Error Echo(const Token& start, const Token& end, string value) {
-        Error err = Error(value, start.pif, end.pif, ErrorTypes::ECHO, PREPROCESSOR_OUTPUT);
+        Error err = Error(value, start.pif, end.pif, ErrorTypes::ECHO, CurrentSource());
         err.message_type = 2;
         return err;
     }
 
     Error AssertionFailed(const Token& start, const Token& end, string message) {
-        Error err = Error("Assertion failed: " + message, start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Assertion failed: " + message, start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         err.message_type = 1;
         return err;
     }
 
     Error ExitInvalidCode(const Token& start, const Token& end, Type type) {
-        Error err = Error("Invalid exit code, waited `Int` type, but found `" + type.pool + "` type", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid exit code, waited `Int` type, but found `" + type.pool + "` type", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableAlreadyDefined(const Token& token) {
-        Error err = Error("Variable '" + token.value + "' already defined (as final)", token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Variable '" + token.value + "' already defined (as final)", token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableAlreadyDefined(const Token& token, const string name) {
-        Error err = Error("Variable '" + name + "' already defined (as final)", token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Variable '" + name + "' already defined (as final)", token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableUndefined(const Token& token) {
-        Error err = Error("Undefined variable '" + token.value + "'", token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Undefined variable '" + token.value + "'", token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableUndefined(const Token& start, const Token& end, string name) {
-        Error err = Error("Undefined variable '" + name + "'", start.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Undefined variable '" + name + "'", start.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
 
     Error VariableConstRedefinition(const Token& start, const Token& end, string name) {
-        Error err = Error("Cannot assign to const variable '" + name + "'", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Cannot assign to const variable '" + name + "'", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error PointerToConstRedefinition(const Token& start, const Token& end) {
-        Error err = Error("The pointer points to a constant object", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("The pointer points to a constant object", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableStaticTypesMisMatch(const Token& start, const Token& end, Type wait_type, Type found_type) {
-        Error err = Error("Incompatible type `" + found_type.pool + "` (expected `" + wait_type.pool + "`)", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Incompatible type `" + found_type.pool + "` (expected `" + wait_type.pool + "`)", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error NamespaceInvalidAccessorType(const Token& start, const Token& end, Type type) {
-        Error err = Error("Cannot use '::' accessor on type `" + type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Cannot use '::' accessor on type `" + type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableDeclarationInvalidType(const Token& start, const Token& end, Type type) {
-        Error err = Error("Invalid variable static declaration type `" + type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid variable static declaration type `" + type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error VariableStaticIncompatibleType(const Token& start, const Token& end, Type wait_type, Type found_type) {
-        Error err = Error("Incompatible type `" + found_type.pool + "` (expected `" + wait_type.pool + "`)", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Incompatible type `" + found_type.pool + "` (expected `" + wait_type.pool + "`)", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error NamespaceUndefinedVariable(const Token& start, const Token& end, string name) {
-        Error err = Error("Undefined variable '" + name + "'", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Undefined variable '" + name + "'", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error PrivateVariableAccess(const Token& start, const Token& end, string name) {
-        Error err = Error("Variable '" + name + "' is private", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Variable '" + name + "' is private", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error UnsupportedUnaryOperator(const Token& operator_token, const Token& start, const Token& end, const Type& type) {
-        Error err = Error("Unsupported unary operator '" + operator_token.value + "' for `" + type.pool + "` type", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Unsupported unary operator '" + operator_token.value + "' for `" + type.pool + "` type", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error UnsupportedBinaryOperator(const Token& start_token, const Token& end_token, const Token& op_token, const Type& left_type, const Type& right_type) {
-        Error err = Error("Unsupported binary operator '" + op_token.value + "' for `" + left_type.pool + "` and `" + right_type.pool + "` types", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Unsupported binary operator '" + op_token.value + "' for `" + left_type.pool + "` and `" + right_type.pool + "` types", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error WaitedLambdaArgumentTypeSpecifier(const Token& start_token, const Token& end_token, string name) {
-        Error err = Error("Invalid type specifier for argument '" + name + "'", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid type specifier for argument '" + name + "'", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error WaitedLambdaReturnTypeSpecifier(const Token& start_token, const Token& end_token, Type type) {
-        Error err = Error("Invalid type specifier `" + type.pool + "`, but waited valid type", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid type specifier `" + type.pool + "`, but waited valid type", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error WaitedLambdaReturnType(const Token& start_token, const Token& end_token) {
-        Error err = Error("Waited return type", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Waited return type", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidLambdaArgumentCount(const Token& start_callable, const Token& end_callable, const Token& start_args, const Token& end_args, size_t expected, size_t found) {
-        Error err = Error("Invalid argument count for lambda, expected " + to_string(expected) + " but found " + to_string(found), start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Expected " + to_string(expected) + " arguments but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid argument count for lambda, expected " + to_string(expected) + " but found " + to_string(found), start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, CurrentSource());
+        err.sub_error = new Error("Expected " + to_string(expected) + " arguments but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidLambdaArgumentType(const Token& start_callable, const Token& end_callable, const Token& start_args, const Token& end_args, Type expected, Type found, string arg_name) {
-        Error err = Error("Invalid type for argument '" + arg_name + "' in lambda, expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Expected type `" + expected.pool + "` but found `" + found.pool + "` for argument '" + arg_name + "'", start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid type for argument '" + arg_name + "' in lambda, expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, CurrentSource());
+        err.sub_error = new Error("Expected type `" + expected.pool + "` but found `" + found.pool + "` for argument '" + arg_name + "'", start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidLambdaReturnType(const Token& start_callable, const Token& end_callable, const Token& start_return_type, const Token& end_return_type, Type expected, Type found) {
-        Error err = Error("Invalid return type for lambda, expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Expected return type `" + expected.pool + "`", start_return_type.pif, end_return_type.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid return type for lambda, expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, CurrentSource());
+        err.sub_error = new Error("Expected return type `" + expected.pool + "`", start_return_type.pif, end_return_type.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error WaitedFuncArgumentTypeSpecifier(const Token& start_token, const Token& end_token, string name) {
-        Error err = Error("Invalid type specifier for argument '" + name + "'", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid type specifier for argument '" + name + "'", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error WaitedFuncReturnTypeSpecifier(const Token& start_token, const Token& end_token, Type type) {
-        Error err = Error("Invalid type specifier `" + type.pool + "`, but waited valid type", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid type specifier `" + type.pool + "`, but waited valid type", start_token.pif, end_token.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidFuncReturnType(const Token& start_callable, const Token& end_callable, const Token& start_return_type, const Token& end_return_type, Type expected, Type found) {
-        Error err = Error("Invalid return type for lambda, expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Expected return type `" + expected.pool + "`", start_return_type.pif, end_return_type.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid return type for lambda, expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, CurrentSource());
+        err.sub_error = new Error("Expected return type `" + expected.pool + "`", start_return_type.pif, end_return_type.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidFuncArgumentCount(const Token& start_callable, const Token& end_callable, const Token& start_args, const Token& end_args, string func_name, size_t expected, size_t found) {
-        Error err = Error("Invalid argument count for '" + func_name + "', expected " + to_string(expected) + " but found " + to_string(found), start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Expected " + to_string(expected) + " arguments but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid argument count for '" + func_name + "', expected " + to_string(expected) + " but found " + to_string(found), start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, CurrentSource());
+        err.sub_error = new Error("Expected " + to_string(expected) + " arguments but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidFuncArgumentType(const Token& start_callable, const Token& end_callable, const Token& start_args, const Token& end_args, Type expected, Type found, string arg_name, string func_name) {
-        Error err = Error("Invalid type for argument '" + arg_name + "' in function '" + func_name +"', expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Expected type `" + expected.pool + "` but found `" + found.pool + "` for argument '" + arg_name + "'", start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Invalid type for argument '" + arg_name + "' in function '" + func_name +"', expected `" + expected.pool + "` but found `" + found.pool + "`", start_callable.pif, end_callable.pif, ErrorTypes::EXECUTION, CurrentSource());
+        err.sub_error = new Error("Expected type `" + expected.pool + "` but found `" + found.pool + "` for argument '" + arg_name + "'", start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidFuncVariadicSizeExpression(const Token& start, const Token& end, const Type actual_type) {
-        return Error("Variadic size must be of type `Int`, got `" + actual_type.pool + "`", start.pif, end.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        return Error("Variadic size must be of type `Int`, got `" + actual_type.pool + "`", start.pif, end.pif, ErrorTypes::SEMANTIC, CurrentSource());
     }
 
     Error InvalidFuncVariadicSize(const Token& start, const Token& end, const int n) {
-        return Error("Variadic size must be positive number, got " + to_string(n), start.pif, end.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        return Error("Variadic size must be positive number, got " + to_string(n), start.pif, end.pif, ErrorTypes::SEMANTIC, CurrentSource());
     }
 
     Error InvalidFuncVariadicArgType(const Token& start, const Token& end, const Type expected, const Type got, string name){
-        return Error("Variadic argument '" + name + "' expected type `" + expected.pool + "`, but got `" + got.pool + "`", start.pif, end.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        return Error("Variadic argument '" + name + "' expected type `" + expected.pool + "`, but got `" + got.pool + "`", start.pif, end.pif, ErrorTypes::SEMANTIC, CurrentSource());
     }
 
     Error FuncArgumentMissing(const Token& start_callable, const Token& end_callable, const Token& start_args, const Token& end_args, const string& arg_name, int arg_index) {
-        Error err = Error("Missing argument at position " + to_string(arg_index + 1) + " with no default value", start_callable.pif, end_callable.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
-        err.sub_error = new Error("Argument '" + arg_name + "' declared here", start_args.pif, end_args.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error("Missing argument at position " + to_string(arg_index + 1) + " with no default value", start_callable.pif, end_callable.pif, ErrorTypes::SEMANTIC, CurrentSource());
+        err.sub_error = new Error("Argument '" + arg_name + "' declared here", start_args.pif, end_args.pif, ErrorTypes::SEMANTIC, CurrentSource());
         return err;
     }
 
     Error FuncArgumentShadowsGlobal(const Token& call_start, const Token& call_end, const string& func_name, const string& arg_name) {
-        Error err = Error("Argument '" + arg_name + "' in call to function '" + func_name + "' shadows a global variable with the same name", call_start.pif, call_end.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error("Argument '" + arg_name + "' in call to function '" + func_name + "' shadows a global variable with the same name", call_start.pif, call_end.pif, ErrorTypes::SEMANTIC, CurrentSource());
         return err;
     }
 
     Error VariableShadowsGlobal(const Token& call_start, const string& arg_name) {
-        Error err = Error("Variable '" + arg_name + "' shadows a global variable with the same name", call_start.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error("Variable '" + arg_name + "' shadows a global variable with the same name", call_start.pif, ErrorTypes::SEMANTIC, CurrentSource());
         return err;
     }
 
     Error MaxRecursionDepthExceeded(const Token& start, const Token& end) {
-        Error err = Error("Maximum recursion depth exceeded", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Maximum recursion depth exceeded", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+        return err;
+    }
+
+    Error NativeStackExhausted(const Token& start, const Token& end) {
+        Error err = Error("Maximum recursion depth exceeded: native stack exhausted", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+        return err;
+    }
+
+    Error MemoImpureFunction(const Token& start, const Token& end, const string& name, const string& reason) {
+        Error err = Error("Function '" + name + "' cannot be memoized: " + reason, start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidObjectAccessorType(const Token& start, const Token& end, Type type) {
-        Error err = Error("Cannot access members of type `" + type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("Cannot access members of type `" + type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidNumber(const Token& token) {
-        Error err = Error(" Invalid number format: '" + token.value + "'", token.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error(" Invalid number format: '" + token.value + "'", token.pif, ErrorTypes::SEMANTIC, CurrentSource());
         return err;
     }
 
     Error WaitedAddresGettebleExpr(const Token& token) {
-        Error err = Error(" Exprected addres (&) getteble expression", token.pif, ErrorTypes::SEMANTIC, PREPROCESSOR_OUTPUT);
+        Error err = Error(" Exprected addres (&) getteble expression", token.pif, ErrorTypes::SEMANTIC, CurrentSource());
         return err;
     }
 
     Error CanNotGetAddress(const Token& start, const Token& end, NodeTypes node) {
-        Error err = Error(" It is not possible to get an address from this node type: " + string(get_node_type_name(node)), start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error(" It is not possible to get an address from this node type: " + string(get_node_type_name(node)), start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error UndereferencableValue(const Token& start, const Token& end, Type type) {
-        Error err = Error(" Invalid dereference value, waited pointer type but found `" + type.pool + "` type", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error(" Invalid dereference value, waited pointer type but found `" + type.pool + "` type", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidNewModifier(const Token& start) {
-        Error err = Error(" Unsupport modifier", start.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error(" Unsupport modifier", start.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidNewInstruction(const Token& start, const Token& end) {
-        Error err = Error(" Invalid new instruction", start.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error(" Invalid new instruction", start.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidStringArgumentCount(const Token& start_args, const Token& end_args, size_t found) {
-        Error err = Error("'String' expected 1 argument, but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("'String' expected 1 argument, but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidPtrArgumentCount(const Token& start_args, const Token& end_args, size_t found) {
-        Error err = Error("'ptr' expected 1 argument[`Int`] or two arguments[`Int`, `Type`], but found " + to_string(found) + " arguments", start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("'ptr' expected 1 argument[`Int`] or two arguments[`Int`, `Type`], but found " + to_string(found) + " arguments", start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidPtrFirstArgumentType(const Token& start_args, const Token& end_args, Type type) {
-        Error err = Error("'ptr' expected first argument `Int`, but found " + type.pool, start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("'ptr' expected first argument `Int`, but found " + type.pool, start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidPtrSecondArgumentType(const Token& start_args, const Token& end_args, Type type) {
-        Error err = Error("'ptr' expected second argument `Type`, but found " + type.pool, start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("'ptr' expected second argument `Type`, but found " + type.pool, start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidIntArgumentType(const Token& start_args, const Token& end_args, Type type) {
-        Error err = Error("'Int' expected one of arguments `Int`, `Double`, `String`, `Char`, but found " + type.pool, start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("'Int' expected one of arguments `Int`, `Double`, `String`, `Char`, but found " + type.pool, start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error InvalidIntArgumentCount(const Token& start_args, const Token& end_args, size_t found) {
-        Error err = Error("'Int' expected 1 argument, but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        Error err = Error("'Int' expected 1 argument, but found " + to_string(found), start_args.pif, end_args.pif, ErrorTypes::EXECUTION, CurrentSource());
         return err;
     }
 
     Error ArrayIndexOutOfRange(const Token& index_start, const Token& index_end, int64_t index, int64_t size) {
-        return Error(" Index " + to_string(index) + " is out of bounds for array of size " + to_string(size), index_start.pif, index_end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        return Error(" Index " + to_string(index) + " is out of bounds for array of size " + to_string(size), index_start.pif, index_end.pif, ErrorTypes::EXECUTION, CurrentSource());
     }
 
     Error ArrayInvalidIndexType(const Token& index_start, const Token& index_end, const Type& actual_type) {
-        return Error("Array index must be of type `Int`, got `" + actual_type.pool + "`", index_start.pif, index_end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        return Error("Array index must be of type `Int`, got `" + actual_type.pool + "`", index_start.pif, index_end.pif, ErrorTypes::EXECUTION, CurrentSource());
     }
 
     Error ArrayInvalidElementType(const Token& start, const Token& end, const Type expected_type, const Type actual_type, size_t index) {
-        return Error("Array waited element of type `" + expected_type.pool + "`, but found element of type `" + actual_type.pool + "` at index " + to_string(index), start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        return Error("Array waited element of type `" + expected_type.pool + "`, but found element of type `" + actual_type.pool + "` at index " + to_string(index), start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error MapInvalidKeyType(const Token& start, const Token& end, const Type& actual_type) {
+        return Error("Map/Set key must be of type `Int`, `String`, `Char` or `Bool`, got `" + actual_type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error MapKeyNotFound(const Token& start, const Token& end, const string& key) {
+        return Error("Key " + key + " is not found in map", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error SetInvalidMembershipValue(const Token& start, const Token& end, const Type& actual_type) {
+        return Error("Set element assignment waited `Bool`, but found `" + actual_type.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error InvalidTableArgumentCount(const Token& start, const Token& end, const string& name, size_t found) {
+        return Error("'" + name + "' expected 0 or 1 argument, but found " + to_string(found), start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error InvalidIndexAssignment(const Token& start, const Token& end, const Type& actual_type) {
+        return Error("Value of type `" + actual_type.pool + "` does not support element assignment", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error InvalidTableConversion(const Token& start, const Token& end, const string& target, const Type& actual_type) {
+        return Error("Can not convert `" + actual_type.pool + "` to `" + target + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error InvalidNativeArgumentCount(const Token& start, const Token& end, const string& name, int expected, size_t found) {
+        return Error("Native function '" + name + "' expected " + to_string(expected) + " argument(s), but found " + to_string(found), start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error InvalidNativeArgumentType(const Token& start, const Token& end, const string& name, size_t index, const Type& expected, const Type& found) {
+        return Error("Native function '" + name + "' expected `" + expected.pool + "` as argument " + to_string(index + 1) + ", but found `" + found.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error NativeFunctionFailed(const Token& start, const Token& end, const string& name, const string& reason) {
+        return Error("Native function '" + name + "' failed: " + reason, start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ParallelSharedWrite(const Token& start, const Token& end, const string& name) {
+        return Error("Can not modify '" + name + "' inside a parallel task: it is shared between tasks (return results from pmap instead)", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ParallelInput(const Token& start, const Token& end) {
+        return Error("'input' is not allowed inside a parallel task", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ParallelForNotCanonical(const Token& start, const Token& end) {
+        return Error("'parallel for' expects a counted loop `for (let i = a; i < b; i = i + 1;)`", start.pif, end.pif, ErrorTypes::SYNTAX, CurrentSource());
+    }
+
+    Error ParallelForInvalidBound(const Token& start, const Token& end, const Type& found) {
+        return Error("'parallel for' bounds must be `Int`, but found `" + found.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ParallelForEscape(const Token& start, const Token& end, const string& statement) {
+        return Error("'" + statement + "' can not leave a 'parallel for' body", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error SpawnNotCallable(const Token& start, const Token& end, const Type& found) {
+        return Error("'spawn' expects a call of a function or lambda, but `" + found.pool + "` is not callable", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error TaskTransfer(const Token& start, const Token& end, const string& what, const Type& found) {
+        return Error("Value of type `" + found.pool + "` can not be passed between tasks (" + what + ")", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error AwaitNotFuture(const Token& start, const Token& end, const Type& found) {
+        return Error("'await' expects `Future`, but found `" + found.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ChannelInvalidCapacity(const Token& start, const Token& end, int64_t capacity, int64_t max) {
+        return Error("Channel capacity must be from 1 to " + to_string(max) + ", but found " + to_string(capacity), start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ChannelClosed(const Token& start, const Token& end) {
+        return Error("Can not send to a closed channel", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error YieldOutsideFunction(const Token& start, const Token& end) {
+        return Error("'yield' can only be used in a function body", start.pif, end.pif, ErrorTypes::SYNTAX, CurrentSource());
+    }
+
+    Error YieldOutsideGenerator(const Token& start, const Token& end) {
+        return Error("'yield' is executed outside of its generator (parallel for or spawn inside a generator body)", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error InvalidYieldType(const Token& start, const Token& end, const string& func_name, const Type& expected, const Type& found) {
+        return Error("Generator '" + func_name + "' yields `" + expected.pool + "`, but found `" + found.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error GeneratorForeignContext(const Token& start, const Token& end) {
+        return Error("Generator can only be resumed in the task that created it", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error GeneratorRunning(const Token& start, const Token& end) {
+        return Error("Generator is already running", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ForInNotIterable(const Token& start, const Token& end, const Type& found) {
+        return Error("'for in' expects an array, a string, a range, `Map`, `Set` or `Generator`, but found `" + found.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
+    }
+
+    Error ForInInvalidRangeBound(const Token& start, const Token& end, const Type& found) {
+        return Error("Range bounds in 'for in' must be `Int`, but found `" + found.pool + "`", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
     }
 
     Error InvalidDereferenceAddres(const Token& start, const Token& end) {
-        return Error("Ivalid dereference addres", start.pif, end.pif, ErrorTypes::EXECUTION, PREPROCESSOR_OUTPUT);
+        return Error("Ivalid dereference addres", start.pif, end.pif, ErrorTypes::EXECUTION, CurrentSource());
     }
 }
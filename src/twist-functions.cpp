@@ -3,6 +3,11 @@
 #include "twist-tokens.cpp"
 #include "twist-args.cpp"
 #include "vector"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <cstdio>
 
 
 #pragma once
@@ -10,6 +15,105 @@
 
 using namespace std;
 
+// Ёмкость кэша результатов memo-функции по умолчанию (записей на функцию)
+#define DEFAULT_MEMO_CAPACITY 4096
+
+/*
+ * MemoCache – ограниченный LRU-кэш результатов чистой функции.
+ *
+ * Ключ – значения связанных параметров (после подстановки значений по
+ * умолчанию), сериализованные вместе с типом. Кэшируются только вызовы,
+ * у которых все аргументы и результат – Int, Double, String, Char, Bool
+ * или Null; остальные выполняются как обычно и в счётчики не попадают.
+ *
+ * Поля:
+ *   entries  – записи в порядке использования (начало – самая свежая).
+ *   index    – ключ -> позиция в entries.
+ *   capacity – максимальное число записей, 0 – без ограничения.
+ *   hits, misses – счётчики попаданий и промахов.
+ *   lock     – функцию могут вызывать параллельные задачи (parallel for, pmap).
+ */
+struct MemoCache {
+    static size_t default_capacity;
+
+    list<pair<string, Value>> entries;
+    unordered_map<string, list<pair<string, Value>>::iterator> index;
+    size_t capacity = default_capacity;
+    size_t hits = 0;
+    size_t misses = 0;
+    std::mutex lock;
+
+    static bool IsCacheable(const Value& value) {
+        return value.type == STANDART_TYPE::INT || value.type == STANDART_TYPE::DOUBLE ||
+               value.type == STANDART_TYPE::STRING || value.type == STANDART_TYPE::CHAR ||
+               value.type == STANDART_TYPE::BOOL || value.type == STANDART_TYPE::NULL_T;
+    }
+
+    // Дописывает значение к ключу. false – значение не кэшируемо.
+    static bool AppendKey(const Value& value, string& key) {
+        if (value.type == STANDART_TYPE::INT) {
+            key += 'i';
+            key += to_string(any_cast<int64_t>(value.data));
+        } else if (value.type == STANDART_TYPE::DOUBLE) {
+            // %La – точное шестнадцатеричное представление
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%La", any_cast<NUMBER_ACCURACY>(value.data));
+            key += 'd';
+            key += buffer;
+        } else if (value.type == STANDART_TYPE::STRING) {
+            const RuntimeString& str = any_cast<const RuntimeString&>(value.data);
+            key += 's';
+            key += to_string(str.size());
+            key += ':';
+            key += str.view();
+        } else if (value.type == STANDART_TYPE::CHAR) {
+            key += 'c';
+            key += any_cast<char>(value.data);
+        } else if (value.type == STANDART_TYPE::BOOL) {
+            key += any_cast<bool>(value.data) ? 'T' : 'F';
+        } else if (value.type == STANDART_TYPE::NULL_T) {
+            key += 'n';
+        } else {
+            return false;
+        }
+        key += '\x1f';
+        return true;
+    }
+
+    bool lookup(const string& key, Value& result) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            ++misses;
+            return false;
+        }
+        ++hits;
+        entries.splice(entries.begin(), entries, it->second);
+        result = it->second->second;
+        return true;
+    }
+
+    void store(const string& key, const Value& result) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!IsCacheable(result) || index.count(key))
+            return;
+        entries.emplace_front(key, result);
+        index[key] = entries.begin();
+        if (capacity && entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+};
+
+size_t MemoCache::default_capacity = DEFAULT_MEMO_CAPACITY;
+
+// Машинный код горячей функции (twist-jit.cpp)
+struct JitCode;
+
+// -memo: кэшировать все функции, признанные чистыми, а не только `memo func`
+static bool memoize_pure_functions = false;
+
 struct Function {
     Memory* memory; 
     Node* body;
@@ -23,6 +127,30 @@ struct Function {
 
     Type type;
     string name;
+
+    // Типы сигнатуры, вычисленные один раз при объявлении.
+    // Заполняются только для константных выражений типа, остальные
+    // по-прежнему вычисляются при каждом вызове.
+    vector<Type> argument_types;
+    vector<bool> argument_type_cached;
+    Type cached_return_type;
+    bool return_type_cached = false;
+
+    // Чистота тела: -1 – не анализировалась, 0 – нет, 1 – да.
+    // memo – кэш результатов (только для memo-функций), иначе nullptr.
+    int purity = -1;
+    MemoCache* memo = nullptr;
+
+    // В теле есть yield: вызов возвращает Generator (twist-generators.cpp)
+    bool generator = false;
+
+    // JIT (twist-jit.cpp): вызовы до компиляции и возвраты из кода;
+    // jit_state – 0 не компилировалась, 1 – jit_code готов, -1 – тело не
+    // поддерживается или код отключён после возвратов
+    std::atomic<uint32_t> jit_calls{0};
+    std::atomic<uint32_t> jit_bailouts{0};
+    std::atomic<int> jit_state{0};
+    JitCode* jit_code = nullptr;
     
     Function(string name, Memory* memory, Node* body, vector<Arg*> args, 
            Node* return_type, 
@@ -33,6 +161,11 @@ struct Function {
 
 };
 
+// Функции с подключённым memo-кэшем текущего запуска (для вывода счётчиков)
+inline vector<Function*>& MemoizedFunctions() {
+    return RuntimeContext::current().memoized_functions;
+}
+
 struct Method {
     Function* func;
     std::shared_ptr<Memory> instance_memory;
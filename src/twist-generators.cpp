@@ -0,0 +1,399 @@
+#include "twist-context.cpp"
+#include "twist-values.cpp"
+#include "twist-stack.cpp"
+#include "twist-profiler.cpp"
+#include "twist-functions.cpp"
+#include "twist-native.cpp"
+#include "twist-err.cpp"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <ucontext.h>
+    #include <unistd.h>
+#endif
+
+#pragma once
+
+/*
+ * Генераторы: функции с yield.
+ *
+ *     global func numbers(n: Int) -> Int {
+ *         for (let i = 0; i < n; i = i + 1;) { yield i; }
+ *     }
+ *
+ *     for (x in numbers(1000000)) { ... }
+ *
+ * Функция, в теле которой есть yield, – генератор (парсер отмечает
+ * NodeFunctionDeclaration::is_generator). Вызов проверяет и связывает
+ * аргументы как обычно, но тело не выполняет, а возвращает значение типа
+ * Generator. Цикл for-in запрашивает значения по одному: тело выполняется до
+ * следующего yield, значение yield становится значением переменной цикла.
+ * Объявленный тип результата – тип значений yield. ret завершает генератор,
+ * значение ret не используется. Ошибка в теле – ошибка в месте запроса
+ * значения.
+ *
+ * Кадр генератора возобновляемый: тело выполняется в сопрограмме (Coroutine)
+ * со своим нативным стеком, поэтому yield может стоять где угодно – во
+ * вложенных циклах, if, блоках – и вызовы внутри тела работают как обычно.
+ * Переключение стоит как обмен регистрами, память – одно значение и стек,
+ * из которого реально используются только затронутые страницы; поэтому
+ * поток значений любой длины обрабатывается в постоянной памяти.
+ *
+ * Генератор, брошенный до конца (break из for-in, потерянное значение),
+ * при разрушении возобновляется ещё раз: yield бросает GeneratorCancel, и
+ * стек тела раскручивается с освобождением памяти вызовов.
+ *
+ * Генератор выполняется в контексте и потоке, где создан: передавать его
+ * в spawn, каналы и возобновлять из частей parallel for нельзя. Тело
+ * генератора не профилируется отдельно: его время учитывается в строке,
+ * запросившей значение.
+ */
+
+// Размер стека сопрограммы генератора (МБ): память выделяется по мере
+// использования, недоступная страница снизу ловит переполнение
+#define GENERATOR_STACK_MB 8
+// Стеков завершённых генераторов, сохраняемых для новых
+#define GENERATOR_STACK_CACHE 16
+
+struct GeneratorCancel {};
+
+#if !defined(_WIN32) && defined(__x86_64__)
+    // Переключение стека: callee-saved регистры и управляющие слова FPU
+    // сохраняются на текущем стеке, *from (rdi) – его вершина, затем то же
+    // восстанавливается со стека to (rsi). swapcontext делает ещё и
+    // системный вызов для маски сигналов – на порядок медленнее.
+    // Параметры без имён: naked-функция читает их только из регистров
+    __attribute__((naked, noinline)) static void CoroutineSwitch(void** /* from */, void* /* to */) {
+        asm volatile(
+            "pushq %rbp\n\t"
+            "pushq %rbx\n\t"
+            "pushq %r12\n\t"
+            "pushq %r13\n\t"
+            "pushq %r14\n\t"
+            "pushq %r15\n\t"
+            "subq $8, %rsp\n\t"
+            "stmxcsr (%rsp)\n\t"
+            "fnstcw 4(%rsp)\n\t"
+            "movq %rsp, (%rdi)\n\t"
+            "movq %rsi, %rsp\n\t"
+            "ldmxcsr (%rsp)\n\t"
+            "fldcw 4(%rsp)\n\t"
+            "addq $8, %rsp\n\t"
+            "popq %r15\n\t"
+            "popq %r14\n\t"
+            "popq %r13\n\t"
+            "popq %r12\n\t"
+            "popq %rbx\n\t"
+            "popq %rbp\n\t"
+            "ret\n\t");
+    }
+
+    // Первый вход в сопрограмму: r13 – функция, r12 – её аргумент
+    __attribute__((naked, noinline)) static void CoroutineTrampoline() {
+        asm volatile(
+            "movq %r12, %rdi\n\t"
+            "callq *%r13\n\t"
+            "ud2\n\t");
+    }
+    #define COROUTINE_NATIVE_SWITCH
+#endif
+
+// Сопрограмма: resume() выполняет body до suspend() или завершения.
+// Исключение из body выходит из resume() вызывающего
+class Coroutine {
+    std::function<void()> body;
+    std::exception_ptr error;
+    bool started = false;
+    bool finished = false;
+
+    // Границы нативного стека сопрограммы для NativeStack
+    char* stack_base = nullptr;
+    size_t stack_limit = 0;
+
+    #ifdef _WIN32
+        void* fiber = nullptr;
+        void* caller = nullptr;
+
+        static void CALLBACK entry(void* arg) {
+            ((Coroutine*)arg)->main();
+        }
+    #else
+        void* stack = nullptr;
+        #ifdef COROUTINE_NATIVE_SWITCH
+            void* context = nullptr;    // вершина приостановленного стека
+            void* caller = nullptr;
+
+            static void entry(Coroutine* self) {
+                self->main();
+            }
+        #else
+            ucontext_t context;
+            ucontext_t caller;
+
+            static void entry(uint32_t low, uint32_t high) {
+                ((Coroutine*)(((uintptr_t)high << 32) | (uintptr_t)low))->main();
+            }
+        #endif
+
+        static std::vector<void*>& stack_cache() {
+            static thread_local std::vector<void*> cache;
+            return cache;
+        }
+    #endif
+
+    static size_t stack_size() {
+        return (size_t)GENERATOR_STACK_MB * 1024 * 1024;
+    }
+
+    void main() {
+        NativeStack::attach(stack_size());
+        try {
+            body();
+        } catch (const GeneratorCancel&) {
+        } catch (...) {
+            error = std::current_exception();
+        }
+        finished = true;
+        body = nullptr;
+        switch_out();
+    }
+
+    void switch_out() {
+        stack_base = NativeStack::base;
+        stack_limit = NativeStack::size;
+        #if defined(_WIN32)
+            SwitchToFiber(caller);
+        #elif defined(COROUTINE_NATIVE_SWITCH)
+            CoroutineSwitch(&context, caller);
+        #else
+            swapcontext(&context, &caller);
+        #endif
+    }
+
+    void start() {
+        #ifdef _WIN32
+            if (!IsThreadAFiber())
+                ConvertThreadToFiber(nullptr);
+            fiber = CreateFiber(stack_size(), entry, this);
+            if (!fiber)
+                throw std::bad_alloc();
+        #else
+            size_t page = (size_t)sysconf(_SC_PAGESIZE);
+            auto& cache = stack_cache();
+            if (!cache.empty()) {
+                stack = cache.back();
+                cache.pop_back();
+            } else {
+                stack = mmap(nullptr, stack_size(), PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                if (stack == MAP_FAILED) {
+                    stack = nullptr;
+                    throw std::bad_alloc();
+                }
+                mprotect(stack, page, PROT_NONE);
+            }
+            #ifdef COROUTINE_NATIVE_SWITCH
+                // Кадр, который CoroutineSwitch снимет со стека: управляющие
+                // слова, r15, r14, r13, r12, rbx, rbp, адрес возврата. После
+                // ret стек выровнен на 16, как перед call
+                auto top = (uint64_t*)((char*)stack + stack_size());
+                auto frame = top - 10;
+                uint32_t control[2] = { 0x1F80, 0x037F };
+                memcpy(frame, control, sizeof(control));
+                frame[1] = frame[2] = 0;
+                frame[3] = (uint64_t)(uintptr_t)&Coroutine::entry;
+                frame[4] = (uint64_t)(uintptr_t)this;
+                frame[5] = frame[6] = 0;
+                frame[7] = (uint64_t)(uintptr_t)&CoroutineTrampoline;
+                context = frame;
+            #else
+                getcontext(&context);
+                context.uc_stack.ss_sp = (char*)stack + page;
+                context.uc_stack.ss_size = stack_size() - page;
+                context.uc_link = nullptr;
+                uintptr_t self = (uintptr_t)this;
+                makecontext(&context, (void (*)())entry, 2, (uint32_t)self, (uint32_t)(self >> 32));
+            #endif
+        #endif
+        started = true;
+    }
+
+public:
+    explicit Coroutine(std::function<void()> body) : body(std::move(body)) {}
+
+    ~Coroutine() {
+        #ifdef _WIN32
+            if (fiber) DeleteFiber(fiber);
+        #else
+            if (!stack) return;
+            auto& cache = stack_cache();
+            if (cache.size() < GENERATOR_STACK_CACHE)
+                cache.push_back(stack);
+            else
+                munmap(stack, stack_size());
+        #endif
+    }
+
+    Coroutine(const Coroutine&) = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
+
+    bool is_started() const { return started; }
+    bool is_finished() const { return finished; }
+
+    // Выполнение до suspend() или конца body; false – body завершилось
+    bool resume() {
+        if (finished)
+            return false;
+        if (!started)
+            start();
+
+        char* base = NativeStack::base;
+        size_t size = NativeStack::size;
+        if (stack_base) {
+            NativeStack::base = stack_base;
+            NativeStack::size = stack_limit;
+        }
+        #if defined(_WIN32)
+            caller = GetCurrentFiber();
+            SwitchToFiber(fiber);
+        #elif defined(COROUTINE_NATIVE_SWITCH)
+            CoroutineSwitch(&caller, context);
+        #else
+            swapcontext(&caller, &context);
+        #endif
+        NativeStack::base = base;
+        NativeStack::size = size;
+
+        if (error) {
+            auto thrown = error;
+            error = nullptr;
+            std::rethrow_exception(thrown);
+        }
+        return !finished;
+    }
+
+    // Из body: возврат в resume()
+    void suspend() {
+        switch_out();
+    }
+};
+
+/*
+ * GeneratorState – генератор, общий для всех копий значения Generator.
+ *
+ * Поля:
+ *   function  – функция-генератор (тип значений yield, имя для ошибок).
+ *   context   – контекст запуска, в котором генератор создан.
+ *   current   – значение последнего yield.
+ *   running   – тело выполняется (повторный запрос из самого тела – ошибка).
+ *   cancelled – генератор разрушается, yield раскручивает стек тела.
+ *   depth, frames – recursion_depth и active_function_frames кадров тела,
+ *                   пока оно приостановлено.
+ */
+
+struct GeneratorState {
+    Coroutine coroutine;
+    Function* function;
+    RuntimeContext* context;
+    Value current = NewNull();
+    bool running = false;
+    bool cancelled = false;
+    int depth = 0;
+    int frames = 0;
+
+    GeneratorState(Function* function, std::function<void()> body)
+        : coroutine(std::move(body)), function(function), context(&RuntimeContext::current()) {}
+
+    ~GeneratorState() {
+        if (!coroutine.is_started() || coroutine.is_finished())
+            return;
+        cancelled = true;
+        try {
+            switch_in();
+        } catch (...) {
+            // Ошибка при раскрутке брошенного генератора никому не сообщается
+        }
+    }
+
+    GeneratorState(const GeneratorState&) = delete;
+    GeneratorState& operator=(const GeneratorState&) = delete;
+
+    // Генератор, тело которого выполняется в этом потоке сейчас
+    static GeneratorState*& active() {
+        static thread_local GeneratorState* generator = nullptr;
+        return generator;
+    }
+
+    // Переход в тело: счётчики глубины и профилировщик – как у тела
+    bool switch_in() {
+        auto& runtime = RuntimeContext::current();
+        int caller_depth = runtime.recursion_depth;
+        int caller_frames = runtime.active_function_frames;
+        runtime.recursion_depth += depth;
+        runtime.active_function_frames += frames;
+
+        auto previous = active();
+        bool unprofiled = Profiler::unprofiled_thread();
+        active() = this;
+        Profiler::unprofiled_thread() = true;
+        running = true;
+
+        struct Restore {
+            GeneratorState* self;
+            RuntimeContext& runtime;
+            int caller_depth, caller_frames;
+            GeneratorState* previous;
+            bool unprofiled;
+
+            ~Restore() {
+                self->running = false;
+                self->depth = runtime.recursion_depth - caller_depth;
+                self->frames = runtime.active_function_frames - caller_frames;
+                runtime.recursion_depth = caller_depth;
+                runtime.active_function_frames = caller_frames;
+                active() = previous;
+                Profiler::unprofiled_thread() = unprofiled;
+            }
+        } restore{this, runtime, caller_depth, caller_frames, previous, unprofiled};
+
+        return coroutine.resume();
+    }
+
+    // Следующее значение; false – генератор завершился
+    bool next(Value& value, const Token& start, const Token& end) {
+        if (context != &RuntimeContext::current())
+            throw ERROR_THROW::GeneratorForeignContext(start, end);
+        if (running)
+            throw ERROR_THROW::GeneratorRunning(start, end);
+        if (!switch_in())
+            return false;
+        value = std::move(current);
+        current = NewNull();
+        return true;
+    }
+
+    // Из тела: передать значение и ждать следующего запроса
+    void yield(Value value) {
+        current = std::move(value);
+        coroutine.suspend();
+        if (cancelled)
+            throw GeneratorCancel();
+    }
+};
+
+Value NewGenerator(std::shared_ptr<GeneratorState> generator) {
+    return Value(STANDART_TYPE::GENERATOR, std::move(generator));
+}
+
+namespace BUILTINS {
+    const bool GENERATORS_REGISTERED = NativeRegistry::define_name("Generator", NewType(STANDART_TYPE::GENERATOR));
+}
@@ -0,0 +1,100 @@
+#include "twist-output.cpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+#pragma once
+
+/*
+ * InputBuffer – построчное чтение стандартного ввода для input.
+ *
+ * Ввод читается блоками по INPUT_BUFFER_SIZE байт напрямую из дескриптора 0,
+ * минуя std::cin (синхронизацию со stdio и фасеты локали). next_line()
+ * возвращает строку как string_view внутрь буфера; копия делается только для
+ * строки, которая пересекает границу блока (carry). Представление
+ * действительно до следующего вызова.
+ *
+ * Семантика совпадает с getline: перевод строки отбрасывается, последняя
+ * строка без '\n' тоже возвращается, в конце ввода – false.
+ *
+ * Перед каждым блокирующим чтением сбрасывается OutputBuffer, поэтому
+ * приглашение input видно пользователю, а пакетное чтение не платит за
+ * сброс вывода на каждой строке.
+ *
+ * Состояние (InputState) принадлежит контексту текущего запуска; если в нём
+ * задан source, блоки берутся из этой строки вместо stdin (Interpreter).
+ */
+
+// Размер блока чтения stdin (байт)
+#define INPUT_BUFFER_SIZE (1024 * 1024)
+
+struct InputBuffer {
+    static InputState& state() {
+        auto& input = RuntimeContext::current().input;
+        if (input.data.empty()) input.data.resize(INPUT_BUFFER_SIZE);
+        return input;
+    }
+
+    static bool refill() {
+        auto& input = state();
+        if (input.eof) return false;
+        OutputBuffer::flush();
+        input.begin = input.end = 0;
+        size_t count = 0;
+        if (input.source) {
+            count = std::min((size_t)INPUT_BUFFER_SIZE, input.source->size() - input.source_offset);
+            memcpy(input.data.data(), input.source->data() + input.source_offset, count);
+            input.source_offset += count;
+        } else {
+            #ifdef _WIN32
+                auto result = _read(0, input.data.data(), INPUT_BUFFER_SIZE);
+            #else
+                auto result = ::read(0, input.data.data(), INPUT_BUFFER_SIZE);
+            #endif
+            count = result > 0 ? (size_t)result : 0;
+        }
+        if (!count) {
+            input.eof = true;
+            return false;
+        }
+        input.end = count;
+        return true;
+    }
+
+    static bool next_line(std::string_view& line) {
+        auto& input = state();
+        bool partial = false;
+        input.carry.clear();
+        while (true) {
+            if (input.begin == input.end && !refill()) {
+                if (!partial) return false;
+                line = input.carry;
+                return true;
+            }
+            char* data = input.data.data();
+            char* start = data + input.begin;
+            auto newline = (char*)memchr(start, '\n', input.end - input.begin);
+            if (newline) {
+                input.begin = (size_t)(newline - data) + 1;
+                if (!partial) {
+                    line = std::string_view(start, newline - start);
+                    return true;
+                }
+                input.carry.append(start, newline - start);
+                line = input.carry;
+                return true;
+            }
+            input.carry.append(start, input.end - input.begin);
+            input.begin = input.end;
+            partial = true;
+        }
+    }
+};
@@ -0,0 +1,105 @@
+#include "twist-parser.cpp"
+#include "twist-profiler.cpp"
+
+#pragma once
+
+/*
+ * ASTInstrumenter – подготовка AST к профилированию (--profile).
+ *
+ * Оборачивает операторы в NodeProfile. Позиции операторов берутся из
+ * ASTGenerator::statement_positions, поэтому проход выполняется сразу после
+ * разбора (и после ASTOptimizer). Объявления функций, структур и namespace,
+ * а также блоки { } не оборачиваются – обёртываются операторы внутри них.
+ * Выражения не обходятся: тела лямбд профилируются на уровне вызова.
+ */
+
+struct ASTInstrumenter {
+    unordered_map<Node*, PosInFile>& positions;
+    size_t wrapped = 0;
+
+    ASTInstrumenter(unordered_map<Node*, PosInFile>& positions) : positions(positions) {}
+
+    void instrument(vector<Node*>& nodes) {
+        for (auto& node : nodes)
+            node = wrap(node);
+    }
+
+    static bool IsDeclaration(Node* node) {
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_FUNCTION_DECLARATION:
+            case NodeTypes::NODE_STRUCT_DECLARATION:
+            case NodeTypes::NODE_NAMESPACE_DECLARATION:
+            case NodeTypes::NODE_BLOCK_OF_DECLARATIONS:
+            case NodeTypes::NODE_BLOCK_OF_NODES:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    Node* wrap(Node* node) {
+        if (!node) return node;
+        walk(node);
+        if (IsDeclaration(node)) return node;
+        auto it = positions.find(node);
+        if (it == positions.end()) return node;
+        wrapped++;
+        return new NodeProfile(node, Profiler::line_entry(it->second));
+    }
+
+    void walk(Node* node) {
+        if (!node) return;
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_BLOCK_OF_NODES:
+                for (auto& child : ((NodeBlock*)node)->nodes_array)
+                    child = wrap(child);
+                break;
+            case NodeTypes::NODE_BLOCK_OF_DECLARATIONS:
+                for (auto decl : ((NodeBlockDecl*)node)->decls)
+                    walk(decl);
+                break;
+            case NodeTypes::NODE_IF: {
+                auto if_node = (NodeIf*)node;
+                if_node->true_body = wrap(if_node->true_body);
+                if_node->else_body = wrap(if_node->else_body);
+                break;
+            }
+            case NodeTypes::NODE_WHILE: {
+                auto while_node = (NodeWhile*)node;
+                while_node->body = wrap(while_node->body);
+                break;
+            }
+            case NodeTypes::NODE_DO_WHILE: {
+                auto do_while = (NodeDoWhile*)node;
+                do_while->body = wrap(do_while->body);
+                break;
+            }
+            case NodeTypes::NODE_FOR: {
+                auto for_node = (NodeFor*)node;
+                for_node->body = wrap(for_node->body);
+                break;
+            }
+            case NodeTypes::NODE_FOR_IN: {
+                auto loop = (NodeForIn*)node;
+                loop->body = wrap(loop->body);
+                break;
+            }
+            case NodeTypes::NODE_PARALLEL_FOR: {
+                auto parallel = (NodeParallelFor*)node;
+                parallel->body = wrap(parallel->body);
+                break;
+            }
+            case NodeTypes::NODE_FUNCTION_DECLARATION:
+                walk(((NodeFunctionDeclaration*)node)->body);
+                break;
+            case NodeTypes::NODE_STRUCT_DECLARATION:
+                walk(((NodeStructDeclaration*)node)->body);
+                break;
+            case NodeTypes::NODE_NAMESPACE_DECLARATION:
+                walk(((NodeNamespaceDeclaration*)node)->statement);
+                break;
+            default:
+                break;
+        }
+    }
+};
@@ -0,0 +1,125 @@
+#include "twist-preproc.cpp"
+#include "twist-lexer.cpp"
+#include "twist-utils.cpp"
+#include "twist-tokenwalker.cpp"
+#include "twist-parser.cpp"
+#include "twist-optimizer.cpp"
+#include "twist-stack.cpp"
+#include "twist-context.cpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#pragma once
+
+/*
+ * Interpreter – независимый запуск программы Lumen внутри процесса.
+ *
+ * Каждый Interpreter владеет своим RuntimeContext: реестром объектов,
+ * счётчиком адресов, глубиной рекурсии, буферами ввода-вывода и журналом
+ * ошибок. Поэтому несколько программ можно выполнять одновременно в разных
+ * потоках одного процесса – один Interpreter на поток:
+ *
+ *     Interpreter interpreter;
+ *     interpreter.input = "42\n";
+ *     interpreter.run("job.lumen", source);
+ *     // interpreter.output, interpreter.diagnostics.str(), interpreter.exit_code
+ *
+ * Программа выполняется в отдельном потоке со стеком stack_size байт (как
+ * обычный запуск lumenc), ожидание – синхронное. exit и фатальные ошибки
+ * не завершают процесс, а только этот запуск (ProgramExit).
+ *
+ * Поля:
+ *   output      – всё, что программа вывела через out/outln;
+ *   diagnostics – сообщения об ошибках в формате терминала;
+ *   input       – данные для input (вместо stdin);
+ *   exit_code   – код exit, 1 – программа завершилась ошибкой;
+ *   optimize    – прогонять ASTOptimizer (как lumenc без -no-opt);
+ *   stack_size  – размер стека потока исполнения в байтах.
+ */
+
+// Размер стека потока исполнения Interpreter по умолчанию (МБ)
+#define INTERPRETER_STACK_MB 64
+
+// Разбор программы: лексер, препроцессор, парсер и (по желанию) ASTOptimizer.
+// Ошибки – Error или ProgramExit, как при обычном запуске. Полученное AST при
+// выполнении не меняется и может выполняться в нескольких контекстах сразу.
+vector<Node*> CompileProgram(const string& file_path, const string& source, bool optimize) {
+    Lexer lexer(file_path, source);
+    lexer.run();
+
+    Preprocessor preprocessor;
+    vector<Token> tokens = preprocessor.process(lexer.tokens, file_path);
+
+    TokenWalker walker(&tokens);
+    ASTGenerator parser(walker, file_path);
+    parser.parse();
+    vector<Node*> nodes = std::move(parser.nodes);
+    if (optimize) {
+        ASTOptimizer optimizer;
+        optimizer.optimize(nodes);
+    }
+    return nodes;
+}
+
+struct Interpreter {
+    RuntimeContext context;
+    std::string output;
+    std::ostringstream diagnostics;
+    std::string input;
+    int exit_code = 0;
+    bool optimize = true;
+    size_t stack_size = (size_t)INTERPRETER_STACK_MB * 1024 * 1024;
+
+    Interpreter() {
+        context.output.capture = &output;
+        context.input.source = &input;
+        context.diagnostics = &diagnostics;
+    }
+
+    ~Interpreter() {
+        ReleaseObjects(context);
+    }
+
+    Interpreter(const Interpreter&) = delete;
+    Interpreter& operator=(const Interpreter&) = delete;
+
+    bool run_file(const std::string& file_path) {
+        return run(file_path, OpenFile(file_path));
+    }
+
+    // Выполнение программы; true – без ошибок и с кодом выхода 0
+    bool run(const std::string& file_path, const std::string& source) {
+        RuntimeContext::Scope scope(&context);
+        context.source = source;
+        bool failed = false;
+
+        NativeStack::run(stack_size, [&](){
+            vector<Node*> nodes;
+            std::unique_ptr<Memory> memory = std::make_unique<Memory>();
+            try {
+                nodes = CompileProgram(file_path, source, optimize);
+                GenerateStandartTypes(memory.get(), file_path);
+                for (auto node : nodes)
+                    node->exec_from(memory.get());
+                JoinTasks();
+            } catch (Error& err) {
+                err.print();
+                failed = true;
+                exit_code = 1;
+            } catch (const ProgramExit& exit) {
+                failed = exit.fatal;
+                exit_code = exit.fatal ? 1 : exit.code;
+            }
+            // Задачи, оставшиеся после ошибки, ещё используют узлы и память
+            JoinTasks(false);
+            OutputBuffer::flush();
+            for (auto node : nodes)
+                delete node;
+        });
+
+        return !failed && exit_code == 0;
+    }
+};
@@ -0,0 +1,812 @@
+#include "twist-functions.cpp"
+#include "twist-nodetemp.cpp"
+#include "twist-stack.cpp"
+#include "twist-stats.cpp"
+#include "twist-quicken.cpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+    #define LUMEN_JIT_AVAILABLE
+    #include <sys/mman.h>
+#endif
+
+#pragma once
+
+/*
+ * Шаблонный JIT – машинный код x86-64 для горячих функций (Linux).
+ *
+ * После JIT_THRESHOLD вызовов тело функции один раз переводится в машинный
+ * код: каждому узлу AST соответствует готовый шаблон инструкций
+ * (X64Assembler – встроенный ассемблер, внешних зависимостей нет). Код
+ * строится только для функций, где все значения имеют постоянный тип
+ * Int, Double или Bool:
+ *
+ *   - параметры с константным типом Int / Double / Bool (без variadic и
+ *     global), тип возврата – Int / Double / Bool;
+ *   - локальные переменные – `static let x: T = ...` либо `let x = ...`,
+ *     которым присваиваются значения только того же типа;
+ *   - выражения: числа, true / false, имена, + - * / % (остаток – для Int),
+ *     сравнения, && || !, унарные + -, вызов самой функции;
+ *   - операторы: блоки, if / else, while, for, break, continue, ret,
+ *     присваивание локальной переменной (и слитые узлы оптимизатора).
+ *
+ * Для всего остального (другие типы, вызовы других функций, ввод/вывод,
+ * внешние имена, ** и т.д.) компиляция отклоняется, функция навсегда
+ * остаётся в интерпретаторе. Области видимости проверяются лексически:
+ * имя доступно только после объявления в том же блоке; повторное объявление
+ * видимого имени, объявление поверх параметра и имени функции отклоняются.
+ *
+ * Семантика совпадает с интерпретатором: Int – 64-битное целое, Double
+ * хранится как double, а операции выполняются во float, как в
+ * NodeBinary::compute. Значение Double, не представимое точно в double
+ * (аргумент или литерал), не допускается: аргумент отправляет вызов в
+ * интерпретатор, литерал отклоняет компиляцию.
+ *
+ * Скомпилированный код не имеет побочных эффектов вне своего кадра, поэтому
+ * любой особый случай (деление на ноль, исчерпание -rl или нативного стека,
+ * выход из тела без ret) не обрабатывается в машинном коде: код выставляет
+ * JitContext::failed и возвращается, а вызов целиком повторяется в
+ * интерпретаторе с теми же аргументами – с теми же результатами и ошибками.
+ * После JIT_MAX_BAILOUTS таких возвратов код функции больше не вызывается
+ * (иначе вложенные вызовы повторного выполнения снова уходили бы в код).
+ * Вызов тоже идёт через интерпретатор, если аргумент не того типа, имя
+ * параметра или локальной переменной занято глобальным объектом, включён
+ * --profile, функция memo или генератор.
+ *
+ * Соглашение о вызове кода: rdi – аргументы (8 байт на аргумент, последний
+ * по младшему адресу), rsi – JitContext, результат в rax (Bool – 0/1,
+ * Double – биты double). Кадр: rbp, сохранённый rbx (JitContext), затем
+ * ячейки переменных [rbp - 16 - 8 * i]; промежуточные значения – push/pop.
+ * Рекурсивный вызов – call на начало кода с проверкой глубины (как
+ * RecursionGuard) и запаса стека; `ret f(...)` – переход на начало тела
+ * без роста стека, как хвостовой вызов интерпретатора.
+ *
+ * Код неизменяем после публикации (Function::jit_state), поэтому функцию
+ * можно вызывать из нескольких потоков. --no-jit отключает компиляцию.
+ */
+
+#define JIT_THRESHOLD 32        // вызовов функции до компиляции
+#define JIT_MAX_BAILOUTS 4      // возвратов в интерпретатор, после которых код не используется
+
+// --jit / --no-jit
+static bool jit_enabled = true;
+
+enum class JitKind : uint8_t { INT, DOUBLE, BOOL };
+
+// Состояние выполнения кода (адрес передаётся в rsi, в коде – rbx)
+struct JitContext {
+    int64_t budget;         // сколько ещё вложенных вызовов допускает -rl
+    uintptr_t stack_limit;  // rsp ниже – нативный стек на исходе
+    uint8_t failed;         // 1 – вызов нужно повторить в интерпретаторе
+};
+
+struct JitCode {
+    void* entry = nullptr;
+    size_t size = 0;
+    vector<JitKind> params;
+    JitKind result = JitKind::INT;
+    vector<Symbol> names;   // параметры и локальные переменные
+};
+
+// Отказ компиляции (конструкция вне поддерживаемого подмножества)
+struct JitUnsupported {};
+
+/*
+ * X64Assembler – кодирование используемых инструкций x86-64.
+ *
+ * Метки – номера; переходы и call кодируются rel32 и дописываются в
+ * finish(). Обращения к памяти – всегда [base + disp32].
+ */
+struct X64Assembler {
+    enum Reg : uint8_t { RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7 };
+    enum Cond : uint8_t { B = 0x2, AE = 0x3, E = 0x4, NE = 0x5, A = 0x7, S = 0x8, P = 0xA, NP = 0xB,
+                          L = 0xC, GE = 0xD, LE = 0xE, G = 0xF };
+
+    vector<uint8_t> code;
+    vector<int64_t> labels;                 // позиция метки, -1 – не привязана
+    vector<pair<size_t, int>> fixups;       // (позиция rel32, метка)
+
+    void byte(uint8_t value) { code.push_back(value); }
+    void bytes(std::initializer_list<uint8_t> values) { code.insert(code.end(), values); }
+
+    void imm32(int32_t value) {
+        uint8_t raw[4];
+        memcpy(raw, &value, 4);
+        code.insert(code.end(), raw, raw + 4);
+    }
+
+    void imm64(uint64_t value) {
+        uint8_t raw[8];
+        memcpy(raw, &value, 8);
+        code.insert(code.end(), raw, raw + 8);
+    }
+
+    void patch32(size_t position, int32_t value) { memcpy(&code[position], &value, 4); }
+
+    int label() {
+        labels.push_back(-1);
+        return (int)labels.size() - 1;
+    }
+
+    void bind(int label) { labels[label] = (int64_t)code.size(); }
+
+    void rel32(int label) {
+        fixups.push_back({code.size(), label});
+        imm32(0);
+    }
+
+    void finish() {
+        for (auto& fixup : fixups)
+            patch32(fixup.first, (int32_t)(labels[fixup.second] - (int64_t)(fixup.first + 4)));
+    }
+
+    void jmp(int label) { byte(0xE9); rel32(label); }
+    void jcc(Cond cond, int label) { bytes({0x0F, uint8_t(0x80 | cond)}); rel32(label); }
+    void call(int label) { byte(0xE8); rel32(label); }
+    void ret() { byte(0xC3); }
+
+    void push(Reg reg) { byte(0x50 + reg); }
+    void pop(Reg reg) { byte(0x58 + reg); }
+
+    // op r64, [base + disp32]
+    void mem(uint8_t opcode, Reg reg, Reg base, int32_t disp) {
+        bytes({0x48, opcode, uint8_t(0x80 | (reg << 3) | base)});
+        if (base == RSP) byte(0x24);
+        imm32(disp);
+    }
+
+    void load(Reg reg, Reg base, int32_t disp) { mem(0x8B, reg, base, disp); }
+    void store(Reg base, int32_t disp, Reg reg) { mem(0x89, reg, base, disp); }
+
+    // op dst, src для инструкций вида `op r/m64, r64`
+    void rr(uint8_t opcode, Reg dst, Reg src) { bytes({0x48, opcode, uint8_t(0xC0 | (src << 3) | dst)}); }
+
+    void mov(Reg dst, Reg src) { rr(0x89, dst, src); }
+    void add(Reg dst, Reg src) { rr(0x01, dst, src); }
+    void sub(Reg dst, Reg src) { rr(0x29, dst, src); }
+    void cmp(Reg dst, Reg src) { rr(0x39, dst, src); }
+    void test(Reg dst, Reg src) { rr(0x85, dst, src); }
+    void imul(Reg dst, Reg src) { bytes({0x48, 0x0F, 0xAF, uint8_t(0xC0 | (dst << 3) | src)}); }
+    void cqo() { bytes({0x48, 0x99}); }
+    void idiv(Reg reg) { bytes({0x48, 0xF7, uint8_t(0xF8 | reg)}); }
+    void neg(Reg reg) { bytes({0x48, 0xF7, uint8_t(0xD8 | reg)}); }
+    void mov_imm(Reg reg, uint64_t value) { byte(0x48); byte(0xB8 + reg); imm64(value); }
+    void sub_rsp(int32_t value) { bytes({0x48, 0x81, 0xEC}); imm32(value); }
+    void add_rsp(int32_t value) { bytes({0x48, 0x81, 0xC4}); imm32(value); }
+
+    void setcc(Cond cond, Reg reg) { bytes({0x0F, uint8_t(0x90 | cond), uint8_t(0xC0 | reg)}); }
+    void and_al_cl() { bytes({0x20, 0xC8}); }
+    void or_al_cl() { bytes({0x08, 0xC8}); }
+    void movzx_eax_al() { bytes({0x0F, 0xB6, 0xC0}); }
+    void xor_eax_1() { bytes({0x83, 0xF0, 0x01}); }
+    void flip_sign_rax() { bytes({0x48, 0x0F, 0xBA, 0xF8, 0x3F}); }     // btc rax, 63
+
+    // [rbx + disp]: счётчики и флаг JitContext
+    void dec_ctx(int32_t disp) { bytes({0x48, 0x83, 0xAB}); imm32(disp); byte(1); }
+    void inc_ctx(int32_t disp) { bytes({0x48, 0x83, 0x83}); imm32(disp); byte(1); }
+    void set_ctx_flag(int32_t disp) { bytes({0xC6, 0x83}); imm32(disp); byte(1); }
+    void test_ctx_flag(int32_t disp) { bytes({0x80, 0xBB}); imm32(disp); byte(0); }
+    void cmp_rsp_ctx(int32_t disp) { mem(0x3B, RSP, RBX, disp); }
+
+    // SSE: xmm – номер регистра 0..7
+    void sse(uint8_t prefix, uint8_t opcode, int dst, int src) {
+        if (prefix) byte(prefix);
+        bytes({0x0F, opcode, uint8_t(0xC0 | (dst << 3) | src)});
+    }
+    void movq_to_xmm(int xmm, Reg reg) { bytes({0x66, 0x48, 0x0F, 0x6E, uint8_t(0xC0 | (xmm << 3) | reg)}); }
+    void movq_from_xmm(Reg reg, int xmm) { bytes({0x66, 0x48, 0x0F, 0x7E, uint8_t(0xC0 | (xmm << 3) | reg)}); }
+    void cvtsi2ss(int xmm, Reg reg) { bytes({0xF3, 0x48, 0x0F, 0x2A, uint8_t(0xC0 | (xmm << 3) | reg)}); }
+    void cvtsd2ss(int xmm) { sse(0xF2, 0x5A, xmm, xmm); }
+    void cvtss2sd(int xmm) { sse(0xF3, 0x5A, xmm, xmm); }
+    void ucomiss(int left, int right) { sse(0, 0x2E, left, right); }
+    void xorps(int xmm) { sse(0, 0x57, xmm, xmm); }
+};
+
+// Исполняемая память: код копируется в RW-страницы, затем они становятся RX
+inline void* JitPublish(const vector<uint8_t>& code) {
+    #ifdef LUMEN_JIT_AVAILABLE
+        void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+            return nullptr;
+        memcpy(memory, code.data(), code.size());
+        if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0) {
+            munmap(memory, code.size());
+            return nullptr;
+        }
+        return memory;
+    #else
+        return nullptr;
+    #endif
+}
+
+// Тип значения для кода по константному Type
+inline bool JitKindOf(const Type& type, JitKind& kind) {
+    if (type == STANDART_TYPE::INT) kind = JitKind::INT;
+    else if (type == STANDART_TYPE::DOUBLE) kind = JitKind::DOUBLE;
+    else if (type == STANDART_TYPE::BOOL) kind = JitKind::BOOL;
+    else return false;
+    return true;
+}
+
+// Double, который код хранит без потерь
+inline bool JitExactDouble(NUMBER_ACCURACY value) {
+    return (NUMBER_ACCURACY)(double)value == value;
+}
+
+/*
+ * JitCompiler – перевод тела функции в машинный код.
+ *
+ * Поля:
+ *   func        – компилируемая функция.
+ *   memory      – память объявления (константные типы).
+ *   slots       – тип и const каждой ячейки кадра.
+ *   scopes      – лексические области: имя -> ячейка.
+ *   loops       – метки break / continue вложенных циклов.
+ *   entry, body, bail, epilogue – метки начала кода, тела, отказа и выхода.
+ */
+struct JitCompiler {
+    using A = X64Assembler;
+
+    struct Slot { JitKind kind; bool is_const; };
+    struct Loop { int break_label; int continue_label; };
+
+    Function* func;
+    Memory* memory;
+    X64Assembler a;
+    vector<Slot> slots;
+    vector<unordered_map<string, int>> scopes;
+    vector<Loop> loops;
+    JitCode* result;
+    int entry, body, bail, epilogue;
+
+    static constexpr int32_t BUDGET = offsetof(JitContext, budget);
+    static constexpr int32_t STACK_LIMIT = offsetof(JitContext, stack_limit);
+    static constexpr int32_t FAILED = offsetof(JitContext, failed);
+
+    JitCompiler(Function* func, JitCode* result)
+        : func(func), memory(DeclarationMemory(func->memory)), result(result) {}
+
+    static int32_t slot_offset(int slot) { return -16 - 8 * slot; }
+
+    int find(const string& name) {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+            auto found = it->find(name);
+            if (found != it->end()) return found->second;
+        }
+        return -1;
+    }
+
+    int declare(const string& name, JitKind kind, bool is_const) {
+        if (name == func->name || find(name) != -1)
+            throw JitUnsupported();
+        slots.push_back({kind, is_const});
+        scopes.back()[name] = (int)slots.size() - 1;
+        result->names.push_back(Symbol(name));
+        return (int)slots.size() - 1;
+    }
+
+    void compile() {
+        if (func->generator || !func->return_type_cached || !JitKindOf(func->cached_return_type, result->result))
+            throw JitUnsupported();
+
+        entry = a.label();
+        body = a.label();
+        bail = a.label();
+        epilogue = a.label();
+
+        a.bind(entry);
+        a.push(A::RBP);
+        a.mov(A::RBP, A::RSP);
+        a.push(A::RBX);
+        a.sub_rsp(0);
+        size_t frame_size = a.code.size() - 4;
+        a.mov(A::RBX, A::RSI);
+
+        scopes.emplace_back();
+        size_t count = func->arguments.size();
+        for (size_t i = 0; i < count; i++) {
+            Arg* arg = func->arguments[i];
+            JitKind kind;
+            if (arg->is_variadic || arg->is_global || !func->argument_type_cached[i] ||
+                !JitKindOf(func->argument_types[i], kind))
+                throw JitUnsupported();
+            result->params.push_back(kind);
+            int slot = declare(arg->name, kind, arg->is_const);
+            a.load(A::RAX, A::RDI, (int32_t)(8 * (count - 1 - i)));
+            a.store(A::RBP, slot_offset(slot), A::RAX);
+        }
+
+        a.bind(body);
+        statement(func->body);
+        a.jmp(bail);        // тело завершилось без ret
+
+        a.bind(bail);
+        a.set_ctx_flag(FAILED);
+        a.bind(epilogue);
+        a.load(A::RBX, A::RBP, -8);
+        a.mov(A::RSP, A::RBP);
+        a.pop(A::RBP);
+        a.ret();
+
+        a.patch32(frame_size, (int32_t)(8 * (slots.size() + 1)));
+        a.finish();
+    }
+
+    // Тело ветки или цикла – своя лексическая область
+    void scoped(Node* node) {
+        scopes.emplace_back();
+        statement(node);
+        scopes.pop_back();
+    }
+
+    // Условие if / while / for: переход на false_label, если ложно
+    void condition(Node* node, int false_label) {
+        JitKind kind = expression(node);
+        if (kind == JitKind::DOUBLE)
+            throw JitUnsupported();
+        a.test(A::RAX, A::RAX);
+        a.jcc(A::E, false_label);
+    }
+
+    void statement(Node* node) {
+        if (!node) return;
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_BLOCK_OF_NODES:
+                scopes.emplace_back();
+                for (auto child : ((NodeBlock*)node)->nodes_array)
+                    statement(child);
+                scopes.pop_back();
+                return;
+
+            case NodeTypes::NODE_EXPRESSION_STATEMENT:
+                expression(((NodeExpressionStatement*)node)->expr);
+                return;
+
+            case NodeTypes::NODE_VARIABLE_DECLARATION: {
+                auto decl = (NodeVariableDeclaration*)node;
+                if (!decl->value_expr || decl->is_global || decl->is_private || decl->is_final ||
+                    decl->is_shadow || decl->nullable)
+                    throw JitUnsupported();
+                JitKind kind = expression(decl->value_expr);
+                if (decl->is_static) {
+                    auto type_expr = decl->type_expr;
+                    bool is_auto = type_expr && type_expr->NODE_TYPE == NodeTypes::NODE_LITERAL &&
+                                   ((NodeLiteral*)type_expr)->name == "auto";
+                    Type type;
+                    JitKind declared;
+                    if (!is_auto && (!ResolveConstantType(type_expr, memory, type) ||
+                                     !JitKindOf(type, declared) || declared != kind))
+                        throw JitUnsupported();
+                }
+                int slot = declare(decl->var_name, kind, decl->is_const);
+                a.store(A::RBP, slot_offset(slot), A::RAX);
+                return;
+            }
+
+            case NodeTypes::NODE_VARIABLE_EQUAL: {
+                auto equal = (NodeVariableEqual*)node;
+                if (equal->variable->NODE_TYPE != NodeTypes::NODE_LITERAL)
+                    throw JitUnsupported();
+                int slot = find(((NodeLiteral*)equal->variable)->name);
+                if (slot == -1 || slots[slot].is_const)
+                    throw JitUnsupported();
+                if (expression(equal->expression) != slots[slot].kind)
+                    throw JitUnsupported();
+                a.store(A::RBP, slot_offset(slot), A::RAX);
+                return;
+            }
+
+            // Слитые узлы: тот же результат, что у исходного присваивания
+            case NodeTypes::NODE_INCREMENT_LOCAL:
+                statement(((NodeIncrementLocal*)node)->fallback);
+                return;
+            case NodeTypes::NODE_ADD_LOCAL:
+                statement(((NodeAddLocal*)node)->fallback);
+                return;
+
+            case NodeTypes::NODE_IF: {
+                auto branch = (NodeIf*)node;
+                int else_label = a.label(), end = a.label();
+                condition(branch->expr, else_label);
+                scoped(branch->true_body);
+                a.jmp(end);
+                a.bind(else_label);
+                scoped(branch->else_body);
+                a.bind(end);
+                return;
+            }
+
+            case NodeTypes::NODE_WHILE: {
+                auto loop = (NodeWhile*)node;
+                int top = a.label(), end = a.label();
+                a.bind(top);
+                if (loop->condition)
+                    condition(loop->condition, end);
+                loops.push_back({end, top});
+                scoped(loop->body);
+                loops.pop_back();
+                a.jmp(top);
+                a.bind(end);
+                return;
+            }
+
+            case NodeTypes::NODE_FOR: {
+                auto loop = (NodeFor*)node;
+                if (!loop->body || !loop->condition)
+                    throw JitUnsupported();
+                int top = a.label(), update = a.label(), end = a.label();
+                scopes.emplace_back();
+                statement(loop->start_state);
+                a.bind(top);
+                condition(loop->condition, end);
+                loops.push_back({end, update});
+                scoped(loop->body);
+                loops.pop_back();
+                a.bind(update);
+                statement(loop->update_state);
+                a.jmp(top);
+                a.bind(end);
+                scopes.pop_back();
+                return;
+            }
+
+            case NodeTypes::NODE_BREAK:
+                if (loops.empty()) throw JitUnsupported();
+                a.jmp(loops.back().break_label);
+                return;
+            case NodeTypes::NODE_CONTINUE:
+                if (loops.empty()) throw JitUnsupported();
+                a.jmp(loops.back().continue_label);
+                return;
+
+            case NodeTypes::NODE_RETURN: {
+                auto expr = ((NodeReturn*)node)->expr;
+                if (!expr)
+                    throw JitUnsupported();
+                if (expr->NODE_TYPE == NodeTypes::NODE_CALL) {
+                    tail_call((NodeCall*)expr);
+                    return;
+                }
+                if (expression(expr) != result->result)
+                    throw JitUnsupported();
+                a.jmp(epilogue);
+                return;
+            }
+
+            default:
+                throw JitUnsupported();
+        }
+    }
+
+    // Аргументы вызова самой функции – в стек, слева направо
+    void push_arguments(NodeCall* call) {
+        auto callable = call->callable;
+        if (callable->NODE_TYPE != NodeTypes::NODE_LITERAL || ((NodeLiteral*)callable)->name != func->name ||
+            call->args.size() != result->params.size())
+            throw JitUnsupported();
+        for (size_t i = 0; i < call->args.size(); i++) {
+            if (expression(call->args[i]) != result->params[i])
+                throw JitUnsupported();
+            a.push(A::RAX);
+        }
+    }
+
+    // `ret f(...)`: новые значения параметров и переход на начало тела
+    void tail_call(NodeCall* call) {
+        push_arguments(call);
+        for (size_t i = call->args.size(); i-- > 0; ) {
+            a.pop(A::RAX);
+            a.store(A::RBP, slot_offset((int)i), A::RAX);
+        }
+        a.jmp(body);
+    }
+
+    JitKind call(NodeCall* call) {
+        push_arguments(call);
+        int32_t size = (int32_t)(8 * call->args.size());
+        a.cmp_rsp_ctx(STACK_LIMIT);
+        a.jcc(A::B, bail);
+        a.dec_ctx(BUDGET);
+        a.jcc(A::S, bail);
+        a.mov(A::RDI, A::RSP);
+        a.mov(A::RSI, A::RBX);
+        a.call(entry);
+        a.inc_ctx(BUDGET);
+        a.add_rsp(size);
+        a.test_ctx_flag(FAILED);
+        a.jcc(A::NE, epilogue);
+        return result->result;
+    }
+
+    // Операнд во float в xmm (как `float l = ...` в NodeBinary::compute)
+    void to_float(int xmm, A::Reg reg, JitKind kind) {
+        if (kind == JitKind::INT) {
+            a.cvtsi2ss(xmm, reg);
+        } else {
+            a.movq_to_xmm(xmm, reg);
+            a.cvtsd2ss(xmm);
+        }
+    }
+
+    JitKind logical(NodeBinary* binary, bool is_and) {
+        int end = a.label();
+        if (expression(binary->left) != JitKind::BOOL)
+            throw JitUnsupported();
+        a.test(A::RAX, A::RAX);
+        a.jcc(is_and ? A::E : A::NE, end);
+        if (expression(binary->right) != JitKind::BOOL)
+            throw JitUnsupported();
+        a.bind(end);
+        return JitKind::BOOL;
+    }
+
+    JitKind binary(NodeBinary* binary) {
+        auto& op = binary->op;
+        if (op == "&&" || op == "and") return logical(binary, true);
+        if (op == "||" || op == "or") return logical(binary, false);
+
+        JitKind left = expression(binary->left);
+        a.push(A::RAX);
+        JitKind right = expression(binary->right);
+        a.mov(A::RCX, A::RAX);
+        a.pop(A::RAX);
+
+        bool compare = op == "==" || op == "!=" || op == "<" || op == "<=" || op == ">" || op == ">=";
+        if (left == JitKind::BOOL || right == JitKind::BOOL) {
+            if (left != right || (op != "==" && op != "!="))
+                throw JitUnsupported();
+            a.cmp(A::RAX, A::RCX);
+            a.setcc(op == "==" ? A::E : A::NE, A::RAX);
+            a.movzx_eax_al();
+            return JitKind::BOOL;
+        }
+
+        if (left == JitKind::INT && right == JitKind::INT) {
+            if (compare) {
+                A::Cond cond = op == "==" ? A::E : op == "!=" ? A::NE : op == "<" ? A::L :
+                               op == "<=" ? A::LE : op == ">" ? A::G : A::GE;
+                a.cmp(A::RAX, A::RCX);
+                a.setcc(cond, A::RAX);
+                a.movzx_eax_al();
+                return JitKind::BOOL;
+            }
+            if (op == "+") a.add(A::RAX, A::RCX);
+            else if (op == "-") a.sub(A::RAX, A::RCX);
+            else if (op == "*") a.imul(A::RAX, A::RCX);
+            else if (op == "/" || op == "%") {
+                a.test(A::RCX, A::RCX);
+                a.jcc(A::E, bail);
+                a.cqo();
+                a.idiv(A::RCX);
+                if (op == "%") a.mov(A::RAX, A::RDX);
+            }
+            else throw JitUnsupported();
+            return JitKind::INT;
+        }
+
+        // Double с Double или Int: вычисление во float
+        to_float(0, A::RAX, left);
+        to_float(1, A::RCX, right);
+        if (compare) {
+            if (op == ">" || op == ">=") a.ucomiss(0, 1);
+            else a.ucomiss(1, 0);
+            if (op == ">" || op == "<") a.setcc(A::A, A::RAX);
+            else if (op == ">=" || op == "<=") a.setcc(A::AE, A::RAX);
+            else if (op == "==") { a.setcc(A::E, A::RAX); a.setcc(A::NP, A::RCX); a.and_al_cl(); }
+            else { a.setcc(A::NE, A::RAX); a.setcc(A::P, A::RCX); a.or_al_cl(); }
+            a.movzx_eax_al();
+            return JitKind::BOOL;
+        }
+        if (op == "+") a.sse(0xF3, 0x58, 0, 1);
+        else if (op == "-") a.sse(0xF3, 0x5C, 0, 1);
+        else if (op == "*") a.sse(0xF3, 0x59, 0, 1);
+        else if (op == "/") {
+            int nonzero = a.label();
+            a.xorps(2);
+            a.ucomiss(1, 2);
+            a.jcc(A::P, nonzero);
+            a.jcc(A::E, bail);
+            a.bind(nonzero);
+            a.sse(0xF3, 0x5E, 0, 1);
+        }
+        else throw JitUnsupported();
+        a.cvtss2sd(0);
+        a.movq_from_xmm(A::RAX, 0);
+        return JitKind::DOUBLE;
+    }
+
+    JitKind unary(NodeUnary* unary) {
+        JitKind kind = expression(unary->operand);
+        auto& op = unary->op;
+        if (kind == JitKind::BOOL && (op == "!" || op == "not")) {
+            a.xor_eax_1();
+            return kind;
+        }
+        if (kind != JitKind::BOOL && op == "+")
+            return kind;
+        if (kind != JitKind::BOOL && op == "-") {
+            if (kind == JitKind::INT) a.neg(A::RAX);
+            else a.flip_sign_rax();
+            return kind;
+        }
+        throw JitUnsupported();
+    }
+
+    JitKind expression(Node* node) {
+        if (!node) throw JitUnsupported();
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_NUMBER: {
+                auto& value = ((NodeNumber*)node)->value;
+                if (auto number = QuickInt(value)) {
+                    a.mov_imm(A::RAX, (uint64_t)*number);
+                    return JitKind::INT;
+                }
+                auto number = QuickDouble(value);
+                if (!number || !JitExactDouble(*number))
+                    throw JitUnsupported();
+                double bits = (double)*number;
+                uint64_t raw;
+                memcpy(&raw, &bits, 8);
+                a.mov_imm(A::RAX, raw);
+                return JitKind::DOUBLE;
+            }
+            case NodeTypes::NODE_BOOL: {
+                auto value = node->eval_from(nullptr);
+                a.mov_imm(A::RAX, *QuickBool(value) ? 1 : 0);
+                return JitKind::BOOL;
+            }
+            case NodeTypes::NODE_LITERAL: {
+                int slot = find(((NodeLiteral*)node)->name);
+                if (slot == -1)
+                    throw JitUnsupported();
+                a.load(A::RAX, A::RBP, slot_offset(slot));
+                return slots[slot].kind;
+            }
+            case NodeTypes::NODE_SCOPES:
+                return expression(((NodeScopes*)node)->expression);
+            case NodeTypes::NODE_COMPARE_LOCAL:
+                return binary(((NodeCompareLocal*)node)->fallback);
+            case NodeTypes::NODE_BINARY:
+                return binary((NodeBinary*)node);
+            case NodeTypes::NODE_UNARY:
+                return unary((NodeUnary*)node);
+            case NodeTypes::NODE_CALL:
+                return call((NodeCall*)node);
+            default:
+                throw JitUnsupported();
+        }
+    }
+};
+
+// Компиляция функции; nullptr – тело вне поддерживаемого подмножества
+inline JitCode* JitCompile(Function* func) {
+    #ifdef LUMEN_JIT_AVAILABLE
+        auto code = new JitCode();
+        JitCompiler compiler(func, code);
+        try {
+            compiler.compile();
+        } catch (JitUnsupported) {
+            delete code;
+            return nullptr;
+        }
+        code->size = compiler.a.code.size();
+        code->entry = JitPublish(compiler.a.code);
+        if (!code->entry) {
+            delete code;
+            return nullptr;
+        }
+        STAT_INC(jit_compilations);
+        return code;
+    #else
+        return nullptr;
+    #endif
+}
+
+// Машинный код функции, если она уже горячая (компилируется здесь же)
+inline JitCode* JitCodeOf(Function* func) {
+    int state = func->jit_state.load(std::memory_order_acquire);
+    if (state == 1)
+        return func->jit_code;
+    if (state == -1 || func->jit_calls.fetch_add(1, std::memory_order_relaxed) + 1 < JIT_THRESHOLD)
+        return nullptr;
+
+    static std::mutex compile_lock;
+    std::lock_guard<std::mutex> guard(compile_lock);
+    if (func->jit_state.load(std::memory_order_relaxed) == 0) {
+        func->jit_code = JitCompile(func);
+        func->jit_state.store(func->jit_code ? 1 : -1, std::memory_order_release);
+    }
+    return func->jit_code;
+}
+
+/*
+ * Вызов функции через машинный код (из NodeCall::call_function).
+ *
+ * Аргументы вычисляются по одному и сразу проверяются; при первом
+ * несовпадении типа вычисление прекращается. Вычисленные значения остаются
+ * в evaluated – интерпретатор связывает их, не вычисляя повторно. true –
+ * результат в result; false – вызов выполняет интерпретатор.
+ */
+bool JitInvoke(Function* func, vector<Node*>& args, Memory* _memory, vector<Value>& evaluated, Value& result) {
+    if (!jit_enabled || func->memo || func->generator || args.size() != func->arguments.size() || Profiler::recording())
+        return false;
+    JitCode* code = JitCodeOf(func);
+    if (!code)
+        return false;
+
+    vector<uint64_t> raw(args.size() ? args.size() : 1);
+    evaluated.reserve(args.size());
+    for (size_t i = 0; i < args.size(); i++) {
+        evaluated.push_back(args[i]->eval_from(_memory));
+        const Value& value = evaluated.back();
+        uint64_t& slot = raw[args.size() - 1 - i];
+        switch (code->params[i]) {
+            case JitKind::INT: {
+                auto number = QuickInt(value);
+                if (!number) return false;
+                slot = (uint64_t)*number;
+                break;
+            }
+            case JitKind::DOUBLE: {
+                auto number = QuickDouble(value);
+                if (!number || !JitExactDouble(*number)) return false;
+                double bits = (double)*number;
+                memcpy(&slot, &bits, 8);
+                break;
+            }
+            case JitKind::BOOL: {
+                auto flag = QuickBool(value);
+                if (!flag) return false;
+                slot = *flag ? 1 : 0;
+                break;
+            }
+        }
+    }
+
+    // Имена кадра, занятые глобальными объектами, – ошибки интерпретатора
+    Memory* declaration = DeclarationMemory(func->memory);
+    for (auto& name : code->names) {
+        auto found = declaration->string_pool.find(name);
+        if (found != declaration->string_pool.end() && found->second->modifiers.is_global)
+            return false;
+    }
+
+    JitContext context;
+    int depth = RuntimeContext::current().recursion_depth;
+    context.budget = max_recursion_depth > 0 ? (int64_t)max_recursion_depth - depth : INT64_MAX;
+    context.stack_limit = NativeStack::base ? (uintptr_t)(NativeStack::base - NativeStack::size + NATIVE_STACK_RESERVE) : 0;
+    context.failed = 0;
+
+    auto entry = (uint64_t (*)(const uint64_t*, JitContext*))code->entry;
+    uint64_t value = entry(raw.data(), &context);
+    if (context.failed) {
+        STAT_INC(jit_bailouts);
+        if (func->jit_bailouts.fetch_add(1, std::memory_order_relaxed) + 1 >= JIT_MAX_BAILOUTS)
+            func->jit_state.store(-1, std::memory_order_release);
+        return false;
+    }
+    STAT_INC(jit_calls);
+    switch (code->result) {
+        case JitKind::INT:
+            result = NewInt((int64_t)value);
+            break;
+        case JitKind::DOUBLE: {
+            double bits;
+            memcpy(&bits, &value, 8);
+            result = NewDouble(bits);
+            break;
+        }
+        case JitKind::BOOL:
+            result = NewBool(value != 0);
+            break;
+    }
+    return true;
+}
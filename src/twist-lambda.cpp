@@ -22,6 +22,12 @@ struct Lambda {
     Token start_type_token;
     Token end_type_token;
 
+    // Типы сигнатуры, вычисленные при создании лямбды (см. Function)
+    vector<Type> argument_types;
+    vector<bool> argument_type_cached;
+    Type cached_return_type;
+    bool return_type_cached = false;
+
     Lambda(Memory* memory, void* expr, vector<Arg*> args,
            Node* return_type, string name,
            Token start_args_token, Token end_args_token,
@@ -207,7 +207,7 @@ vector<string> KEYWORDS = { "if", "else", "for", "while", "echo",
     "do", "break", "continue", "let",
     "static", "final", "const", "global", "shadow", "typeof", "sizeof",
      "del", "new" ,"true", "false", "null", "ret", "struct",
-    "out", "outln", "input", "in" , "and", "or", "namespace", "assert", "lambda",  "func", "Func", "exit", "private"};
+    "out", "outln", "input", "in" , "and", "or", "namespace", "assert", "lambda",  "func", "Func", "exit", "private", "memo", "parallel", "spawn", "await", "yield"};
 
 struct Lexer {
     int line = 1;
@@ -425,6 +425,9 @@ struct Lexer {
         }
 
         while (UTF8Helper::isDigit(this->file_data, this->pos) || C == '.') {
+            // 0..10 – диапазон, а не число
+            if (C == '.' && this->get_byte(1) == '.')
+                break;
             V += C;
             this->next();
             this->next_in_line();
@@ -0,0 +1,267 @@
+#include "twist-values.cpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#pragma once
+
+/*
+ * ValueTable – хэш-таблица для значений Map и Set.
+ *
+ * Открытая адресация в духе Swiss table:
+ *   - ctrl  – управляющий байт на ячейку: EMPTY, DELETED или 7 младших бит
+ *             хэша ключа (h2). Группа из TABLE_GROUP_WIDTH байтов проверяется
+ *             одним 64-битным словом, поэтому зонд отсеивает почти все чужие
+ *             ячейки, не трогая сами записи. Первые TABLE_GROUP_WIDTH байтов
+ *             продублированы в конце – группу можно читать с любой позиции;
+ *   - slots – номер записи для занятой ячейки;
+ *   - entries – записи (ключ, значение, полный хэш) в порядке вставки:
+ *             обход Map/Set детерминирован и идёт по плотному массиву.
+ *
+ * Группы перебираются треугольными шагами, таблица растёт при заполнении
+ * 7/8 ячеек (считая удалённые). При перестройке записи уплотняются, а
+ * хэши берутся из записей – ключи повторно не хэшируются.
+ *
+ * Ключами могут быть Int, String, Char и Bool (TableKey). Для Set значение
+ * записи не используется.
+ */
+
+// Число управляющих байтов, проверяемых за один шаг
+#define TABLE_GROUP_WIDTH 8
+
+enum TableKeyKind : uint8_t {
+    KEY_INVALID,
+    KEY_INT,
+    KEY_STRING,
+    KEY_CHAR,
+    KEY_BOOL
+};
+
+static inline uint64_t MixHash(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Ключ поиска: ссылка на значение, вид и хэш (вычисляются один раз)
+struct TableKey {
+    const Value& value;
+    TableKeyKind kind = KEY_INVALID;
+    size_t hash = 0;
+
+    explicit TableKey(const Value& key) : value(key) {
+        if (key.type == STANDART_TYPE::INT) {
+            kind = KEY_INT;
+            hash = MixHash((uint64_t)any_cast<int64_t>(key.data));
+        } else if (key.type == STANDART_TYPE::STRING) {
+            kind = KEY_STRING;
+            hash = MixHash(any_cast<const RuntimeString&>(key.data).hash());
+        } else if (key.type == STANDART_TYPE::CHAR) {
+            kind = KEY_CHAR;
+            hash = MixHash((uint64_t)(unsigned char)any_cast<char>(key.data) + 0x100);
+        } else if (key.type == STANDART_TYPE::BOOL) {
+            kind = KEY_BOOL;
+            hash = MixHash(any_cast<bool>(key.data) ? 0x201 : 0x200);
+        }
+    }
+
+    bool valid() const { return kind != KEY_INVALID; }
+};
+
+// Текстовое представление ключа для сообщений об ошибках
+string TableKeyRepr(const Value& key) {
+    if (key.type == STANDART_TYPE::INT)
+        return to_string(any_cast<int64_t>(key.data));
+    if (key.type == STANDART_TYPE::STRING)
+        return "\"" + any_cast<const RuntimeString&>(key.data).str() + "\"";
+    if (key.type == STANDART_TYPE::CHAR)
+        return string("'") + any_cast<char>(key.data) + "'";
+    if (key.type == STANDART_TYPE::BOOL)
+        return any_cast<bool>(key.data) ? "true" : "false";
+    return key.type.pool;
+}
+
+struct ValueTable {
+    struct Entry {
+        Value key;
+        Value value;
+        size_t hash;
+        TableKeyKind kind;
+        bool alive;
+
+        Entry(const Value& key, Value value, size_t hash, TableKeyKind kind)
+            : key(key), value(std::move(value)), hash(hash), kind(kind), alive(true) {}
+    };
+
+    static constexpr uint8_t EMPTY = 0x80;
+    static constexpr uint8_t DELETED = 0xFE;
+
+    vector<uint8_t> ctrl;       // capacity + TABLE_GROUP_WIDTH байтов
+    vector<uint32_t> slots;     // номер записи в entries
+    vector<Entry> entries;
+    size_t live = 0;            // живых записей
+    size_t used = 0;            // ячеек не EMPTY (живые + DELETED)
+    size_t capacity = 0;        // 0 или степень двойки >= TABLE_GROUP_WIDTH
+
+    size_t size() const { return live; }
+
+    Value* find(const TableKey& key) {
+        size_t slot = find_slot(key);
+        return slot == SIZE_MAX ? nullptr : &entries[slots[slot]].value;
+    }
+
+    const Value* find(const TableKey& key) const {
+        return const_cast<ValueTable*>(this)->find(key);
+    }
+
+    bool contains(const TableKey& key) const {
+        return find_slot(key) != SIZE_MAX;
+    }
+
+    // Вставка или замена значения
+    void set(const TableKey& key, Value value) {
+        size_t slot = find_slot(key);
+        if (slot != SIZE_MAX) {
+            entries[slots[slot]].value = std::move(value);
+            return;
+        }
+        if (used + 1 > capacity - capacity / 8 || entries.size() >= capacity)
+            rehash(live + 1);
+        slot = find_insert_slot(key.hash);
+        if (ctrl[slot] == EMPTY) used++;
+        set_ctrl(slot, (uint8_t)(key.hash & 0x7F));
+        slots[slot] = (uint32_t)entries.size();
+        entries.emplace_back(key.value, std::move(value), key.hash, key.kind);
+        live++;
+    }
+
+    bool erase(const TableKey& key) {
+        size_t slot = find_slot(key);
+        if (slot == SIZE_MAX) return false;
+        auto& entry = entries[slots[slot]];
+        entry.alive = false;
+        entry.key = NewNull();
+        entry.value = NewNull();
+        set_ctrl(slot, DELETED);
+        live--;
+        return true;
+    }
+
+    // Обход живых записей в порядке вставки
+    template <typename F>
+    void for_each(F f) const {
+        for (auto& entry : entries)
+            if (entry.alive) f(entry);
+    }
+
+private:
+    static uint64_t load_group(const uint8_t* p) {
+        uint64_t group;
+        memcpy(&group, p, sizeof(group));
+        #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            group = __builtin_bswap64(group);
+        #endif
+        return group;
+    }
+
+    // Номер первого байта группы с установленным старшим битом в маске
+    static size_t first_byte(uint64_t mask) {
+        #if defined(__GNUC__) || defined(__clang__)
+            return (size_t)__builtin_ctzll(mask) >> 3;
+        #else
+            size_t index = 0;
+            while (!(mask & 0x80)) { mask >>= 8; index++; }
+            return index;
+        #endif
+    }
+
+    static constexpr uint64_t LSB = 0x0101010101010101ULL;
+    static constexpr uint64_t MSB = 0x8080808080808080ULL;
+
+    // Байты, равные h2 (возможны редкие ложные совпадения – ключ сверяется)
+    static uint64_t match(uint64_t group, uint8_t h2) {
+        uint64_t x = group ^ (LSB * h2);
+        return (x - LSB) & ~x & MSB;
+    }
+
+    static uint64_t match_empty(uint64_t group) {
+        return group & ~(group << 6) & MSB;
+    }
+
+    static uint64_t match_empty_or_deleted(uint64_t group) {
+        return group & MSB;
+    }
+
+    static bool keys_equal(const Entry& entry, const TableKey& key) {
+        if (entry.hash != key.hash || entry.kind != key.kind) return false;
+        switch (key.kind) {
+            case KEY_INT:
+                return any_cast<int64_t>(entry.key.data) == any_cast<int64_t>(key.value.data);
+            case KEY_STRING:
+                return any_cast<const RuntimeString&>(entry.key.data) == any_cast<const RuntimeString&>(key.value.data);
+            case KEY_CHAR:
+                return any_cast<char>(entry.key.data) == any_cast<char>(key.value.data);
+            case KEY_BOOL:
+                return any_cast<bool>(entry.key.data) == any_cast<bool>(key.value.data);
+            default:
+                return false;
+        }
+    }
+
+    size_t find_slot(const TableKey& key) const {
+        if (!capacity) return SIZE_MAX;
+        size_t mask = capacity - 1;
+        uint8_t h2 = (uint8_t)(key.hash & 0x7F);
+        size_t pos = (key.hash >> 7) & mask;
+        for (size_t step = TABLE_GROUP_WIDTH;; step += TABLE_GROUP_WIDTH) {
+            uint64_t group = load_group(ctrl.data() + pos);
+            for (uint64_t bits = match(group, h2); bits; bits &= bits - 1) {
+                size_t slot = (pos + first_byte(bits)) & mask;
+                if (keys_equal(entries[slots[slot]], key)) return slot;
+            }
+            if (match_empty(group)) return SIZE_MAX;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    size_t find_insert_slot(size_t hash) const {
+        size_t mask = capacity - 1;
+        size_t pos = (hash >> 7) & mask;
+        for (size_t step = TABLE_GROUP_WIDTH;; step += TABLE_GROUP_WIDTH) {
+            uint64_t bits = match_empty_or_deleted(load_group(ctrl.data() + pos));
+            if (bits) return (pos + first_byte(bits)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    void set_ctrl(size_t slot, uint8_t value) {
+        ctrl[slot] = value;
+        if (slot < TABLE_GROUP_WIDTH) ctrl[capacity + slot] = value;
+    }
+
+    // Перестройка под count записей: уплотнение entries и новые ctrl/slots
+    void rehash(size_t count) {
+        size_t new_capacity = TABLE_GROUP_WIDTH;
+        while (new_capacity - new_capacity / 8 < count * 2) new_capacity *= 2;
+
+        vector<Entry> compacted;
+        compacted.reserve(count);
+        for (auto& entry : entries)
+            if (entry.alive) compacted.push_back(std::move(entry));
+        entries = std::move(compacted);
+
+        capacity = new_capacity;
+        ctrl.assign(capacity + TABLE_GROUP_WIDTH, EMPTY);
+        slots.assign(capacity, 0);
+        for (size_t i = 0; i < entries.size(); i++) {
+            size_t slot = find_insert_slot(entries[i].hash);
+            set_ctrl(slot, (uint8_t)(entries[i].hash & 0x7F));
+            slots[slot] = (uint32_t)i;
+        }
+        used = live = entries.size();
+    }
+};
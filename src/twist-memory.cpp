@@ -1,5 +1,7 @@
 // memory.cpp
 #include "twist-values.cpp"
+#include "twist-symbols.cpp"
+#include "twist-context.cpp"
 #include <string>
 #include <iostream>
 #include <unordered_map>
@@ -8,24 +10,30 @@
 
 typedef int Address;
 
-class AddressManager {
-private:
-    static int next_address;
+// Адресов в блоке, который параллельная задача берёт за один раз
+#define TASK_ADDRESS_BLOCK 4096
 
+// Счётчик адресов – в контексте текущего запуска
+class AddressManager {
 public:
     static int get_next_address() {
-        return ++next_address;
+        auto& context = RuntimeContext::current();
+        if (context.next_address == context.address_limit) {
+            // Задача parallel for / pmap: следующий блок общего диапазона
+            context.next_address = context.address_source->fetch_add(TASK_ADDRESS_BLOCK);
+            context.address_limit = context.next_address + TASK_ADDRESS_BLOCK;
+        }
+        return ++context.next_address;
     }
 
     static int get_current_address() {
-        return next_address;
+        return RuntimeContext::current().next_address;
     }
 
     static void reset() {
-        next_address = 0;
+        RuntimeContext::current().next_address = 0;
     }
 };
-int AddressManager::next_address = 0;
 
 struct Modifiers {
     bool is_const = false;
@@ -48,6 +56,7 @@ struct MemoryObject {
     Address address;
     std::string var_name;      // имя переменной (пустое для безымянных)
     Memory* owner;              // память-владелец (nullptr для безымянных)
+    uint32_t task;              // параллельная задача, создавшая объект (0 – вне задач)
 
     MemoryObject(Value value, Type wait_type, void* memory, Address address,
                  bool is_const, 
@@ -60,9 +69,24 @@ struct MemoryObject {
         : value(value), wait_type(wait_type),
           modifiers({is_const, is_static, is_final, is_global, is_private, is_shadow}),
           memory_pointer(memory), address(address),
-          var_name(name), owner(owner) {}
+          var_name(name), owner(owner), task(RuntimeContext::current().task) {
+        STAT_INC(memory_objects);
+    }
+
+    MemoryObject(const MemoryObject& other)
+        : value(other.value), wait_type(other.wait_type), modifiers(other.modifiers),
+          memory_pointer(other.memory_pointer), address(other.address),
+          var_name(other.var_name), owner(other.owner), task(RuntimeContext::current().task) {
+        STAT_INC(memory_objects);
+    }
 };
 
+// Объект создан вне текущей параллельной задачи: задача может его читать,
+// но не изменять (см. twist-parallel.cpp)
+inline bool IsSharedObject(const MemoryObject* object) {
+    return object->task != RuntimeContext::current().task;
+}
+
 inline MemoryObject* CreateMemoryObject(Value value, Type wait_type, void* memory,
                                         bool is_const, bool is_static, bool is_final, bool is_global, bool is_private, bool is_shadow,
                                         const std::string& name = "", Memory* owner = nullptr) {
@@ -81,33 +105,36 @@ inline MemoryObject* CreateMemoryObjectWithAddress(Value value, Type wait_type,
 }
 
 struct Memory {
-    std::unordered_map<std::string, MemoryObject*> string_pool;
+    std::unordered_map<Symbol, MemoryObject*> string_pool;   // ключ – интернированное имя
+
+    Memory() { STAT_INC(memories); }
 
     void clear();
     void clear_unglobals();
-    bool add_object(const std::string& literal, Value& value, Type wait_type,
+    bool add_object(Symbol literal, Value& value, Type wait_type,
                     bool is_const = false, bool is_static = false, bool is_final = false,
                     bool is_global = false, bool is_private = false, bool is_shadow = false);
-    bool add_object(const std::string& literal, MemoryObject* object);
-    bool copy_object(const std::string& literal, Value value, Type wait_type, Address address = 0,
+    bool add_object(Symbol literal, MemoryObject* object);
+    bool copy_object(Symbol literal, Value value, Type wait_type, Address address = 0,
                      bool is_const = false, bool is_static = false, bool is_final = false,
                      bool is_global = false, bool is_private = false, bool is_shadow = false);
-    bool add_object_in_lambda(const std::string& literal, Value value, bool is_global = false);
-    bool add_object_in_func(const std::string& literal, Value value, Type type,
+    bool add_object_in_lambda(Symbol literal, Value value, bool is_global = false);
+    bool add_object_in_func(Symbol literal, Value value, Type type,
                             bool is_const = false, bool is_static = false, bool is_final = false,
                             bool is_global = false, bool is_private = false, bool is_shadow = false);
-    bool add_object_in_struct(const std::string& literal, Value& value,
+    bool add_object_in_struct(Symbol literal, Value& value,
                               bool is_const = false, bool is_static = false, bool is_final = false,
                               bool is_global = false, bool is_private = false, bool is_shadow = false);
     
     
 
-    inline MemoryObject* get_variable(const std::string& literal) {
+    inline MemoryObject* get_variable(Symbol literal) {
+        STAT_INC(pool_lookups);
         auto it = string_pool.find(literal);
         return it != string_pool.end() ? it->second : nullptr;
     }
 
-    inline void set_object_value(const std::string& literal, Value new_value) {
+    inline void set_object_value(Symbol literal, Value new_value) {
         get_variable(literal)->value = new_value;
     }
 
@@ -127,60 +154,86 @@ struct Memory {
         }
     }
 
-    inline Type get_wait_type(const std::string& literal) {
+    inline Type get_wait_type(Symbol literal) {
+        STAT_INC(pool_lookups);
         return string_pool.find(literal)->second->wait_type;
     }
 
-    inline bool check_literal(const std::string& literal) {
+    inline bool check_literal(Symbol literal) {
+        STAT_INC(pool_lookups);
         return string_pool.find(literal) != string_pool.end();
     }
 
-    inline bool is_final(const std::string& literal) {
+    inline bool is_final(Symbol literal) {
+        STAT_INC(pool_lookups);
         return string_pool.find(literal)->second->modifiers.is_final;
     }
 
-    inline bool is_private(const std::string& literal) {
+    inline bool is_private(Symbol literal) {
+        STAT_INC(pool_lookups);
         return string_pool.find(literal)->second->modifiers.is_private;
     }
 
-    inline bool is_const(const std::string& literal) {
+    inline bool is_const(Symbol literal) {
+        STAT_INC(pool_lookups);
         return string_pool.find(literal)->second->modifiers.is_const;
     }
 
-    inline bool is_static(const std::string& literal) {
+    inline bool is_static(Symbol literal) {
+        STAT_INC(pool_lookups);
         return string_pool.find(literal)->second->modifiers.is_static;
     }
 
-    inline bool is_global(const std::string& name) {
+    inline bool is_global(Symbol name) {
+        STAT_INC(pool_lookups);
         return string_pool.find(name)->second->modifiers.is_global;
     }
 
-    inline bool is_shadow(const std::string& name) {
+    inline bool is_shadow(Symbol name) {
+        STAT_INC(pool_lookups);
         return string_pool.find(name)->second->modifiers.is_shadow;
     }
 
-    void delete_variable(const std::string& name);
+    void delete_variable(Symbol name);
     void debug_print();
 };
 
+// Память объявления функции или лямбды (статическая память, из которой
+// берутся глобальные имена и типы сигнатуры). В задаче spawn – её снимок,
+// сделанный при запуске задачи (см. twist-tasks.cpp).
+inline Memory* DeclarationMemory(Memory* memory) {
+    auto memories = RuntimeContext::current().memories;
+    if (!memories) return memory;
+    auto it = memories->find(memory);
+    return it != memories->end() ? it->second : memory;
+}
+
+// Реестр объектов по адресу – в контексте текущего запуска. Часть parallel
+// for регистрирует объекты в своём контексте, а ищет и во внешних.
 struct GlobalMemory {
-    static std::unordered_map<int, MemoryObject*> all_objects;
+    static std::unordered_map<int, MemoryObject*>& all_objects() {
+        return RuntimeContext::current().objects;
+    }
 
     static void register_object(MemoryObject* obj) {
-        all_objects[obj->address] = obj;
+        STAT_INC(static_registrations);
+        all_objects()[obj->address] = obj;
     }
 
     static bool is_registered(int address) {
-        return all_objects.find(address) != all_objects.end();
+        return get_by_address(address) != nullptr;
     }
 
     static void unregister_object(int address) {
-        all_objects.erase(address);
+        all_objects().erase(address);
     }
 
     static MemoryObject* get_by_address(int address) {
-        auto it = all_objects.find(address);
-        return it != all_objects.end() ? it->second : nullptr;
+        for (auto context = &RuntimeContext::current(); context; context = context->reads_parent ? context->parent : nullptr) {
+            auto it = context->objects.find(address);
+            if (it != context->objects.end()) return it->second;
+        }
+        return nullptr;
     }
 
     void set_object_value(int address, Value new_value) {
@@ -194,16 +247,21 @@ struct GlobalMemory {
     static void clear() {
         // НЕ удаляем объекты здесь, только очищаем карту
         // Объекты уже удалены деструктором Memory
-        all_objects.clear();
+        all_objects().clear();
     }
 };
 
-// Определение статической переменной
-std::unordered_map<int, MemoryObject*> GlobalMemory::all_objects;
-
 // Глобальный объект (определён после объявления GlobalMemory)
 static GlobalMemory STATIC_MEMORY;
 
+// Удаление объектов, оставшихся в реестре контекста: по окончании запуска
+// они больше никому не принадлежат
+void ReleaseObjects(RuntimeContext& context) {
+    for (auto& [address, object] : context.objects)
+        delete object;
+    context.objects.clear();
+}
+
 
 void Memory::clear() {
     string_pool.clear();
@@ -219,13 +277,13 @@ void Memory::clear_unglobals() {
     }
 }
 
-bool Memory::add_object(const std::string& literal, Value& value, Type wait_type,
+bool Memory::add_object(Symbol literal, Value& value, Type wait_type,
                         bool is_const, bool is_static, bool is_final,
                         bool is_global, bool is_private, bool is_shadow) {
     try {
         auto object = CreateMemoryObject(value, wait_type, this,
                                          is_const, is_static, is_final, is_global, is_private, is_shadow,
-                                         literal, this);
+                                         literal.name(), this);
         string_pool.emplace(literal, object);
         STATIC_MEMORY.register_object(object);
         return true;
@@ -234,7 +292,7 @@ bool Memory::add_object(const std::string& literal, Value& value, Type wait_type
     }
 }
 
-bool Memory::add_object(const std::string& literal, MemoryObject* object) {
+bool Memory::add_object(Symbol literal, MemoryObject* object) {
     try {
         string_pool.emplace(literal, object);
         // Предполагаем, что object уже зарегистрирован в STATIC_MEMORY
@@ -244,13 +302,13 @@ bool Memory::add_object(const std::string& literal, MemoryObject* object) {
     }
 }
 
-bool Memory::copy_object(const std::string& literal, Value value, Type wait_type, Address address,
+bool Memory::copy_object(Symbol literal, Value value, Type wait_type, Address address,
                          bool is_const, bool is_static, bool is_final,
                          bool is_global, bool is_private, bool is_shadow) {
     try {
         auto object = CreateMemoryObjectWithAddress(value, wait_type, this, address,
                                                     is_const, is_static, is_final, is_global, is_private, is_shadow,
-                                                    literal, this);
+                                                    literal.name(), this);
         string_pool.emplace(literal, object);
         STATIC_MEMORY.register_object(object);
         return true;
@@ -259,10 +317,10 @@ bool Memory::copy_object(const std::string& literal, Value value, Type wait_type
     }
 }
 
-bool Memory::add_object_in_lambda(const std::string& literal, Value value, bool is_global) {
+bool Memory::add_object_in_lambda(Symbol literal, Value value, bool is_global) {
     auto object = new MemoryObject(value, value.type, this, 0,
                                    false, true, false, is_global, false, false,
-                                   literal, this);
+                                   literal.name(), this);
     if (check_literal(literal)) delete_variable(literal);
     try {
         string_pool.emplace(literal, object);
@@ -273,12 +331,12 @@ bool Memory::add_object_in_lambda(const std::string& literal, Value value, bool
     }
 }
 
-bool Memory::add_object_in_func(const std::string& literal, Value value, Type type,
+bool Memory::add_object_in_func(Symbol literal, Value value, Type type,
                                 bool is_const, bool is_static, bool is_final,
                                 bool is_global, bool is_private, bool is_shadow) {
     auto object = new MemoryObject(value, type, this, 0,
                                    is_const, is_static, is_final, is_global, is_private, is_shadow,
-                                   literal, this);
+                                   literal.name(), this);
     if (check_literal(literal)) delete_variable(literal);
     try {
         string_pool.emplace(literal, object);
@@ -289,12 +347,12 @@ bool Memory::add_object_in_func(const std::string& literal, Value value, Type ty
     }
 }
 
-bool Memory::add_object_in_struct(const std::string& literal, Value& value,
+bool Memory::add_object_in_struct(Symbol literal, Value& value,
                                   bool is_const, bool is_static, bool is_final,
                                   bool is_global, bool is_private, bool is_shadow) {
     auto object = new MemoryObject(value, value.type, this, 0,
                                    is_const, is_static, is_final, is_global, is_private, is_shadow,
-                                   literal, this);
+                                   literal.name(), this);
     if (check_literal(literal)) delete_variable(literal);
     try {
         string_pool.emplace(literal, object);
@@ -305,7 +363,7 @@ bool Memory::add_object_in_struct(const std::string& literal, Value& value,
     }
 }
 
-void Memory::delete_variable(const std::string& name) {
+void Memory::delete_variable(Symbol name) {
     auto it = string_pool.find(name);
     if (it != string_pool.end()) {
         MemoryObject* obj = it->second;
@@ -318,7 +376,7 @@ void Memory::delete_variable(const std::string& name) {
 void Memory::debug_print() {
     std::cout << "Memory Dump:" << std::endl;
     for (const auto& [name, obj] : string_pool) {
-        std::cout << "\tVariable Name: " << name << ", Type: " << obj->value.type.pool;
+        std::cout << "\tVariable Name: " << name.name() << ", Type: " << obj->value.type.pool;
         try {
             if (obj->value.type.pool == STANDART_TYPE::INT.pool) {
                 std::cout << ", Value: " << std::any_cast<int64_t>(obj->value.data);
@@ -327,7 +385,7 @@ void Memory::debug_print() {
             } else if (obj->value.type.pool == STANDART_TYPE::BOOL.pool) {
                 std::cout << ", Value: " << (std::any_cast<bool>(obj->value.data) ? "true" : "false");
             } else if (obj->value.type.pool == STANDART_TYPE::STRING.pool) {
-                std::cout << ", Value: " << std::any_cast<std::string>(obj->value.data);
+                std::cout << ", Value: " << std::any_cast<const RuntimeString&>(obj->value.data);
             }
         } catch (...) {
             std::cout << ", Value: <bad cast>";
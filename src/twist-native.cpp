@@ -0,0 +1,121 @@
+#include "twist-values.cpp"
+#include "twist-tokens.cpp"
+#include "twist-symbols.cpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#pragma once
+
+/*
+ * NativeFunction – функция, реализованная на C++ и вызываемая из Lumen.
+ *
+ * Значение Lumen с типом STANDART_TYPE::NATIVE хранит указатель на
+ * NativeFunction; NodeCall вычисляет аргументы, проверяет их число и типы по
+ * объявленной сигнатуре и вызывает body напрямую, по указателю. Исключение
+ * std::exception из body превращается в ошибку Lumen в месте вызова, Error
+ * пробрасывается как есть.
+ *
+ * Объект NativeFunction принадлежит тому, кто его зарегистрировал
+ * (NativeRegistry, lumen::Program), и должен жить, пока выполняются
+ * использующие его программы. body может вызываться из нескольких потоков
+ * одновременно.
+ *
+ * Поля:
+ *   name       – имя (для сообщений об ошибках и вывода).
+ *   arity      – число аргументов, -1 – любое (проверяет сам body).
+ *   parameters – объявленные типы аргументов (auto – любой); пусто – без
+ *                проверки типов.
+ *   body       – реализация.
+ *   data       – произвольные данные регистратора, передаются в body.
+ *   pure       – результат зависит только от аргументов (для memo, см.
+ *                twist-purity.cpp).
+ */
+
+struct Memory;
+
+// Один вызов нативной функции
+struct NativeCall {
+    const Value& callee;        // вызываемое значение (функция или тип)
+    vector<Value>& args;        // вычисленные аргументы
+    Memory* memory;             // память места вызова
+    const Token& start;         // границы вызова – для сообщений об ошибках
+    const Token& end;
+};
+
+using NativeBody = Value (*)(NativeCall& call, void* data);
+
+struct NativeFunction {
+    string name;
+    int arity;
+    vector<Type> parameters;
+    NativeBody body;
+    void* data = nullptr;
+    bool pure = false;
+};
+
+Value NewNative(NativeFunction* native) {
+    return Value(STANDART_TYPE::NATIVE, native);
+}
+
+/*
+ * NativeRegistry – встроенные нативные функции процесса.
+ *
+ * functions    – свободные функции (sqrt, len, ...) и встроенные имена типов
+ *                (Future, Channel). Они не занимают адресов в Memory:
+ *                NodeLiteral ищет имя здесь, только если его нет в памяти
+ *                программы, поэтому любое объявление в программе перекрывает
+ *                встроенное имя.
+ * constructors – вызов типа как функции: String(x), Int(x), ptr(a, T),
+ *                Map(), Set(); array_constructor – для [T](m).
+ *
+ * Заполняется при статической инициализации (twist-builtins.cpp) и после
+ * этого только читается, поэтому доступ без блокировок.
+ */
+
+struct NativeRegistry {
+    static unordered_map<Symbol, Value>& functions() {
+        static unordered_map<Symbol, Value> table;
+        return table;
+    }
+
+    static unordered_map<string, NativeFunction*>& constructors() {
+        static unordered_map<string, NativeFunction*> table;
+        return table;
+    }
+
+    static NativeFunction*& array_constructor() {
+        static NativeFunction* native = nullptr;
+        return native;
+    }
+
+    static bool define(NativeFunction* native) {
+        functions().insert_or_assign(Symbol(native->name), NewNative(native));
+        return true;
+    }
+
+    static bool define_name(const string& name, const Value& value) {
+        functions().insert_or_assign(Symbol(name), value);
+        return true;
+    }
+
+    static bool define_constructor(const string& type, NativeFunction* native) {
+        constructors()[type] = native;
+        return true;
+    }
+
+    static const Value* find(Symbol symbol) {
+        auto& table = functions();
+        auto it = table.find(symbol);
+        return it == table.end() ? nullptr : &it->second;
+    }
+
+    static NativeFunction* constructor(const Type& type) {
+        if (type.is_array_type())
+            return array_constructor();
+        auto& table = constructors();
+        auto it = table.find(type.pool);
+        return it == table.end() ? nullptr : it->second;
+    }
+};
@@ -53,11 +53,22 @@
     _(NODE_EXIT) \
     _(NODE_ARRAY_TYPE) \
     _(NODE_ARRAY) \
+    _(NODE_MAP) \
     _(NODE_GET_BY_INDEX) \
     _(NODE_ARRAY_PUSH) \
     _(NODE_OBJECT_RESOLUTION) \
     _(NODE_STRUCT_DECLARATION) \
-    _(NODE_ECHO)
+    _(NODE_ECHO) \
+    _(NODE_PROFILE) \
+    _(NODE_PARALLEL_FOR) \
+    _(NODE_SPAWN) \
+    _(NODE_AWAIT) \
+    _(NODE_YIELD) \
+    _(NODE_FOR_IN) \
+    _(NODE_INCREMENT_LOCAL) \
+    _(NODE_COMPARE_LOCAL) \
+    _(NODE_PUSH_LOCAL) \
+    _(NODE_ADD_LOCAL)
 
 // Enum
 enum NodeTypes {
@@ -0,0 +1,517 @@
+#include "twist-parser.cpp"
+#pragma once
+
+/*
+ * ASTOptimizer – проход оптимизации AST после ASTGenerator::parse().
+ *
+ * Выполняет три преобразования:
+ *   1. Свёртка констант: NodeBinary / NodeUnary, все операнды которых являются
+ *      литералами (NodeNumber, NodeString, NodeBool, NodeChar, NodeNull),
+ *      вычисляются один раз и заменяются готовым литералом. Для && / || с
+ *      константной левой частью учитывается короткое замыкание.
+ *   2. Удаление мёртвых ветвей: if / if-выражения с константным условием
+ *      заменяются выбранной ветвью, while с ложным условием – пустым блоком.
+ *   3. Снятие обёрток NodeScopes в позициях значений.
+ *   4. Слияние частых шаблонов в специализированные узлы (Nodes/NodeFused.cpp):
+ *      `x = x + 1;` → NodeIncrementLocal, `i < n` → NodeCompareLocal,
+ *      `arr <- v;` → NodePushLocal, `x = x + expr;` → NodeAddLocal. Исходный
+ *      узел сохраняется в слитом как запасной путь. Позиции слитых операторов
+ *      для --profile переносятся на новый узел (statement_positions).
+ *
+ * Свёртка выполняется вызовом eval_from() самого узла, поэтому семантика
+ * (в том числе точность Double) совпадает с обычным исполнением. Если
+ * вычисление бросает исключение, узел остаётся как есть – ошибка будет
+ * выброшена во время выполнения с исходными позициями. Деление и остаток
+ * на ноль не сворачиваются: ERROR::ZeroDivision завершает программу.
+ *
+ * Позиции, где важен тип узла (левая часть присваивания, цель delete,
+ * операнд &, левая часть <-, вызываемое выражение, выражения типов),
+ * только обходятся, но сам узел в них не заменяется.
+ */
+
+// Максимальная длина строки, получаемой свёрткой повторения ("ab" * n)
+#define MAX_FOLDED_STRING 4096
+
+struct ASTOptimizer {
+    Memory scratch_memory;
+
+    size_t folded = 0;
+    size_t pruned = 0;
+    size_t unwrapped = 0;
+    size_t fused = 0;
+
+    // Позиции операторов для --profile (ASTGenerator::statement_positions)
+    unordered_map<Node*, PosInFile>* statement_positions = nullptr;
+
+    void optimize(vector<Node*>& nodes) {
+        for (auto& node : nodes)
+            node = visit(node);
+    }
+
+    static bool IsConstant(Node* node) {
+        if (!node) return false;
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_NUMBER:
+            case NodeTypes::NODE_STRING:
+            case NodeTypes::NODE_BOOL:
+            case NodeTypes::NODE_CHAR:
+            case NodeTypes::NODE_NULL:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Значение условия для if / while. Возвращает false, если значение нельзя
+    // однозначно привести к bool без выполнения (например, Double в NodeIf).
+    static bool ConstantCondition(const Value& value, bool& condition) {
+        if (value.type == STANDART_TYPE::BOOL) {
+            condition = any_cast<bool>(value.data);
+            return true;
+        }
+        if (value.type == STANDART_TYPE::INT) {
+            condition = any_cast<int64_t>(value.data) != 0;
+            return true;
+        }
+        return false;
+    }
+
+    // Создание литерала из вычисленного значения. nullptr – тип не поддерживается.
+    static Node* MakeLiteral(const Value& value, const Token& pos) {
+        if (value.type == STANDART_TYPE::INT || value.type == STANDART_TYPE::DOUBLE)
+            return new NodeNumber(value);
+        if (value.type == STANDART_TYPE::STRING) {
+            return new NodeString(any_cast<const RuntimeString&>(value.data));
+        }
+        if (value.type == STANDART_TYPE::BOOL) {
+            Token token = pos;
+            token.value = any_cast<bool>(value.data) ? "true" : "false";
+            return new NodeBool(token);
+        }
+        if (value.type == STANDART_TYPE::CHAR)
+            return new NodeChar(any_cast<char>(value.data));
+        if (value.type == STANDART_TYPE::NULL_T)
+            return new NodeNull();
+        return nullptr;
+    }
+
+    static bool IsZero(Node* node) {
+        if (node->NODE_TYPE != NodeTypes::NODE_NUMBER) return false;
+        const Value& value = ((NodeNumber*)node)->value;
+        if (value.type == STANDART_TYPE::INT)
+            return any_cast<int64_t>(value.data) == 0;
+        return any_cast<NUMBER_ACCURACY>(value.data) == 0;
+    }
+
+    // Операции, которые небезопасно выполнять во время свёртки
+    static bool IsUnsafeBinary(NodeBinary* node) {
+        if ((node->op == "/" || node->op == "%") && IsZero(node->right))
+            return true;
+        if (node->op == "*" && (node->left->NODE_TYPE == NodeTypes::NODE_STRING ||
+                                node->left->NODE_TYPE == NodeTypes::NODE_CHAR) &&
+            node->right->NODE_TYPE == NodeTypes::NODE_NUMBER) {
+            const Value& count = ((NodeNumber*)node->right)->value;
+            if (count.type != STANDART_TYPE::INT) return false;
+            size_t unit = node->left->NODE_TYPE == NodeTypes::NODE_STRING ?
+                any_cast<const RuntimeString&>(((NodeString*)node->left)->value.data).size() : 1;
+            return unit * any_cast<int64_t>(count.data) > MAX_FOLDED_STRING;
+        }
+        return false;
+    }
+
+    static bool IsShortCircuit(NodeBinary* node) {
+        if (node->left->NODE_TYPE != NodeTypes::NODE_BOOL) return false;
+        bool l = any_cast<bool>(((NodeBool*)node->left)->value.data);
+        if (node->op == "||" || node->op == "or") return l;
+        if (node->op == "&&" || node->op == "and") return !l;
+        return false;
+    }
+
+    // Попытка вычислить узел заранее. При любой ошибке узел остаётся прежним.
+    Node* fold(Node* node, const Token& pos) {
+        Value value = NewNull();
+        try {
+            value = node->eval_from(&scratch_memory);
+        } catch (...) {
+            return node;
+        }
+        Node* literal = MakeLiteral(value, pos);
+        if (!literal) return node;
+        folded++;
+        return literal;
+    }
+
+    static bool IsName(Node* node, Symbol symbol) {
+        return node->NODE_TYPE == NodeTypes::NODE_LITERAL && ((NodeLiteral*)node)->symbol == symbol;
+    }
+
+    static bool IsIntConstant(Node* node, int64_t& value) {
+        if (node->NODE_TYPE != NodeTypes::NODE_NUMBER || ((NodeNumber*)node)->value.type != STANDART_TYPE::INT)
+            return false;
+        value = any_cast<int64_t>(((NodeNumber*)node)->value.data);
+        return true;
+    }
+
+    // Замена оператора слитым узлом с переносом позиции для --profile
+    Node* replaceStatement(Node* node, Node* fused_node) {
+        fused++;
+        if (statement_positions) {
+            auto it = statement_positions->find(node);
+            if (it != statement_positions->end()) {
+                (*statement_positions)[fused_node] = it->second;
+                statement_positions->erase(it);
+            }
+        }
+        return fused_node;
+    }
+
+    // i < n, i != 10 → NodeCompareLocal
+    Node* fuseCompare(NodeBinary* binary) {
+        NodeCompareLocal::Operation operation;
+        if (binary->left->NODE_TYPE != NodeTypes::NODE_LITERAL ||
+            !NodeCompareLocal::ParseOperation(binary->op, operation))
+            return binary;
+        Symbol left = ((NodeLiteral*)binary->left)->symbol;
+        int64_t constant = 0;
+        if (binary->right->NODE_TYPE == NodeTypes::NODE_LITERAL) {
+            fused++;
+            return new NodeCompareLocal(left, ((NodeLiteral*)binary->right)->symbol, 0, false, operation, binary);
+        }
+        if (IsIntConstant(binary->right, constant)) {
+            fused++;
+            return new NodeCompareLocal(left, Symbol(), constant, true, operation, binary);
+        }
+        return binary;
+    }
+
+    // x = x + 1; → NodeIncrementLocal, x = x + expr; → NodeAddLocal
+    Node* fuseAssignment(NodeVariableEqual* equal) {
+        if (equal->variable->NODE_TYPE != NodeTypes::NODE_LITERAL ||
+            equal->expression->NODE_TYPE != NodeTypes::NODE_BINARY)
+            return equal;
+        Symbol symbol = ((NodeLiteral*)equal->variable)->symbol;
+        auto binary = (NodeBinary*)equal->expression;
+        if ((binary->op != "+" && binary->op != "-") || !IsName(binary->left, symbol))
+            return equal;
+        int64_t step = 0;
+        if (IsIntConstant(binary->right, step))
+            return replaceStatement(equal, new NodeIncrementLocal(symbol, binary->op == "-" ? -step : step, equal));
+        return replaceStatement(equal, new NodeAddLocal(symbol, binary, equal));
+    }
+
+    // arr <- v; → NodePushLocal
+    Node* fusePush(NodeExpressionStatement* statement) {
+        if (statement->expr->NODE_TYPE != NodeTypes::NODE_ARRAY_PUSH)
+            return statement;
+        auto push = (NodeArrayPush*)statement->expr;
+        if (push->left_expr->NODE_TYPE != NodeTypes::NODE_LITERAL)
+            return statement;
+        return replaceStatement(statement, new NodePushLocal(((NodeLiteral*)push->left_expr)->symbol, push));
+    }
+
+    Node* replaceWithEmpty() {
+        vector<Node*> empty;
+        return new NodeBlock(empty);
+    }
+
+    // Обход узла с возможной заменой на эквивалентный
+    Node* visit(Node* node) {
+        if (!node) return node;
+
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_SCOPES: {
+                auto scopes = (NodeScopes*)node;
+                Node* inner = visit(scopes->expression);
+                unwrapped++;
+                delete scopes;
+                return inner;
+            }
+            case NodeTypes::NODE_BINARY: {
+                auto binary = (NodeBinary*)node;
+                if (binary->op == "<-")
+                    walk(binary->left);
+                else
+                    binary->left = visit(binary->left);
+                binary->right = visit(binary->right);
+
+                if (!IsConstant(binary->left))
+                    return fuseCompare(binary);
+                if (IsShortCircuit(binary) || (IsConstant(binary->right) && !IsUnsafeBinary(binary)))
+                    return fold(node, binary->start_token);
+                return node;
+            }
+            case NodeTypes::NODE_VARIABLE_EQUAL:
+                walk(node);
+                return fuseAssignment((NodeVariableEqual*)node);
+            case NodeTypes::NODE_EXPRESSION_STATEMENT:
+                walk(node);
+                return fusePush((NodeExpressionStatement*)node);
+            case NodeTypes::NODE_UNARY: {
+                auto unary = (NodeUnary*)node;
+                unary->operand = visit(unary->operand);
+                if (IsConstant(unary->operand))
+                    return fold(node, unary->start);
+                return node;
+            }
+            case NodeTypes::NODE_IF: {
+                auto if_node = (NodeIf*)node;
+                if_node->expr = visit(if_node->expr);
+                if_node->true_body = visit(if_node->true_body);
+                if_node->else_body = visit(if_node->else_body);
+
+                bool condition;
+                if (IsConstant(if_node->expr) && ConstantCondition(if_node->expr->eval_from(&scratch_memory), condition)) {
+                    if (condition && !if_node->true_body) return node;
+                    pruned++;
+                    if (condition) return if_node->true_body;
+                    if (if_node->else_body) return if_node->else_body;
+                    return replaceWithEmpty();
+                }
+                return node;
+            }
+            case NodeTypes::NODE_IF_EXPRESSION: {
+                auto if_expr = (NodeIfExpr*)node;
+                if_expr->expr = visit(if_expr->expr);
+                if_expr->true_expr = visit(if_expr->true_expr);
+                if_expr->else_expr = visit(if_expr->else_expr);
+
+                bool condition;
+                if (IsConstant(if_expr->expr) && ConstantCondition(if_expr->expr->eval_from(&scratch_memory), condition)) {
+                    pruned++;
+                    if (condition) return if_expr->true_expr;
+                    if (if_expr->else_expr) return if_expr->else_expr;
+                    return new NodeNull();
+                }
+                return node;
+            }
+            case NodeTypes::NODE_WHILE: {
+                auto while_node = (NodeWhile*)node;
+                while_node->condition = visit(while_node->condition);
+                while_node->body = visit(while_node->body);
+
+                bool condition;
+                if (IsConstant(while_node->condition) &&
+                    ConstantCondition(while_node->condition->eval_from(&scratch_memory), condition) && !condition) {
+                    pruned++;
+                    return replaceWithEmpty();
+                }
+                return node;
+            }
+            default:
+                walk(node);
+                return node;
+        }
+    }
+
+    // Обход дочерних узлов без замены самого узла
+    void walk(Node* node) {
+        if (!node) return;
+
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_SCOPES: {
+                auto scopes = (NodeScopes*)node;
+                scopes->expression = visit(scopes->expression);
+                break;
+            }
+            case NodeTypes::NODE_BINARY: {
+                auto binary = (NodeBinary*)node;
+                walk(binary->left);
+                binary->right = visit(binary->right);
+                break;
+            }
+            case NodeTypes::NODE_BLOCK_OF_NODES: {
+                for (auto& child : ((NodeBlock*)node)->nodes_array)
+                    child = visit(child);
+                break;
+            }
+            case NodeTypes::NODE_BLOCK_OF_DECLARATIONS: {
+                for (auto decl : ((NodeBlockDecl*)node)->decls)
+                    walk(decl);
+                break;
+            }
+            case NodeTypes::NODE_OUT: {
+                for (auto& expr : ((NodeBaseOut*)node)->expression)
+                    expr = visit(expr);
+                break;
+            }
+            case NodeTypes::NODE_OUTLN: {
+                for (auto& expr : ((NodeBaseOutLn*)node)->expression)
+                    expr = visit(expr);
+                break;
+            }
+            case NodeTypes::NODE_ECHO: {
+                for (auto& expr : ((NodeEcho*)node)->expressions)
+                    expr = visit(expr);
+                break;
+            }
+            case NodeTypes::NODE_EXPRESSION_STATEMENT: {
+                auto statement = (NodeExpressionStatement*)node;
+                statement->expr = visit(statement->expr);
+                break;
+            }
+            case NodeTypes::NODE_RETURN: {
+                auto ret = (NodeReturn*)node;
+                ret->expr = visit(ret->expr);
+                break;
+            }
+            case NodeTypes::NODE_EXIT: {
+                auto exit_node = (NodeExit*)node;
+                exit_node->expr = visit(exit_node->expr);
+                break;
+            }
+            case NodeTypes::NODE_ASSERT: {
+                auto assert_node = (NodeAssert*)node;
+                assert_node->expr = visit(assert_node->expr);
+                assert_node->message_expr = visit(assert_node->message_expr);
+                break;
+            }
+            case NodeTypes::NODE_DO_WHILE: {
+                auto do_while = (NodeDoWhile*)node;
+                do_while->condition = visit(do_while->condition);
+                walk(do_while->body);
+                break;
+            }
+            case NodeTypes::NODE_FOR: {
+                auto for_node = (NodeFor*)node;
+                walk(for_node->start_state);
+                for_node->condition = visit(for_node->condition);
+                for_node->update_state = visit(for_node->update_state);
+                for_node->body = visit(for_node->body);
+                break;
+            }
+            case NodeTypes::NODE_PARALLEL_FOR: {
+                auto parallel = (NodeParallelFor*)node;
+                parallel->from = visit(parallel->from);
+                parallel->to = visit(parallel->to);
+                parallel->body = visit(parallel->body);
+                break;
+            }
+            case NodeTypes::NODE_FOR_IN: {
+                auto loop = (NodeForIn*)node;
+                loop->iterable = visit(loop->iterable);
+                loop->range_end = visit(loop->range_end);
+                loop->body = visit(loop->body);
+                break;
+            }
+            case NodeTypes::NODE_YIELD: {
+                auto yield = (NodeYield*)node;
+                yield->expr = visit(yield->expr);
+                break;
+            }
+            case NodeTypes::NODE_SPAWN:
+                walk(((NodeSpawn*)node)->call);
+                break;
+            case NodeTypes::NODE_AWAIT: {
+                auto await = (NodeAwait*)node;
+                await->expr = visit(await->expr);
+                break;
+            }
+            case NodeTypes::NODE_VARIABLE_DECLARATION: {
+                auto decl = (NodeVariableDeclaration*)node;
+                decl->value_expr = visit(decl->value_expr);
+                break;
+            }
+            case NodeTypes::NODE_VARIABLE_EQUAL: {
+                auto equal = (NodeVariableEqual*)node;
+                walk(equal->variable);
+                equal->expression = visit(equal->expression);
+                break;
+            }
+            case NodeTypes::NODE_FUNCTION_DECLARATION: {
+                auto func = (NodeFunctionDeclaration*)node;
+                for (auto arg : func->args)
+                    arg->default_parameter = visit(arg->default_parameter);
+                walk(func->body);
+                break;
+            }
+            case NodeTypes::NODE_LAMBDA: {
+                auto lambda = (NodeLambda*)node;
+                for (auto arg : lambda->args)
+                    arg->default_parameter = visit(arg->default_parameter);
+                walk(lambda->body);
+                break;
+            }
+            case NodeTypes::NODE_NAMESPACE_DECLARATION:
+                walk(((NodeNamespaceDeclaration*)node)->statement);
+                break;
+            case NodeTypes::NODE_NAMESPACE_EXPRESSION:
+                walk(((NodeNamespace*)node)->statement);
+                break;
+            case NodeTypes::NODE_STRUCT_DECLARATION:
+                walk(((NodeStructDeclaration*)node)->body);
+                break;
+            case NodeTypes::NODE_CALL: {
+                auto call = (NodeCall*)node;
+                walk(call->callable);
+                for (auto& arg : call->args)
+                    arg = visit(arg);
+                break;
+            }
+            case NodeTypes::NODE_ARRAY: {
+                for (auto& element : ((NodeArray*)node)->elements)
+                    get<0>(element) = visit(get<0>(element));
+                break;
+            }
+            case NodeTypes::NODE_MAP: {
+                auto map = (NodeMap*)node;
+                for (auto& key : map->keys)
+                    get<0>(key) = visit(get<0>(key));
+                for (auto& value : map->values)
+                    value = visit(value);
+                break;
+            }
+            case NodeTypes::NODE_GET_BY_INDEX: {
+                auto index = (NodeGetIndex*)node;
+                walk(index->expr);
+                index->index_expr = visit(index->index_expr);
+                break;
+            }
+            case NodeTypes::NODE_ARRAY_PUSH: {
+                auto push = (NodeArrayPush*)node;
+                walk(push->left_expr);
+                push->right_expr = visit(push->right_expr);
+                break;
+            }
+            case NodeTypes::NODE_INPUT: {
+                auto input = (NodeInput*)node;
+                input->expr = visit(input->expr);
+                break;
+            }
+            case NodeTypes::NODE_NEW: {
+                auto new_node = (NodeNew*)node;
+                new_node->expr = visit(new_node->expr);
+                break;
+            }
+            case NodeTypes::NODE_DEREFERENCE: {
+                auto deref = (NodeDereference*)node;
+                deref->expr = visit(deref->expr);
+                break;
+            }
+            case NodeTypes::NODE_TYPEOF: {
+                auto type_of = (NodeTypeof*)node;
+                type_of->expr = visit(type_of->expr);
+                break;
+            }
+            case NodeTypes::NODE_SIZEOF: {
+                auto size_of = (NodeSizeof*)node;
+                size_of->expr = visit(size_of->expr);
+                break;
+            }
+            case NodeTypes::NODE_ADDRESS_OF:
+                walk(((NodeAddressOf*)node)->expr);
+                break;
+            case NodeTypes::NODE_DELETE:
+                walk(((NodeDelete*)node)->target);
+                break;
+            case NodeTypes::NODE_OBJECT_RESOLUTION:
+                walk(((NodeObjectResolution*)node)->obj_expr);
+                break;
+            case NodeTypes::NODE_NAME_RESOLUTION:
+                walk(((NodeNamespaceResolution*)node)->namespace_expr);
+                break;
+            default:
+                // Литералы, break/continue, выражения типов – без изменений
+                break;
+        }
+    }
+};
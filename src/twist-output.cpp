@@ -0,0 +1,162 @@
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include "twist-context.cpp"
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+#pragma once
+
+/*
+ * OutputBuffer – буфер вывода программы (out, outln, приглашение input).
+ *
+ * Вывод копится в буфере OUTPUT_BUFFER_SIZE байт и отдаётся целым блоком:
+ * в std::cout (по умолчанию) или напрямую в файловый дескриптор (-out-fd).
+ * Числа форматируются через std::to_chars – без iostream и фасетов локали
+ * (main устанавливает глобальную локаль ru_RU.UTF-8, а вывод Lumen должен
+ * оставаться с точкой в дробных числах).
+ *
+ * Буфер сбрасывается явно:
+ *   - перед чтением input (чтобы приглашение было видно);
+ *   - перед exit и выводом ошибки;
+ *   - по окончании программы;
+ *   - при заполнении.
+ * Если вывод идёт в терминал, outln дополнительно сбрасывает буфер на каждой
+ * строке – интерактивное поведение не меняется.
+ *
+ * Состояние буфера (OutputState) принадлежит контексту текущего запуска:
+ *   fd            – дескриптор для прямой записи, -1 – через std::cout.
+ *   line_buffered – сбрасывать на каждом переводе строки.
+ *   capture       – строка, в которую собирается вывод (Interpreter).
+ */
+
+// Размер буфера вывода (байт)
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+struct OutputBuffer {
+    static OutputState& state() {
+        auto& output = RuntimeContext::current().output;
+        if (output.data.empty()) output.data.resize(OUTPUT_BUFFER_SIZE);
+        return output;
+    }
+
+    // Настройка приёмника: fd >= 0 – прямая запись в дескриптор
+    static void attach(int target_fd) {
+        flush();
+        auto& output = state();
+        output.fd = target_fd;
+        #ifdef _WIN32
+            output.line_buffered = _isatty(target_fd >= 0 ? target_fd : 1);
+        #else
+            output.line_buffered = isatty(target_fd >= 0 ? target_fd : 1);
+        #endif
+    }
+
+    static void write(const char* str, size_t length) {
+        auto& output = state();
+        if (length > OUTPUT_BUFFER_SIZE - output.size) {
+            flush();
+            if (length >= OUTPUT_BUFFER_SIZE) {
+                write_through(str, length);
+                return;
+            }
+        }
+        memcpy(output.data.data() + output.size, str, length);
+        output.size += length;
+    }
+
+    static void write(const std::string& str) {
+        write(str.data(), str.size());
+    }
+
+    static void put(char c) {
+        auto& output = state();
+        if (output.size == OUTPUT_BUFFER_SIZE) flush();
+        output.data[output.size++] = c;
+    }
+
+    static void write_int(int64_t value) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        write(buffer, result.ptr - buffer);
+    }
+
+    // Как %.{max_digits10}Lg, но без зависимости от локали
+    static void write_double(long double value) {
+        char buffer[64];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general,
+                                    std::numeric_limits<long double>::max_digits10);
+        write(buffer, result.ptr - buffer);
+    }
+
+    static void newline() {
+        put('\n');
+        if (state().line_buffered) flush();
+    }
+
+    static void flush() {
+        auto& output = state();
+        if (!output.size) return;
+        write_through(output.data.data(), output.size);
+        output.size = 0;
+    }
+
+    static void write_through(const char* str, size_t length) {
+        auto& output = state();
+        if (output.capture) {
+            output.capture->append(str, length);
+            return;
+        }
+        if (output.fd < 0) {
+            std::cout.rdbuf()->sputn(str, (std::streamsize)length);
+            std::cout.flush();
+            return;
+        }
+        // Служебный вывод через cout должен оказаться раньше вывода программы
+        std::cout.flush();
+        while (length) {
+            #ifdef _WIN32
+                auto written = _write(output.fd, str, (unsigned)length);
+            #else
+                auto written = ::write(output.fd, str, length);
+            #endif
+            if (written <= 0) return;
+            str += written;
+            length -= (size_t)written;
+        }
+    }
+};
+
+// Поток для сообщений об ошибках текущего запуска. Буфер вывода
+// сбрасывается заранее: сообщение идёт после уже выведенного программой.
+inline std::ostream& DiagnosticStream() {
+    OutputBuffer::flush();
+    auto stream = RuntimeContext::current().diagnostics;
+    return stream ? *stream : std::cout;
+}
+
+// Завершение программы (exit, фатальная ошибка). Вывод из буфера не
+// теряется. Внутри привязанного контекста процесс не завершается –
+// ProgramExit раскручивает стек до Interpreter::run, остальные программы
+// продолжают работу.
+[[noreturn]] inline void ExitProgram(int code) {
+    OutputBuffer::flush();
+    if (RuntimeContext::bound())
+        throw ProgramExit{code, false};
+    exit(code);
+}
+
+[[noreturn]] inline void ExitOnError(int code) {
+    OutputBuffer::flush();
+    if (RuntimeContext::bound())
+        throw ProgramExit{code, true};
+    exit(code);
+}
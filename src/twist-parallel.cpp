@@ -0,0 +1,349 @@
+#include "twist-context.cpp"
+#include "twist-memory.cpp"
+#include "twist-output.cpp"
+#include "twist-stack.cpp"
+#include "twist-profiler.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#pragma once
+
+/*
+ * Параллельное выполнение частей диапазона – основа parallel for и pmap.
+ *
+ * ParallelFor(count, body) делит [0, count) на части и вызывает
+ * body(begin, end) для каждой в пуле потоков WorkerPool. Вызывающий поток
+ * не простаивает: пока части не закончены, он выполняет их сам.
+ *
+ * WorkerPool – потоки с перехватом работы (work stealing): у каждого потока
+ * своя очередь частей; свою очередь поток разбирает с конца, а когда она
+ * пуста – забирает части из начала чужих. Последняя очередь – общая для
+ * потоков вне пула (основной поток lumenc, потоки lumen::Context). Потоки
+ * пула создаются при первом параллельном цикле и живут до конца процесса.
+ *
+ * Изоляция части. Каждая часть выполняется в своём RuntimeContext с parent –
+ * контекстом вызывающего и новым номером задачи task:
+ *   - объекты, созданные частью, регистрируются в её контексте; адреса
+ *     берутся блоками из общего счётчика и не пересекаются;
+ *   - объекты, созданные вне части, доступны только для чтения: попытка их
+ *     изменить (IsSharedObject) – ошибка Lumen, а не гонка данных;
+ *   - вывод и сообщения об ошибках части собираются отдельно и после
+ *     завершения всех частей выводятся в порядке частей, как при
+ *     последовательном выполнении;
+ *   - если ошибка произошла в нескольких частях, сообщается ошибка первой из
+ *     них, а вывод следующих частей отбрасывается;
+ *   - input внутри части запрещён.
+ * После завершения реестры объектов частей переходят во внешний контекст.
+ *
+ * Число потоков задаёт -threads <n> (0 – по числу ядер, 1 – без пула). С
+ * --profile части выполняются по очереди в вызывающем потоке: профилировщик
+ * рассчитан на один поток.
+ */
+
+// Размер стека потока пула (МБ)
+#define PARALLEL_STACK_MB 64
+// Частей на поток: запас для перехвата работы при неравных итерациях
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+struct ParallelRegion;
+
+// Отсоединённый поток для кода интерпретатора: стек PARALLEL_STACK_MB,
+// границы стека известны NativeStack. false – поток не создан
+bool StartInterpreterThread(std::function<void()> body) {
+    size_t stack_size = (size_t)PARALLEL_STACK_MB * 1024 * 1024;
+    auto start = new std::function<void()>(std::move(body));
+    #ifdef _WIN32
+        auto entry = [](void* arg) {
+            std::unique_ptr<std::function<void()>> body((std::function<void()>*)arg);
+            NativeStack::attach((size_t)PARALLEL_STACK_MB * 1024 * 1024);
+            (*body)();
+        };
+        if (_beginthread(entry, (unsigned)stack_size, start) == (uintptr_t)-1L) {
+            delete start;
+            return false;
+        }
+    #else
+        auto entry = [](void* arg) -> void* {
+            std::unique_ptr<std::function<void()>> body((std::function<void()>*)arg);
+            NativeStack::attach((size_t)PARALLEL_STACK_MB * 1024 * 1024);
+            (*body)();
+            return nullptr;
+        };
+        pthread_attr_t attr;
+        pthread_t thread;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, stack_size);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        int failed = pthread_create(&thread, &attr, entry, start);
+        pthread_attr_destroy(&attr);
+        if (failed) {
+            delete start;
+            return false;
+        }
+    #endif
+    return true;
+}
+
+struct ParallelJob {
+    ParallelRegion* region;
+    size_t chunk;
+};
+
+void RunParallelJob(const ParallelJob& job);
+
+struct WorkerPool {
+    struct Queue {
+        std::mutex lock;
+        std::deque<ParallelJob> jobs;
+    };
+
+    static size_t threads;      // -threads <n>, 0 – по числу ядер
+
+    size_t workers = 0;
+    std::vector<std::unique_ptr<Queue>> queues;     // workers + общая
+    std::atomic<size_t> queued{0};
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+
+    // Пул не разрушается: его потоки могут ждать работу до exit()
+    static WorkerPool& instance() {
+        static WorkerPool* pool = new WorkerPool();
+        return *pool;
+    }
+
+    // Номер очереди потока пула, SIZE_MAX – поток вне пула
+    static size_t& own_queue() {
+        static thread_local size_t index = SIZE_MAX;
+        return index;
+    }
+
+    WorkerPool() {
+        size_t total = threads ? threads : std::thread::hardware_concurrency();
+        workers = total > 1 ? total - 1 : 0;
+        for (size_t i = 0; i <= workers; i++)
+            queues.push_back(std::make_unique<Queue>());
+        for (size_t i = 0; i < workers; i++)
+            start_worker(i);
+    }
+
+    size_t concurrency() const {
+        return workers + 1;
+    }
+
+    size_t current_queue() const {
+        size_t index = own_queue();
+        return index == SIZE_MAX ? workers : index;
+    }
+
+    // Части раскладываются по очередям по кругу, начиная со своей
+    void push(const std::vector<ParallelJob>& jobs) {
+        size_t first = current_queue();
+        for (size_t i = 0; i < jobs.size(); i++) {
+            auto& queue = *queues[(first + i) % queues.size()];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.jobs.push_back(jobs[i]);
+        }
+        queued.fetch_add(jobs.size());
+        { std::lock_guard<std::mutex> guard(sleep_lock); }
+        wake.notify_all();
+    }
+
+    // Своя очередь – с конца, чужие – с начала
+    bool take(ParallelJob& job) {
+        size_t own = current_queue();
+        for (size_t i = 0; i < queues.size(); i++) {
+            auto& queue = *queues[(own + i) % queues.size()];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (queue.jobs.empty()) continue;
+            if (i == 0) {
+                job = queue.jobs.back();
+                queue.jobs.pop_back();
+            } else {
+                job = queue.jobs.front();
+                queue.jobs.pop_front();
+            }
+            queued.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    void work(size_t index) {
+        own_queue() = index;
+        ParallelJob job;
+        while (true) {
+            if (take(job)) {
+                RunParallelJob(job);
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            wake.wait(guard, [this](){ return queued.load() > 0; });
+        }
+    }
+
+    void start_worker(size_t index) {
+        StartInterpreterThread([this, index]() { work(index); });
+    }
+};
+
+size_t WorkerPool::threads = 0;
+
+// Номер новой параллельной задачи (0 занят – «вне задач»)
+inline uint32_t NextParallelTask() {
+    static std::atomic<uint32_t> counter{0};
+    uint32_t task;
+    do task = ++counter; while (task == 0);
+    return task;
+}
+
+struct ParallelRegion {
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        RuntimeContext context;
+        std::string output;
+        std::ostringstream diagnostics;
+        std::exception_ptr error;
+    };
+
+    const std::function<void(size_t, size_t)>& body;
+    RuntimeContext& parent;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::atomic<int> address_source;
+    std::atomic<size_t> remaining;
+    std::atomic<size_t> first_failed{SIZE_MAX};
+    std::mutex done_lock;
+    std::condition_variable done;
+
+    ParallelRegion(const std::function<void(size_t, size_t)>& body, RuntimeContext& parent, size_t count, size_t parts)
+        : body(body), parent(parent), address_source(parent.next_address), remaining(parts) {
+        for (size_t i = 0; i < parts; i++) {
+            auto chunk = std::make_unique<Chunk>();
+            chunk->begin = count * i / parts;
+            chunk->end = count * (i + 1) / parts;
+            auto& context = chunk->context;
+            context.parent = &parent;
+            context.reads_parent = true;
+            context.memories = parent.memories;
+            context.task = NextParallelTask();
+            context.recursion_depth = parent.recursion_depth;
+            context.active_function_frames = 0;
+            context.next_address = context.address_limit = 0;
+            // Вложенный цикл берёт адреса из того же общего счётчика
+            context.address_source = parent.address_source ? parent.address_source : &address_source;
+            context.output.capture = &chunk->output;
+            context.diagnostics = &chunk->diagnostics;
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+    void run(size_t index) {
+        auto& chunk = *chunks[index];
+        // Части после упавшей уже не повлияют на результат
+        if (index < first_failed.load()) {
+            RuntimeContext::Scope scope(&chunk.context);
+            try {
+                body(chunk.begin, chunk.end);
+            } catch (...) {
+                chunk.error = std::current_exception();
+                size_t failed = first_failed.load();
+                while (index < failed && !first_failed.compare_exchange_weak(failed, index)) {}
+            }
+            OutputBuffer::flush();
+        }
+        // Под done_lock: после последнего уменьшения ожидающий может сразу
+        // разрушить область (см. wait)
+        std::lock_guard<std::mutex> guard(done_lock);
+        if (--remaining == 0)
+            done.notify_all();
+    }
+
+    // Ожидание частей: поток выполняет любые доступные части пула
+    void wait(WorkerPool& pool) {
+        ParallelJob job;
+        while (remaining.load() > 0) {
+            if (pool.take(job)) {
+                RunParallelJob(job);
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(done_lock);
+            done.wait_for(guard, std::chrono::milliseconds(1), [this](){ return remaining.load() == 0; });
+        }
+        // Последняя часть могла ещё не отпустить done_lock
+        std::lock_guard<std::mutex> guard(done_lock);
+    }
+
+    // Итог в контексте вызывающего: вывод по порядку, объекты, ошибка первой части
+    void finish() {
+        if (!parent.address_source)
+            parent.next_address = address_source.load();
+        size_t failed = first_failed.load();
+        for (size_t i = 0; i < chunks.size(); i++) {
+            auto& chunk = *chunks[i];
+            if (i <= failed) {
+                OutputBuffer::write(chunk.output);
+                auto diagnostics = chunk.diagnostics.str();
+                if (!diagnostics.empty()) {
+                    OutputBuffer::flush();
+                    DiagnosticStream() << diagnostics;
+                }
+            }
+            for (auto& [address, object] : chunk.context.objects)
+                parent.objects.emplace(address, object);
+            parent.memoized_functions.insert(parent.memoized_functions.end(),
+                chunk.context.memoized_functions.begin(), chunk.context.memoized_functions.end());
+        }
+        if (failed == SIZE_MAX)
+            return;
+
+        try {
+            std::rethrow_exception(chunks[failed]->error);
+        } catch (const ProgramExit& exit) {
+            // exit или фатальная ошибка в части – завершение, как вне цикла
+            OutputBuffer::flush();
+            if (exit.fatal)
+                ExitOnError(exit.code);
+            ExitProgram(exit.code);
+        }
+    }
+};
+
+void RunParallelJob(const ParallelJob& job) {
+    job.region->run(job.chunk);
+}
+
+// Выполнение body(begin, end) по частям диапазона [0, count)
+void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body) {
+    if (!count)
+        return;
+
+    auto& pool = WorkerPool::instance();
+    size_t threads = Profiler::enabled ? 1 : pool.concurrency();
+    size_t parts = std::min(count, threads > 1 ? threads * PARALLEL_CHUNKS_PER_THREAD : (size_t)1);
+
+    ParallelRegion region(body, RuntimeContext::current(), count, parts);
+    if (parts == 1) {
+        region.run(0);
+    } else {
+        std::vector<ParallelJob> jobs;
+        jobs.reserve(parts);
+        for (size_t i = 0; i < parts; i++)
+            jobs.push_back({&region, i});
+        pool.push(jobs);
+        region.wait(pool);
+    }
+    region.finish();
+}
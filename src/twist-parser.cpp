@@ -40,6 +40,10 @@
 #include "Nodes/NodeWhile.cpp"
 #include "Nodes/NodeDoWhile.cpp"
 #include "Nodes/NodeFor.cpp"
+#include "Nodes/NodeParallelFor.cpp"
+#include "Nodes/NodeSpawn.cpp"
+#include "Nodes/NodeYield.cpp"
+#include "Nodes/NodeForIn.cpp"
 #include "Nodes/NodeInput.cpp"
 
 #include "Nodes/NodeTypeof.cpp"
@@ -62,10 +66,16 @@
 #include "Nodes/NodeFunctionType.cpp"
 #include "Nodes/NodeArrayType.cpp"
 #include "Nodes/NodeArray.cpp"
+#include "Nodes/NodeMap.cpp"
 #include "Nodes/NodeGetIndex.cpp"
 #include "Nodes/NodeArrayPush.cpp"
+#include "Nodes/NodeFused.cpp"
 
 #include "Nodes/NodeEcho.cpp"
+#include "Nodes/NodeProfile.cpp"
+
+#include "twist-purity.cpp"
+#include "twist-jit.cpp"
 
 #include <vcruntime_startup.h>
 #include <string>
@@ -93,6 +103,7 @@ struct ASTGenerator {
     Node* ParseGlobalVariableDecl();
     Node* ParsePrivateVariableDecl();
     Node* ParseShadowVariableDecl();
+    Node* ParseMemoFuncDecl();
     Node* ParseBlockDecl(string modifier);
 
     // Input and outputs
@@ -108,6 +119,12 @@ struct ASTGenerator {
     Node* ParseWhile();
     Node* ParseDoWhile();
     Node* ParseFor();
+    Node* ParseForIn();
+    Node* ParseParallelFor();
+
+    // Tasks
+    Node* ParseSpawn();
+    Node* ParseAwait();
 
     // Block of instructs
     Node* ParseBlock();
@@ -139,6 +156,7 @@ struct ASTGenerator {
     Node* ParseContinue();
     Node* ParseExit();
     Node* ParseReturn();
+    Node* ParseYield();
 
     // Assert
     Node* ParseAssert();
@@ -165,6 +183,7 @@ struct ASTGenerator {
     // Arrays
     Node* ParseNewArrayType();
     Node* ParseArray();
+    Node* ParseMap();
     Node* ParseGetIndex(Node* expr, Token start, Token end);
 
     // Structs
@@ -226,6 +245,14 @@ struct ASTGenerator {
             return ParseNew();
         }
 
+        if (walker.CheckType(TokenType::KEYWORD) && walker.CheckValue("spawn")) {
+            return ParseSpawn();
+        }
+
+        if (walker.CheckType(TokenType::KEYWORD) && walker.CheckValue("await")) {
+            return ParseAwait();
+        }
+
         if (walker.CheckType(TokenType::KEYWORD) && walker.CheckValue("sizeof")) {
             return ParseSizeof();
         }
@@ -238,6 +265,11 @@ struct ASTGenerator {
             return ParseNewFunctionType();
         }
 
+        if (walker.CheckType(TokenType::LITERAL) && (walker.CheckValue("Map") || walker.CheckValue("Set")) &&
+            walker.CheckValue("{", 1)) {
+            return ParseMap();
+        }
+
         if (walker.CheckType(TokenType::LITERAL)) {
             auto expr = ParseLiteral();
             // Применяем постфиксные операции к литералу
@@ -325,7 +357,8 @@ struct ASTGenerator {
                     break;
                 }
                 
-                if ((walker.CheckType(TokenType::OPERATOR) || walker.CheckType(TokenType::L_TRIANGLE_BRACKET) || walker.CheckType(TokenType::R_TRIANGLE_BRACKET) || walker.CheckType(TokenType::DEREFERENCE)) && walker.CheckValue(candidate)) {
+                if ((walker.CheckType(TokenType::OPERATOR) || walker.CheckType(TokenType::L_TRIANGLE_BRACKET) || walker.CheckType(TokenType::R_TRIANGLE_BRACKET) || walker.CheckType(TokenType::DEREFERENCE) ||
+                     (walker.CheckType(TokenType::KEYWORD) && candidate == "in")) && walker.CheckValue(candidate)) {
                     found_operator = true;
                     op = candidate;
                     walker.next();
@@ -363,7 +396,7 @@ struct ASTGenerator {
 
     Node* parse_binary_expression_eq_ne_in_ni() {
         return ParseBinaryLevel(&ASTGenerator::parse_binary_expression_less_more,
-                            {"==", "!=", "<<", ">>"}, "equality/innary");
+                            {"==", "!=", "<<", ">>", "in"}, "equality/innary");
     }
 
     Node* parse_binary_expression_less_more() {
@@ -413,7 +446,88 @@ struct ASTGenerator {
         return parse_higher_order_expressions();
     }
 
+    /*
+     * Оператор push `arr <- value;`. Лексер выдаёт '<' и '-' отдельными
+     * токенами (в выражении `x <- 1` – это x < -1), поэтому push
+     * распознаётся только как оператор: слева lvalue (имя, a[i], s::x, *p),
+     * за ним '<' и '-'. Иначе токены не потребляются, и оператор
+     * разбирается как обычно.
+     */
+    bool HasPushOperatorAhead() {
+        int depth = 0;
+        for (int offset = 0; ; offset++) {
+            auto token = walker.get(offset);
+            if (token->type == TokenType::END_OF_FILE || (depth == 0 && token->value == ";"))
+                return false;
+            if (token->value == "(" || token->value == "[" || token->value == "{") depth++;
+            else if (token->value == ")" || token->value == "]" || token->value == "}") {
+                if (--depth < 0) return false;
+            }
+            else if (depth == 0 && token->type == TokenType::L_TRIANGLE_BRACKET &&
+                     walker.get(offset + 1)->type == TokenType::OPERATOR && walker.get(offset + 1)->value == "-")
+                return true;
+        }
+    }
+
+    static bool IsPushTarget(Node* node) {
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_LITERAL:
+            case NodeTypes::NODE_OBJECT_RESOLUTION:
+            case NodeTypes::NODE_GET_BY_INDEX:
+            case NodeTypes::NODE_DEREFERENCE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    Node* ParsePushStatement() {
+        if (!walker.CheckType(TokenType::LITERAL) && !walker.CheckType(TokenType::DEREFERENCE))
+            return nullptr;
+        if (!HasPushOperatorAhead())
+            return nullptr;
+
+        size_t start_index = walker.token_index;
+        auto target = parse_unary_expression();
+        if (!target || !IsPushTarget(target) || !walker.CheckType(TokenType::L_TRIANGLE_BRACKET) ||
+            !walker.CheckType(TokenType::OPERATOR, 1) || !walker.CheckValue("-", 1)) {
+            walker.token_index = start_index;
+            return nullptr;
+        }
+
+        Token op_token = *walker.get();
+        op_token.value = "<-";
+        walker.next();
+        walker.next();
+
+        auto expr = parse_expression();
+        if (!expr)
+            throw ERROR_THROW::UnexpectedToken(*walker.get(), "expression");
+        auto end_value_token = *walker.get(-1);
+        if (!walker.CheckValue(";"))
+            throw ERROR_THROW::UnexpectedToken(*walker.get(), "';'");
+        walker.next();
+        return new NodeExpressionStatement(new NodeArrayPush(target, expr, op_token, end_value_token));
+    }
+
+    // Позиции начала операторов; заполняются только для --profile
+    unordered_map<Node*, PosInFile>* statement_positions = nullptr;
+
+    // Разбор тела функции: глубина вложенности и был ли в теле yield
+    int function_depth = 0;
+    bool function_yields = false;
+
     Node* parse_statement() {
+        if (!statement_positions)
+            return parse_statement_node();
+        PosInFile start = walker.get()->pif;
+        Node* statement = parse_statement_node();
+        if (statement)
+            statement_positions->emplace(statement, start);
+        return statement;
+    }
+
+    Node* parse_statement_node() {
         Token current = *walker.get();
         if (current.type == TokenType::L_CURVE_BRACKET) {
             return ParseBlock();
@@ -480,6 +594,10 @@ struct ASTGenerator {
             return ParseShadowVariableDecl();
         }
 
+        if (current.type == TokenType::KEYWORD && current.value == "memo") {
+            return ParseMemoFuncDecl();
+        }
+
         if (current.type == TokenType::KEYWORD && current.value == "exit") {
             return ParseExit();
         }
@@ -488,6 +606,10 @@ struct ASTGenerator {
             return ParseReturn();
         }
 
+        if (current.type == TokenType::KEYWORD && current.value == "yield") {
+            return ParseYield();
+        }
+
         if (current.type == TokenType::KEYWORD && current.value == "namespace") {
             return ParseNameSpaceDecl();
         }
@@ -512,6 +634,10 @@ struct ASTGenerator {
             return ParseFor();
         }
 
+        if (current.type == TokenType::KEYWORD && current.value == "parallel") {
+            return ParseParallelFor();
+        }
+
         if (current.type == TokenType::KEYWORD && current.value == "break") {
             return ParseBreak();
         }
@@ -528,6 +654,9 @@ struct ASTGenerator {
             throw ERROR_THROW::UnexpectedToken(*walker.get(), "statement");
         }
         
+        if (auto push = ParsePushStatement())
+            return push;
+
         // Общий случай: выражение, которое может быть присваиванием или expression statement
         auto start_left_value_token = *walker.get();
         
@@ -655,7 +784,17 @@ void GenerateStandartTypes(Memory* g_memory, string g_file_name) {
     g_memory->add_object("ptr",OBJ_TYPE_PTR);
     STATIC_MEMORY.register_object(OBJ_TYPE_AUTO);
 
-    auto __TWIST_FILE__ = CreateMemoryObject(Value(STANDART_TYPE::STRING, string(g_file_name)), STANDART_TYPE::STRING, g_memory,
+    auto OBJ_TYPE_MAP = CreateMemoryObject(NewType("Map"), STANDART_TYPE::TYPE, g_memory,
+        true, true, true, true, false, false);
+    g_memory->add_object("Map",OBJ_TYPE_MAP);
+    STATIC_MEMORY.register_object(OBJ_TYPE_MAP);
+
+    auto OBJ_TYPE_SET = CreateMemoryObject(NewType("Set"), STANDART_TYPE::TYPE, g_memory,
+        true, true, true, true, false, false);
+    g_memory->add_object("Set",OBJ_TYPE_SET);
+    STATIC_MEMORY.register_object(OBJ_TYPE_SET);
+
+    auto __TWIST_FILE__ = CreateMemoryObject(NewString(string(g_file_name)), STANDART_TYPE::STRING, g_memory,
         true, true, true, true, false, false);
     g_memory->add_object("__FILE__", __TWIST_FILE__);
     STATIC_MEMORY.register_object(__TWIST_FILE__);
@@ -714,6 +853,27 @@ Node* ASTGenerator::ParseReturn() {
     return new NodeReturn(expr, start, end);
 }
 
+// yield expr; – только в теле функции, функция становится генератором
+Node* ASTGenerator::ParseYield() {
+    Token start = *walker.get();
+    walker.next(); // pass 'yield' token
+
+    auto expr = parse_expression();
+    if (!expr)
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "expression");
+
+    if (!walker.CheckValue(";"))
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "';'");
+
+    Token end = *walker.get(-1);
+    walker.next();
+
+    if (!function_depth)
+        throw ERROR_THROW::YieldOutsideFunction(start, end);
+    function_yields = true;
+    return new NodeYield(expr, start, end);
+}
+
 // PASS
 Node* ASTGenerator::ParseExit() {
     Token start = *walker.get();
@@ -888,11 +1048,20 @@ Node* ASTGenerator::ParseFuncDecl() {
         throw ERROR_THROW::UnexpectedToken(*walker.get(), "return type expression");
 
     
+    // yield в теле делает функцию генератором
+    bool outer_yields = function_yields;
+    function_yields = false;
+    function_depth++;
     auto body = parse_statement();
+    function_depth--;
+    bool is_generator = function_yields;
+    function_yields = outer_yields;
     if (!body)
         throw ERROR_THROW::UnexpectedToken(*walker.get(), "body");
 
-    return new NodeFunctionDeclaration(name, arguments, return_type_expr, body, start_args_token, end_args_token, return_type_start_token, return_type_end_token);
+    auto decl = new NodeFunctionDeclaration(name, arguments, return_type_expr, body, start_args_token, end_args_token, return_type_start_token, return_type_end_token);
+    decl->is_generator = is_generator;
+    return decl;
 }
 
 
@@ -1398,6 +1567,10 @@ Node* ASTGenerator::ParseFor() {
 
     if (!walker.CheckValue("("))
         throw ERROR_THROW::UnexpectedToken(*walker.get(), "'('");
+
+    // for (x in ...) – до разбора выражения: `x in ...` – ещё и оператор in
+    if (walker.CheckType(TokenType::LITERAL, 1) && walker.CheckType(TokenType::KEYWORD, 2) && walker.CheckValue("in", 2))
+        return ParseForIn();
     walker.next();
 
     auto init_state = parse_statement();
@@ -1433,6 +1606,117 @@ Node* ASTGenerator::ParseFor() {
     return new NodeFor(init_state, check_expr, update_state, body, body_token);
 }
 
+// for (x in iterable) body, for (i in a..b) body; walker стоит на '('
+Node* ASTGenerator::ParseForIn() {
+    auto start_token = *walker.get(-1);
+    walker.next(); // pass '('
+
+    string name = walker.get()->value;
+    walker.next();
+    walker.next(); // pass 'in'
+
+    auto iterable = parse_expression();
+    if (!iterable)
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "expression");
+
+    // Диапазон a..b
+    Node* range_end = nullptr;
+    if (walker.CheckType(TokenType::OPERATOR) && walker.CheckValue("..")) {
+        walker.next();
+        range_end = parse_expression();
+        if (!range_end)
+            throw ERROR_THROW::UnexpectedToken(*walker.get(), "range end expression");
+    }
+
+    if (!walker.CheckValue(")"))
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "')'");
+    auto end_token = *walker.get();
+    walker.next();
+
+    auto body = parse_statement();
+    if (!body)
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "body");
+
+    return new NodeForIn(name, iterable, range_end, body, start_token, end_token);
+}
+
+// parallel for (let i = a; i < b; i = i + 1;) – только цикл со счётчиком и шагом 1
+Node* ASTGenerator::ParseParallelFor() {
+    auto start_token = *walker.get();
+    walker.next(); // pass 'parallel' token
+
+    if (!walker.CheckValue("for"))
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "'for'");
+
+    auto parsed = ParseFor();
+    if (parsed->NODE_TYPE != NodeTypes::NODE_FOR)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, *walker.get(-1));
+    auto loop = (NodeFor*)parsed;
+    auto end_token = loop->body_token;
+
+    auto is_counter = [](Node* node, const string& name) {
+        return node && node->NODE_TYPE == NodeTypes::NODE_LITERAL && ((NodeLiteral*)node)->name == name;
+    };
+
+    if (loop->start_state->NODE_TYPE != NodeTypes::NODE_VARIABLE_DECLARATION)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+    auto init = (NodeVariableDeclaration*)loop->start_state;
+    if (init->is_global || init->is_const || init->is_final)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+    auto& name = init->var_name;
+
+    if (loop->condition->NODE_TYPE != NodeTypes::NODE_BINARY)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+    auto check = (NodeBinary*)loop->condition;
+    if ((check->op != "<" && check->op != "<=") || !is_counter(check->left, name))
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+
+    // Шаг: name = name + 1
+    if (loop->update_state->NODE_TYPE != NodeTypes::NODE_VARIABLE_EQUAL)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+    auto update = (NodeVariableEqual*)loop->update_state;
+    auto step = (NodeBinary*)update->expression;
+    if (!is_counter(update->variable, name) || step->NODE_TYPE != NodeTypes::NODE_BINARY || step->op != "+" ||
+        !is_counter(step->left, name) || step->right->NODE_TYPE != NodeTypes::NODE_NUMBER)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+    auto& one = ((NodeNumber*)step->right)->value;
+    if (one.type != STANDART_TYPE::INT || any_cast<int64_t>(one.data) != 1)
+        throw ERROR_THROW::ParallelForNotCanonical(start_token, end_token);
+
+    auto parallel = new NodeParallelFor(name, init->value_expr, check->right, check->op == "<=", loop->body,
+                                        start_token, end_token);
+    delete loop;
+    return parallel;
+}
+
+// spawn f(args) – только вызов
+Node* ASTGenerator::ParseSpawn() {
+    auto start_token = *walker.get();
+    walker.next(); // pass 'spawn' token
+
+    auto call_token = *walker.get();
+    auto call = parse_unary_expression();
+    if (!call || call->NODE_TYPE != NodeTypes::NODE_CALL)
+        throw ERROR_THROW::UnexpectedToken(call_token, "call after 'spawn'");
+    auto end_token = *walker.get(-1);
+
+    return new NodeSpawn((NodeCall*)call, start_token, end_token);
+}
+
+// await future
+Node* ASTGenerator::ParseAwait() {
+    auto start_token = *walker.get();
+    walker.next(); // pass 'await' token
+
+    auto expr_token = *walker.get();
+    auto expr = parse_unary_expression();
+    if (!expr)
+        throw ERROR_THROW::UnexpectedToken(expr_token, "expression");
+    auto end_token = *walker.get(-1);
+
+    return new NodeAwait(expr, start_token, end_token);
+}
+
 // PASS
 Node* ASTGenerator::ParseWhile() {
     auto start_token = *walker.get();
@@ -1799,7 +2083,7 @@ Node* ASTGenerator::ParseShadowVariableDecl() {
         !walker.CheckValue("const") && !walker.CheckValue("global") &&
         !walker.CheckValue("namespace") && !walker.CheckValue("func") &&
         !walker.CheckValue("private") && !walker.CheckValue("struct") && 
-        !walker.CheckValue("final")) {
+        !walker.CheckValue("final") && !walker.CheckValue("memo")) {
         throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
     }
 
@@ -1824,6 +2108,28 @@ Node* ASTGenerator::ParseShadowVariableDecl() {
     return decl;
 }
 
+Node* ASTGenerator::ParseMemoFuncDecl() {
+    walker.next(); // pass 'memo' token
+
+    if (!walker.CheckValue("func") && !walker.CheckValue("static") &&
+        !walker.CheckValue("const") && !walker.CheckValue("final") &&
+        !walker.CheckValue("global") && !walker.CheckValue("private") &&
+        !walker.CheckValue("shadow")) {
+        throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
+    }
+
+    auto token = *walker.get();
+    auto decl = parse_statement();
+
+    if (decl->NODE_TYPE == NodeTypes::NODE_FUNCTION_DECLARATION) {
+        ((NodeFunctionDeclaration*)decl)->is_memo = true;
+    } else {
+        throw ERROR_THROW::ExpectedDeclarationStatement(token);
+    }
+    return decl;
+}
+
+
 Node* ASTGenerator::ParseFinalVariableDecl() {
     walker.next(); // pass 'final' token
 
@@ -1831,7 +2137,7 @@ Node* ASTGenerator::ParseFinalVariableDecl() {
         !walker.CheckValue("const") && !walker.CheckValue("global") &&
         !walker.CheckValue("namespace") && !walker.CheckValue("func") &&
         !walker.CheckValue("private") && !walker.CheckValue("struct") && 
-        !walker.CheckValue("shadow")) {
+        !walker.CheckValue("shadow") && !walker.CheckValue("memo")) {
         throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
     }
 
@@ -1864,7 +2170,7 @@ Node* ASTGenerator::ParseStaticVariableDecl() {
         !walker.CheckValue("const") && !walker.CheckValue("global") &&
         !walker.CheckValue("namespace") && !walker.CheckValue("func") &&
         !walker.CheckValue("private") && !walker.CheckValue("struct") && 
-        !walker.CheckValue("shadow")) {
+        !walker.CheckValue("shadow") && !walker.CheckValue("memo")) {
         throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
     }
 
@@ -1895,7 +2201,7 @@ Node* ASTGenerator::ParseConstVariableDecl() {
         !walker.CheckValue("final") && !walker.CheckValue("global") &&
         !walker.CheckValue("namespace") && !walker.CheckValue("func") &&
         !walker.CheckValue("private") && !walker.CheckValue("struct") && 
-        !walker.CheckValue("shadow")) {
+        !walker.CheckValue("shadow") && !walker.CheckValue("memo")) {
         throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
     }
 
@@ -1927,7 +2233,7 @@ Node* ASTGenerator::ParseGlobalVariableDecl() {
         !walker.CheckValue("const") && !walker.CheckValue("final") &&
         !walker.CheckValue("namespace") && !walker.CheckValue("func") &&
         !walker.CheckValue("private") && !walker.CheckValue("struct") && 
-        !walker.CheckValue("shadow")) {
+        !walker.CheckValue("shadow") && !walker.CheckValue("memo")) {
         throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
     }
 
@@ -1958,7 +2264,7 @@ Node* ASTGenerator::ParsePrivateVariableDecl() {
         !walker.CheckValue("const") && !walker.CheckValue("final") &&
         !walker.CheckValue("namespace") && !walker.CheckValue("func") &&
         !walker.CheckValue("global") && !walker.CheckValue("struct") && 
-        !walker.CheckValue("shadow")) {
+        !walker.CheckValue("shadow") && !walker.CheckValue("memo")) {
         throw ERROR_THROW::ExpectedDeclarationStatement(*walker.get());
     }
 
@@ -2093,6 +2399,48 @@ Node* ASTGenerator::ParseArray() {
 }
 
 
+// Map{k: v, ...} и Set{a, b, ...}
+Node* ASTGenerator::ParseMap() {
+    bool is_set = walker.CheckValue("Set");
+    walker.next(); // pass 'Map' / 'Set'
+    walker.next(); // pass '{'
+    vector<tuple<Node*, Token, Token>> keys;
+    vector<Node*> values;
+    if (walker.CheckValue("}")) {
+        walker.next(); // pass '}' token
+        return new NodeMap(std::move(keys), std::move(values), is_set);
+    }
+    while (true) {
+        Token start_key = *walker.get();
+        auto key = parse_expression();
+        Token end_key = *walker.get(-1);
+        if (!key)
+            throw ERROR_THROW::UnexpectedToken(*walker.get(), "expression");
+        keys.push_back(std::make_tuple(key, start_key, end_key));
+
+        if (!is_set) {
+            if (!walker.CheckValue(":"))
+                throw ERROR_THROW::UnexpectedToken(*walker.get(), "':'");
+            walker.next(); // pass ':' token
+            auto value = parse_expression();
+            if (!value)
+                throw ERROR_THROW::UnexpectedToken(*walker.get(), "expression");
+            values.push_back(value);
+        }
+
+        if (walker.CheckValue(",")) {
+            walker.next(); // pass ',' token
+            continue;
+        }
+        break;
+    }
+    if (!walker.CheckValue("}"))
+        throw ERROR_THROW::UnexpectedToken(*walker.get(), "'}'");
+    walker.next();
+    return new NodeMap(std::move(keys), std::move(values), is_set);
+}
+
+
 Node* ASTGenerator::ParseGetIndex(Node* expr, Token start, Token end) {
     walker.next(); // pass '[' token
     auto index_expr = parse_expression();
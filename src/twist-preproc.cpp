@@ -22,6 +22,12 @@ namespace ErrorTypes {
 struct Define {
     std::vector<Token> body;
     PosInFile definition_pos;
+
+    // Кэш полностью раскрытого тела (заполняется при первом раскрытии)
+    std::vector<Token> expansion;
+    bool has_expansion = false;
+    bool uses_macros = false;   // раскрытие зависит от активных макросов
+    bool expanding = false;     // защита от рекурсивного раскрытия
 };
 
 // Структура для хранения macro
@@ -29,6 +35,22 @@ struct Macro {
     std::vector<std::string> params;
     std::vector<Token> body;
     PosInFile definition_pos;
+
+    // Шаблон тела: для каждого токена body индекс параметра или -1
+    std::vector<int> param_slots;
+    bool expanding = false;     // макрос сейчас раскрывается (вместо множества forbidden)
+};
+
+// Кадр явного стека раскрытия: диапазон токенов, который сейчас читается
+struct ExpansionFrame {
+    Token* cursor;
+    Token* end;
+    Macro* macro = nullptr;     // макрос, активный на время кадра
+    Define* define = nullptr;   // define, результат которого кэшируется при выходе
+    bool cacheable = false;
+    bool owns_tokens = false;   // токены кадра можно перемещать в вывод
+    size_t output_start = 0;
+    std::vector<Token> buffer;  // подставленное тело макроса (владеет токенами)
 };
 
 // Обёртка для потоковой обработки токенов
@@ -92,6 +114,7 @@ private:
     std::string current_file_path_;
     std::string current_file_name_;
     std::set<std::string> included_files_;
+    size_t active_macros_ = 0;
 
     // ---------------------------------------------------------------
 // ПРОХОД 1: рекурсивная вставка всех #include
@@ -144,8 +167,7 @@ std::vector<Token> processDefinesAndMacros(const std::vector<Token>& tokens) {
     std::vector<Token> without_defines = collectDefinesAndMacros(tokens);
     
     // Шаг 2b: подставляем все define и macro
-    std::set<std::string> forbidden;
-    std::vector<Token> result = expandTokens(without_defines, forbidden);
+    std::vector<Token> result = expandTokens(std::move(without_defines));
     
     return result;
 }
@@ -321,7 +343,10 @@ std::vector<Token> collectDefinesAndMacros(const std::vector<Token>& tokens) {
             throw err;
         }
         stream.next(); // ';'
-        defines_[name] = {body, body.empty() ? PosInFile() : body[0].pif};
+        Define define;
+        define.definition_pos = body.empty() ? PosInFile() : body[0].pif;
+        define.body = std::move(body);
+        defines_[name] = std::move(define);
     }
 
     // Обработка #macro name(params) = [...];
@@ -421,127 +446,182 @@ std::vector<Token> collectDefinesAndMacros(const std::vector<Token>& tokens) {
         }
         stream.next(); // ';'
         
-        macros_[name] = {params, body, body.empty() ? PosInFile() : body[0].pif};
+        // Компилируем тело в шаблон: позиции параметров вычисляются один раз
+        std::vector<int> param_slots(body.size(), -1);
+        for (size_t i = 0; i < body.size(); ++i) {
+            if (body[i].type != TokenType::LITERAL) continue;
+            auto paramIt = std::find(params.begin(), params.end(), body[i].value);
+            if (paramIt != params.end())
+                param_slots[i] = static_cast<int>(paramIt - params.begin());
+        }
+
+        Macro macro;
+        macro.params = std::move(params);
+        macro.definition_pos = body.empty() ? PosInFile() : body[0].pif;
+        macro.body = std::move(body);
+        macro.param_slots = std::move(param_slots);
+        macros_[name] = std::move(macro);
     }
 
-    // Рекурсивное раскрытие токенов с защитой от бесконечной рекурсии
-    std::vector<Token> expandTokens(const std::vector<Token>& tokens,
-                                    std::set<std::string>& forbidden_macros) {
+    // Раскрытие define и macro в один выходной буфер.
+    // Вместо рекурсии используется явный стек кадров: каждый кадр читает
+    // свой диапазон токенов (исходный поток, тело define или подставленное
+    // тело макроса). Повторное раскрытие активного макроса/define запрещено
+    // флагом expanding, поэтому имя остаётся в выводе как обычный литерал.
+    std::vector<Token> expandTokens(std::vector<Token>&& tokens) {
         std::vector<Token> result;
-        TokenStream stream(tokens);
+        result.reserve(tokens.size());
 
-        while (stream.hasNext()) {
-            const Token& tok = stream.peek();
+        std::vector<ExpansionFrame> stack;
+        stack.emplace_back();
+        stack.back().cursor = tokens.data();
+        stack.back().end = tokens.data() + tokens.size();
+        stack.back().owns_tokens = true;
+
+        std::vector<std::pair<const Token*, const Token*>> args;
+
+        while (!stack.empty()) {
+            ExpansionFrame& frame = stack.back();
+            if (frame.cursor == frame.end) {
+                popFrame(stack, result);
+                continue;
+            }
+
+            const Token& tok = *frame.cursor;
+            if (tok.type != TokenType::LITERAL) {
+                emitToken(frame, result);
+                continue;
+            }
 
             // Обрабатываем define
-            if (tok.type == TokenType::LITERAL) {
-                auto defIt = defines_.find(tok.value);
-                if (defIt != defines_.end()) {
-                    stream.next(); // потребляем имя
-                    const auto& body = defIt->second.body;
-                    auto expanded = expandTokens(body, forbidden_macros);
-                    result.insert(result.end(), expanded.begin(), expanded.end());
+            auto defIt = defines_.find(tok.value);
+            if (defIt != defines_.end() && !defIt->second.expanding) {
+                ++frame.cursor;
+                Define& def = defIt->second;
+                if (def.has_expansion && (active_macros_ == 0 || !def.uses_macros)) {
+                    result.insert(result.end(), def.expansion.begin(), def.expansion.end());
                     continue;
                 }
+                def.expanding = true;
+                ExpansionFrame def_frame;
+                // Тело define разделяется всеми подстановками и только копируется
+                def_frame.cursor = def.body.data();
+                def_frame.end = def.body.data() + def.body.size();
+                def_frame.define = &def;
+                def_frame.cacheable = (active_macros_ == 0);
+                def_frame.output_start = result.size();
+                stack.push_back(std::move(def_frame));
+                continue;
             }
 
             // Обрабатываем macro
-            if (tok.type == TokenType::LITERAL) {
-                auto macIt = macros_.find(tok.value);
-                if (macIt != macros_.end()) {
-                    size_t savedPos = stream.getPosition();
-                    stream.next(); // потребляем имя макроса
-
-                    if (stream.hasNext() && stream.peek().type == TokenType::L_BRACKET) {
-                        stream.next(); // '('
-
-                        if (forbidden_macros.find(tok.value) != forbidden_macros.end()) {
-                            stream.setPosition(savedPos);
-                            result.push_back(stream.next());
-                            continue;
-                        }
+            auto macIt = macros_.find(tok.value);
+            const Token* open = frame.cursor + 1;
+            if (macIt == macros_.end() || open == frame.end || open->type != TokenType::L_BRACKET) {
+                emitToken(frame, result);
+                continue;
+            }
 
-                        // Парсим аргументы
-                        std::vector<std::vector<Token>> args;
-                        if (macIt->second.params.empty() &&
-                            stream.hasNext() && stream.peek().type == TokenType::R_BRACKET) {
-                            stream.next();
-                        } else {
-                            std::vector<Token> current_arg;
-                            int paren_depth = 1;
-                            while (stream.hasNext() && paren_depth > 0) {
-                                const Token& arg_tok = stream.peek();
-                                if (arg_tok.type == TokenType::L_BRACKET) {
-                                    paren_depth++;
-                                    if (paren_depth > 1) current_arg.push_back(stream.next());
-                                    else stream.next();
-                                } else if (arg_tok.type == TokenType::R_BRACKET) {
-                                    paren_depth--;
-                                    if (paren_depth == 0) {
-                                        if (!current_arg.empty() || !args.empty())
-                                            args.push_back(current_arg);
-                                        stream.next();
-                                        break;
-                                    } else {
-                                        current_arg.push_back(stream.next());
-                                    }
-                                } else if (arg_tok.type == TokenType::OPERATOR && arg_tok.value == "," && paren_depth == 1) {
-                                    args.push_back(current_arg);
-                                    current_arg.clear();
-                                    stream.next();
-                                } else {
-                                    current_arg.push_back(stream.next());
-                                }
-                            }
-                            if (paren_depth != 0) {
-                                PosInFile errPos = tok.pif;
-                                Error err("Unmatched '(' in macro call", errPos, ErrorTypes::MACRO, "");
-                                throw err;
-                            }
-                        }
+            // Результат раскрытия любого охватывающего define зависит от активных макросов
+            for (auto& outer : stack) {
+                if (outer.define) outer.define->uses_macros = true;
+            }
 
-                        if (args.size() != macIt->second.params.size()) {
-                            PosInFile errPos = tok.pif;
-                            Error err("Wrong number of arguments for macro '" + tok.value +
-                                      "': expected " + std::to_string(macIt->second.params.size()) +
-                                      ", got " + std::to_string(args.size()),
-                                      errPos, ErrorTypes::MACRO, "");
-                            throw err;
-                        }
+            Macro& macro = macIt->second;
+            if (macro.expanding) {
+                emitToken(frame, result);
+                continue;
+            }
 
-                        forbidden_macros.insert(tok.value);
-
-                        std::vector<Token> substituted_body;
-                        for (const Token& bt : macIt->second.body) {
-                            if (bt.type == TokenType::LITERAL) {
-                                auto paramIt = std::find(macIt->second.params.begin(),
-                                                        macIt->second.params.end(), bt.value);
-                                if (paramIt != macIt->second.params.end()) {
-                                    size_t idx = paramIt - macIt->second.params.begin();
-                                    if (idx < args.size()) {
-                                        substituted_body.insert(substituted_body.end(),
-                                                               args[idx].begin(), args[idx].end());
-                                        continue;
-                                    }
-                                }
-                            }
-                            substituted_body.push_back(bt);
+            // Парсим аргументы как диапазоны токенов текущего кадра (без копирования)
+            args.clear();
+            Token* cursor = frame.cursor + 2;
+            if (macro.params.empty() && cursor != frame.end && cursor->type == TokenType::R_BRACKET) {
+                ++cursor;
+            } else {
+                Token* arg_begin = cursor;
+                int paren_depth = 1;
+                for (; cursor != frame.end; ++cursor) {
+                    if (cursor->type == TokenType::L_BRACKET) {
+                        paren_depth++;
+                    } else if (cursor->type == TokenType::R_BRACKET) {
+                        paren_depth--;
+                        if (paren_depth == 0) {
+                            if (cursor != arg_begin || !args.empty())
+                                args.emplace_back(arg_begin, cursor);
+                            ++cursor;
+                            break;
                         }
-
-                        auto expanded_body = expandTokens(substituted_body, forbidden_macros);
-                        forbidden_macros.erase(tok.value);
-
-                        result.insert(result.end(), expanded_body.begin(), expanded_body.end());
-                        continue;
-                    } else {
-                        stream.setPosition(savedPos);
+                    } else if (cursor->type == TokenType::OPERATOR && cursor->value == "," && paren_depth == 1) {
+                        args.emplace_back(arg_begin, cursor);
+                        arg_begin = cursor + 1;
                     }
                 }
+                if (paren_depth != 0) {
+                    PosInFile errPos = tok.pif;
+                    Error err("Unmatched '(' in macro call", errPos, ErrorTypes::MACRO, "");
+                    throw err;
+                }
             }
 
-            result.push_back(stream.next());
+            if (args.size() != macro.params.size()) {
+                PosInFile errPos = tok.pif;
+                Error err("Wrong number of arguments for macro '" + tok.value +
+                          "': expected " + std::to_string(macro.params.size()) +
+                          ", got " + std::to_string(args.size()),
+                          errPos, ErrorTypes::MACRO, "");
+                throw err;
+            }
+
+            frame.cursor = cursor;
+
+            // Подстановка по предкомпилированному шаблону
+            ExpansionFrame macro_frame;
+            size_t body_size = macro.body.size();
+            for (size_t i = 0; i < body_size; ++i) {
+                if (macro.param_slots[i] >= 0) {
+                    const auto& arg = args[macro.param_slots[i]];
+                    macro_frame.buffer.insert(macro_frame.buffer.end(), arg.first, arg.second);
+                } else {
+                    macro_frame.buffer.push_back(macro.body[i]);
+                }
+            }
+            macro_frame.cursor = macro_frame.buffer.data();
+            macro_frame.end = macro_frame.buffer.data() + macro_frame.buffer.size();
+            macro_frame.owns_tokens = true;
+            macro_frame.macro = &macro;
+            macro.expanding = true;
+            ++active_macros_;
+            stack.push_back(std::move(macro_frame));
         }
 
         return result;
     }
+
+    // Вывод текущего токена кадра: собственные токены перемещаются, чужие копируются
+    void emitToken(ExpansionFrame& frame, std::vector<Token>& result) {
+        if (frame.owns_tokens)
+            result.push_back(std::move(*frame.cursor));
+        else
+            result.push_back(*frame.cursor);
+        ++frame.cursor;
+    }
+
+    // Снятие кадра: освобождение макроса и кэширование раскрытого define
+    void popFrame(std::vector<ExpansionFrame>& stack, const std::vector<Token>& result) {
+        ExpansionFrame& frame = stack.back();
+        if (frame.macro) {
+            frame.macro->expanding = false;
+            --active_macros_;
+        }
+        if (frame.define) {
+            Define* def = frame.define;
+            def->expanding = false;
+            if (!def->has_expansion && (frame.cacheable || !def->uses_macros)) {
+                def->expansion.assign(result.begin() + frame.output_start, result.end());
+                def->has_expansion = true;
+            }
+        }
+        stack.pop_back();
+    }
 };
\ No newline at end of file
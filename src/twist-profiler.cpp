@@ -0,0 +1,319 @@
+#include "twist-tokens.cpp"
+#include "twist-utils.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#pragma once
+
+/*
+ * Profiler – инструментирующий профилировщик (--profile).
+ *
+ * Учитывает число выполнений и накопленное время:
+ *   - по строкам исходника: каждый оператор оборачивается в NodeProfile,
+ *     позиция берётся из первого токена оператора (PosInFile);
+ *   - по функциям и лямбдам: кадр открывается в NodeCall::call_function /
+ *     call_lambda.
+ *
+ * total – время с вложенными вызовами (для рекурсии учитывается только
+ * внешний вызов), self – без вложенных операторов (для строк) или без
+ * вложенных функций (для функций). Вызовы функций дополнительно собираются
+ * в дерево, из которого строится collapsed-stack вывод для flame graph.
+ *
+ * Когда профилировщик выключен, операторы не оборачиваются, а в NodeCall
+ * остаётся одна проверка флага enabled.
+ */
+
+struct ProfileEntry {
+    string name;        // имя функции / лямбды, пусто для строки
+    string file;
+    int line = 0;
+    bool is_function = false;
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t self_ns = 0;
+    int active = 0;     // глубина рекурсии: total учитывается на внешнем уровне
+};
+
+struct ProfileCallNode {
+    ProfileEntry* entry;
+    int parent;
+    uint64_t self_ns = 0;
+    unordered_map<ProfileEntry*, int> children;
+};
+
+struct Profiler {
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        ProfileEntry* entry;
+        Clock::time_point start;
+        uint64_t child_ns;      // время вложенных кадров (для self строки)
+        uint64_t callee_ns;     // время вложенных функций (для self функции)
+        int call_node;          // узел дерева вызовов (для функций)
+    };
+
+    static bool enabled;
+    static Clock::time_point started;
+    static uint64_t program_ns;
+
+    static deque<ProfileEntry> entries;                      // адреса стабильны
+    static unordered_map<string, ProfileEntry*> line_entries;
+    static unordered_map<const void*, ProfileEntry*> function_entries;
+    static vector<ProfileCallNode> call_tree;                // [0] – <main>
+    static vector<Frame> frames;
+    static vector<size_t> function_frames;                  // индексы кадров функций
+    static int current_call_node;
+
+    // Поток пула задач spawn: профиль собирается только в потоке программы
+    static bool& unprofiled_thread() {
+        static thread_local bool unprofiled = false;
+        return unprofiled;
+    }
+
+    static bool recording() {
+        return enabled && !unprofiled_thread();
+    }
+
+    static void start() {
+        enabled = true;
+        entries.emplace_back();
+        entries.back().name = "<main>";
+        entries.back().is_function = true;
+        call_tree.push_back(ProfileCallNode{&entries.back(), -1, 0, {}});
+        current_call_node = 0;
+        started = Clock::now();
+    }
+
+    static void finish() {
+        program_ns = elapsed(started);
+        uint64_t top_level = 0;
+        for (auto& child : call_tree[0].children)
+            top_level += total_of(child.second);
+        call_tree[0].self_ns = program_ns > top_level ? program_ns - top_level : 0;
+        enabled = false;
+    }
+
+    static uint64_t elapsed(Clock::time_point since) {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count();
+    }
+
+    static ProfileEntry* line_entry(const PosInFile& pif) {
+        string key = pif.file_path + ":" + to_string(pif.line);
+        auto it = line_entries.find(key);
+        if (it != line_entries.end()) return it->second;
+        entries.emplace_back();
+        auto entry = &entries.back();
+        entry->file = pif.file_path;
+        entry->line = pif.line;
+        line_entries[key] = entry;
+        return entry;
+    }
+
+    static ProfileEntry* function_entry(const void* callable, const string& name, const PosInFile& pif) {
+        auto it = function_entries.find(callable);
+        if (it != function_entries.end()) return it->second;
+        entries.emplace_back();
+        auto entry = &entries.back();
+        entry->name = name;
+        entry->file = pif.file_path;
+        entry->line = pif.line;
+        entry->is_function = true;
+        function_entries[callable] = entry;
+        return entry;
+    }
+
+    static void enter(ProfileEntry* entry) {
+        entry->count++;
+        entry->active++;
+        int call_node = -1;
+        if (entry->is_function) {
+            auto& children = call_tree[current_call_node].children;
+            auto it = children.find(entry);
+            if (it == children.end()) {
+                call_tree.push_back(ProfileCallNode{entry, current_call_node, 0, {}});
+                call_node = (int)call_tree.size() - 1;
+                call_tree[current_call_node].children[entry] = call_node;
+            } else {
+                call_node = it->second;
+            }
+            current_call_node = call_node;
+            function_frames.push_back(frames.size());
+        }
+        frames.push_back(Frame{entry, Clock::now(), 0, 0, call_node});
+    }
+
+    static void leave() {
+        Frame frame = frames.back();
+        frames.pop_back();
+        uint64_t spent = elapsed(frame.start);
+        auto entry = frame.entry;
+
+        entry->active--;
+        if (entry->active == 0)
+            entry->total_ns += spent;
+        if (!frames.empty())
+            frames.back().child_ns += spent;
+
+        if (entry->is_function) {
+            uint64_t self = spent > frame.callee_ns ? spent - frame.callee_ns : 0;
+            entry->self_ns += self;
+            call_tree[frame.call_node].self_ns += self;
+            function_frames.pop_back();
+            if (!function_frames.empty())
+                frames[function_frames.back()].callee_ns += spent;
+            current_call_node = call_tree[frame.call_node].parent;
+        } else {
+            entry->self_ns += spent > frame.child_ns ? spent - frame.child_ns : 0;
+        }
+    }
+
+    static uint64_t total_of(int node) {
+        uint64_t total = call_tree[node].self_ns;
+        for (auto& child : call_tree[node].children)
+            total += total_of(child.second);
+        return total;
+    }
+
+    static vector<ProfileEntry*> sorted(bool functions) {
+        vector<ProfileEntry*> result;
+        for (auto& entry : entries)
+            if (entry.is_function == functions && entry.count)
+                result.push_back(&entry);
+        sort(result.begin(), result.end(), [](ProfileEntry* a, ProfileEntry* b) {
+            return a->self_ns != b->self_ns ? a->self_ns > b->self_ns : a->count > b->count;
+        });
+        return result;
+    }
+
+    static string ms(uint64_t ns) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.3f", ns / 1e6);
+        return buffer;
+    }
+
+    static string pad(const string& str, size_t width) {
+        return str.size() >= width ? str : str + string(width - str.size(), ' ');
+    }
+
+    static string location(const ProfileEntry* entry) {
+        return entry->file + ":" + to_string(entry->line);
+    }
+
+    // Текстовый отчёт: функции и строки, отсортированные по self-времени
+    static void print_report(ostream& out, size_t limit = 20) {
+        out << MT::INFO << "Profile: total " << ms(program_ns) << " ms" << endl;
+
+        auto functions = sorted(true);
+        out << MT::INFO << "Functions (by self time):" << endl;
+        out << "    " << pad("self ms", 12) << pad("total ms", 12) << pad("calls", 12) << "function" << endl;
+        for (size_t i = 0; i < functions.size() && i < limit; ++i) {
+            auto entry = functions[i];
+            if (entry->name == "<main>") continue;
+            out << "    " << pad(ms(entry->self_ns), 12) << pad(ms(entry->total_ns), 12)
+                << pad(to_string(entry->count), 12) << entry->name << " (" << location(entry) << ")" << endl;
+        }
+
+        auto lines = sorted(false);
+        out << MT::INFO << "Lines (by self time):" << endl;
+        out << "    " << pad("self ms", 12) << pad("total ms", 12) << pad("count", 12) << "line" << endl;
+        for (size_t i = 0; i < lines.size() && i < limit; ++i) {
+            auto entry = lines[i];
+            out << "    " << pad(ms(entry->self_ns), 12) << pad(ms(entry->total_ns), 12)
+                << pad(to_string(entry->count), 12) << location(entry) << endl;
+        }
+    }
+
+    static void write_json(ostream& out) {
+        auto write_entries = [&](const vector<ProfileEntry*>& list, bool functions) {
+            for (size_t i = 0; i < list.size(); ++i) {
+                auto entry = list[i];
+                out << "    {";
+                if (functions) out << "\"name\": " << JsonString(entry->name) << ", ";
+                out << "\"file\": " << JsonString(entry->file) << ", \"line\": " << entry->line
+                    << ", \"count\": " << entry->count << ", \"total_ns\": " << entry->total_ns
+                    << ", \"self_ns\": " << entry->self_ns << "}" << (i + 1 < list.size() ? "," : "") << "\n";
+            }
+        };
+        out << "{\n  \"total_ns\": " << program_ns << ",\n  \"functions\": [\n";
+        write_entries(sorted(true), true);
+        out << "  ],\n  \"lines\": [\n";
+        write_entries(sorted(false), false);
+        out << "  ]\n}\n";
+    }
+
+    // Формат collapsed stacks: "main;f;g <self>" – вход для flamegraph.pl
+    static void write_collapsed(ostream& out) {
+        vector<pair<int, string>> stack = {{0, "<main>"}};
+        while (!stack.empty()) {
+            auto [node, path] = stack.back();
+            stack.pop_back();
+            uint64_t self_us = call_tree[node].self_ns / 1000;
+            if (self_us)
+                out << path << " " << self_us << "\n";
+            for (auto& child : call_tree[node].children)
+                stack.push_back({child.second, path + ";" + child.first->name});
+        }
+    }
+};
+
+bool Profiler::enabled = false;
+Profiler::Clock::time_point Profiler::started;
+uint64_t Profiler::program_ns = 0;
+deque<ProfileEntry> Profiler::entries;
+unordered_map<string, ProfileEntry*> Profiler::line_entries;
+unordered_map<const void*, ProfileEntry*> Profiler::function_entries;
+vector<ProfileCallNode> Profiler::call_tree;
+vector<Profiler::Frame> Profiler::frames;
+vector<size_t> Profiler::function_frames;
+int Profiler::current_call_node = 0;
+
+// Кадр профилировщика на время жизни объекта; nullptr – профилирование выключено
+struct ProfileScope {
+    ProfileEntry* entry;
+
+    ProfileScope(ProfileEntry* entry) : entry(Profiler::recording() ? entry : nullptr) {
+        if (this->entry) Profiler::enter(this->entry);
+    }
+
+    // Хвостовой вызов: текущий кадр закрывается, открывается кадр следующей функции
+    void switch_to(ProfileEntry* next) {
+        if (!entry) return;
+        Profiler::leave();
+        entry = next;
+        Profiler::enter(entry);
+    }
+
+    ~ProfileScope() {
+        if (entry) Profiler::leave();
+    }
+};
+
+// Вывод профиля в выбранном формате (text, json, collapsed) в файл или stdout
+void WriteProfile(const string& format, const string& output_path) {
+    ofstream file;
+    if (!output_path.empty()) {
+        file.open(output_path);
+        if (!file.good()) {
+            cout << MT::ERROR << "Cannot write profile to '" << output_path << "'" << endl;
+            return;
+        }
+    }
+    ostream& out = output_path.empty() ? cout : file;
+
+    if (format == "json")
+        Profiler::write_json(out);
+    else if (format == "collapsed")
+        Profiler::write_collapsed(out);
+    else
+        Profiler::print_report(out);
+
+    if (!output_path.empty())
+        cout << MT::SUCCESS << "Profile saved to '" << output_path << "'" << endl;
+}
@@ -0,0 +1,437 @@
+#include "twist-functions.cpp"
+#include "twist-nodetemp.cpp"
+#include "twist-native.cpp"
+
+#include <set>
+
+#pragma once
+
+/*
+ * PurityAnalyzer – проверка чистоты тела функции для memo-кэша.
+ *
+ * Функция считается чистой, если её результат зависит только от значений
+ * аргументов. Тело отклоняется, если в нём есть:
+ *   - ввод/вывод и завершение (out, outln, echo, input, exit);
+ *   - работа с указателями и кучей (new, del, &, *);
+ *   - объявления global, вложенные функции, лямбды, структуры, namespace;
+ *   - запись во что-либо, кроме локальных переменных и аргументов;
+ *   - чтение неконстантных внешних объектов;
+ *   - вызов чего-либо, кроме самой функции, преобразований типов (Int(x), ...)
+ *     и других чистых функций.
+ *
+ * Внешние имена проверяются в памяти функции на момент объявления – она
+ * содержит только глобальные объекты, которые будут видны при вызове.
+ * Результат анализа сохраняется в Function::purity. Взаимная рекурсия
+ * считается нечистой (анализ консервативен).
+ *
+ * Поля:
+ *   func   – анализируемая функция.
+ *   scopes – стек областей видимости с локальными именами.
+ *   reason – причина отказа (для сообщения об ошибке).
+ */
+
+struct PurityAnalyzer {
+    Function* func;
+    vector<set<string>> scopes;
+    string reason;
+
+    PurityAnalyzer(Function* func) : func(func) {}
+
+    static bool IsPure(Function* func, string& reason) {
+        if (func->purity != -1) {
+            if (!func->purity) reason = "calls impure function '" + func->name + "'";
+            return func->purity == 1;
+        }
+        // На время анализа – нечистая: защита от взаимной рекурсии
+        func->purity = 0;
+        PurityAnalyzer analyzer(func);
+        analyzer.scopes.emplace_back();
+        for (auto arg : func->arguments) {
+            if (arg->is_global)
+                return analyzer.fail("parameter '" + arg->name + "' is global", reason);
+            analyzer.scopes.back().insert(arg->name);
+        }
+        bool pure = analyzer.check(func->body);
+        func->purity = pure ? 1 : 0;
+        reason = analyzer.reason;
+        return pure;
+    }
+
+    bool fail(const string& why, string& out) {
+        out = why;
+        return false;
+    }
+
+    bool reject(const string& why) {
+        reason = why;
+        return false;
+    }
+
+    bool is_local(const string& name) {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it)
+            if (it->count(name)) return true;
+        return false;
+    }
+
+    // Цель записи должна сводиться к локальной переменной: x, x[i], x.f
+    bool check_target(Node* target) {
+        while (target) {
+            switch (target->NODE_TYPE) {
+                case NodeTypes::NODE_LITERAL: {
+                    auto& name = ((NodeLiteral*)target)->name;
+                    if (!is_local(name))
+                        return reject("writes to non-local '" + name + "'");
+                    return true;
+                }
+                case NodeTypes::NODE_GET_BY_INDEX: {
+                    auto index = (NodeGetIndex*)target;
+                    if (!check(index->index_expr)) return false;
+                    target = index->expr;
+                    break;
+                }
+                case NodeTypes::NODE_OBJECT_RESOLUTION:
+                    target = ((NodeObjectResolution*)target)->obj_expr;
+                    break;
+                case NodeTypes::NODE_SCOPES:
+                    target = ((NodeScopes*)target)->expression;
+                    break;
+                default:
+                    return reject("writes through an expression");
+            }
+        }
+        return true;
+    }
+
+    // Внешнее имя, прочитанное как значение
+    bool check_free_name(const string& name) {
+        if (name == func->name) return true;
+        auto object = func->memory->get_variable(name);
+        if (!object)
+            return reject("uses unknown name '" + name + "'");
+        if (object->value.type == STANDART_TYPE::TYPE)
+            return true;
+        if (!object->modifiers.is_const || !MemoCache::IsCacheable(object->value))
+            return reject("reads non-constant '" + name + "'");
+        return true;
+    }
+
+    // Вызываемое значение: сама функция, тип или чистая функция
+    bool check_callee(Node* callable) {
+        while (callable && callable->NODE_TYPE == NodeTypes::NODE_SCOPES)
+            callable = ((NodeScopes*)callable)->expression;
+        if (!callable)
+            return reject("calls an unknown expression");
+
+        Value callee = NewNull();
+        if (callable->NODE_TYPE == NodeTypes::NODE_LITERAL) {
+            auto& name = ((NodeLiteral*)callable)->name;
+            if (name == func->name) return true;
+            if (is_local(name))
+                return reject("calls local value '" + name + "'");
+            auto object = func->memory->get_variable(name);
+            if (object)
+                callee = object->value;
+            else if (auto native = NativeRegistry::find(Symbol(name)))
+                callee = *native;
+            else
+                return reject("calls unknown '" + name + "'");
+        } else if (callable->NODE_TYPE == NodeTypes::NODE_NAME_RESOLUTION) {
+            try {
+                callee = callable->eval_from(func->memory);
+            } catch (...) {
+                return reject("calls an unresolved namespace member");
+            }
+        } else {
+            return reject("calls a computed expression");
+        }
+
+        if (callee.type == STANDART_TYPE::TYPE)
+            return true;
+        if (callee.type.is_func()) {
+            string inner;
+            auto target = any_cast<Function*>(callee.data);
+            if (target == func || IsPure(target, inner))
+                return true;
+            return reject("calls impure function '" + target->name + "'");
+        }
+        if (callee.type == STANDART_TYPE::NATIVE) {
+            auto native = any_cast<NativeFunction*>(callee.data);
+            if (native->pure)
+                return true;
+            return reject("calls impure native function '" + native->name + "'");
+        }
+        return reject("calls a value of type `" + callee.type.pool + "`");
+    }
+
+    bool check_all(const vector<Node*>& nodes) {
+        for (auto node : nodes)
+            if (!check(node)) return false;
+        return true;
+    }
+
+    bool check_scoped(Node* node) {
+        scopes.emplace_back();
+        bool ok = check(node);
+        scopes.pop_back();
+        return ok;
+    }
+
+    bool check(Node* node) {
+        if (!node) return true;
+
+        switch (node->NODE_TYPE) {
+            case NodeTypes::NODE_NUMBER:
+            case NodeTypes::NODE_STRING:
+            case NodeTypes::NODE_CHAR:
+            case NodeTypes::NODE_BOOL:
+            case NodeTypes::NODE_NULL:
+            case NodeTypes::NODE_VALUE_HOLDER:
+            case NodeTypes::NODE_BREAK:
+            case NodeTypes::NODE_CONTINUE:
+            case NodeTypes::NODE_ARRAY_TYPE:
+            case NodeTypes::NODE_FUNCTION_TYPE:
+                return true;
+
+            case NodeTypes::NODE_LITERAL: {
+                auto& name = ((NodeLiteral*)node)->name;
+                return is_local(name) || check_free_name(name);
+            }
+            case NodeTypes::NODE_SCOPES:
+                return check(((NodeScopes*)node)->expression);
+            case NodeTypes::NODE_PROFILE:
+                return check(((NodeProfile*)node)->node);
+            case NodeTypes::NODE_UNARY:
+                return check(((NodeUnary*)node)->operand);
+            case NodeTypes::NODE_BINARY: {
+                auto binary = (NodeBinary*)node;
+                if (binary->op == "<-" && !check_target(binary->left))
+                    return false;
+                return check(binary->left) && check(binary->right);
+            }
+            case NodeTypes::NODE_TYPEOF:
+                return check(((NodeTypeof*)node)->expr);
+            case NodeTypes::NODE_SIZEOF:
+                return check(((NodeSizeof*)node)->expr);
+            case NodeTypes::NODE_ARRAY: {
+                for (auto& element : ((NodeArray*)node)->elements)
+                    if (!check(get<0>(element))) return false;
+                return true;
+            }
+            case NodeTypes::NODE_MAP: {
+                for (auto& key : ((NodeMap*)node)->keys)
+                    if (!check(get<0>(key))) return false;
+                for (auto value : ((NodeMap*)node)->values)
+                    if (!check(value)) return false;
+                return true;
+            }
+            case NodeTypes::NODE_GET_BY_INDEX: {
+                auto index = (NodeGetIndex*)node;
+                return check(index->expr) && check(index->index_expr);
+            }
+            case NodeTypes::NODE_OBJECT_RESOLUTION:
+                return check(((NodeObjectResolution*)node)->obj_expr);
+            case NodeTypes::NODE_NAME_RESOLUTION: {
+                // Допускаются только типы и чистые функции из namespace
+                Value member = NewNull();
+                try {
+                    member = node->eval_from(func->memory);
+                } catch (...) {
+                    return reject("uses an unresolved namespace member");
+                }
+                if (member.type == STANDART_TYPE::TYPE)
+                    return true;
+                return reject("reads namespace member '" + ((NodeNamespaceResolution*)node)->name + "'");
+            }
+            case NodeTypes::NODE_IF_EXPRESSION: {
+                auto if_expr = (NodeIfExpr*)node;
+                return check(if_expr->expr) && check(if_expr->true_expr) && check(if_expr->else_expr);
+            }
+            case NodeTypes::NODE_CALL: {
+                auto call = (NodeCall*)node;
+                return check_callee(call->callable) && check_all(call->args);
+            }
+
+            case NodeTypes::NODE_BLOCK_OF_NODES:
+                scopes.emplace_back();
+                if (!check_all(((NodeBlock*)node)->nodes_array)) return false;
+                scopes.pop_back();
+                return true;
+            case NodeTypes::NODE_EXPRESSION_STATEMENT:
+                return check(((NodeExpressionStatement*)node)->expr);
+            case NodeTypes::NODE_RETURN:
+                return check(((NodeReturn*)node)->expr);
+            case NodeTypes::NODE_ASSERT: {
+                auto assert_node = (NodeAssert*)node;
+                return check(assert_node->expr) && check(assert_node->message_expr);
+            }
+            case NodeTypes::NODE_IF: {
+                auto if_node = (NodeIf*)node;
+                return check(if_node->expr) && check_scoped(if_node->true_body) && check_scoped(if_node->else_body);
+            }
+            case NodeTypes::NODE_WHILE: {
+                auto while_node = (NodeWhile*)node;
+                return check(while_node->condition) && check_scoped(while_node->body);
+            }
+            case NodeTypes::NODE_DO_WHILE: {
+                auto do_while = (NodeDoWhile*)node;
+                return check_scoped(do_while->body) && check(do_while->condition);
+            }
+            case NodeTypes::NODE_FOR: {
+                auto for_node = (NodeFor*)node;
+                scopes.emplace_back();
+                bool ok = check(for_node->start_state) && check(for_node->condition) &&
+                          check(for_node->update_state) && check_scoped(for_node->body);
+                scopes.pop_back();
+                return ok;
+            }
+            case NodeTypes::NODE_FOR_IN: {
+                auto loop = (NodeForIn*)node;
+                if (!check(loop->iterable) || !check(loop->range_end))
+                    return false;
+                scopes.emplace_back();
+                scopes.back().insert(loop->var_name);
+                bool ok = check_scoped(loop->body);
+                scopes.pop_back();
+                return ok;
+            }
+            case NodeTypes::NODE_YIELD:
+                return reject("uses yield");
+            case NodeTypes::NODE_PARALLEL_FOR:
+                return reject("uses parallel for");
+            case NodeTypes::NODE_SPAWN:
+                return reject("uses spawn");
+            case NodeTypes::NODE_AWAIT:
+                return reject("uses await");
+            case NodeTypes::NODE_VARIABLE_DECLARATION: {
+                auto decl = (NodeVariableDeclaration*)node;
+                if (decl->is_global)
+                    return reject("declares global '" + decl->var_name + "'");
+                if (!check(decl->type_expr) || !check(decl->value_expr))
+                    return false;
+                scopes.back().insert(decl->var_name);
+                return true;
+            }
+            case NodeTypes::NODE_VARIABLE_EQUAL: {
+                auto equal = (NodeVariableEqual*)node;
+                return check_target(equal->variable) && check(equal->expression);
+            }
+            case NodeTypes::NODE_ARRAY_PUSH: {
+                auto push = (NodeArrayPush*)node;
+                return check_target(push->left_expr) && check(push->right_expr);
+            }
+            // Слитые узлы проверяются по исходному поддереву
+            case NodeTypes::NODE_INCREMENT_LOCAL:
+                return check(((NodeIncrementLocal*)node)->fallback);
+            case NodeTypes::NODE_COMPARE_LOCAL:
+                return check(((NodeCompareLocal*)node)->fallback);
+            case NodeTypes::NODE_PUSH_LOCAL:
+                return check(((NodePushLocal*)node)->fallback);
+            case NodeTypes::NODE_ADD_LOCAL:
+                return check(((NodeAddLocal*)node)->fallback);
+
+            case NodeTypes::NODE_OUT:
+            case NodeTypes::NODE_OUTLN:
+            case NodeTypes::NODE_ECHO:
+                return reject("writes output");
+            case NodeTypes::NODE_INPUT:
+                return reject("reads input");
+            case NodeTypes::NODE_EXIT:
+                return reject("calls exit");
+            case NodeTypes::NODE_NEW:
+            case NodeTypes::NODE_DELETE:
+            case NodeTypes::NODE_ADDRESS_OF:
+            case NodeTypes::NODE_DEREFERENCE:
+            case NodeTypes::NODE_LEFT_DEREFERENCE:
+                return reject("uses pointers");
+            case NodeTypes::NODE_LAMBDA:
+                return reject("creates a lambda");
+            default:
+                return reject(string("contains ") + get_node_type_name(node->NODE_TYPE));
+        }
+    }
+};
+
+/*
+ * IsSideEffectFree – выражение только читает значения и не может изменить
+ * переменные (используется NodeVariableEqual для дописывания строки на месте).
+ * Разрешены литералы, чтение переменных, полей, элементов, разыменование,
+ * операторы (кроме <-) и вызовы по имени; имена вызываемых объектов
+ * добавляются в type_callees – при выполнении они должны оказаться типами
+ * (String(x), Int(x), ...), иначе быстрый путь не используется.
+ */
+bool IsSideEffectFree(Node* node, vector<string>& type_callees) {
+    if (!node) return true;
+    switch (node->NODE_TYPE) {
+        case NodeTypes::NODE_NUMBER:
+        case NodeTypes::NODE_STRING:
+        case NodeTypes::NODE_CHAR:
+        case NodeTypes::NODE_BOOL:
+        case NodeTypes::NODE_NULL:
+        case NodeTypes::NODE_VALUE_HOLDER:
+        case NodeTypes::NODE_LITERAL:
+            return true;
+        case NodeTypes::NODE_SCOPES:
+            return IsSideEffectFree(((NodeScopes*)node)->expression, type_callees);
+        case NodeTypes::NODE_COMPARE_LOCAL:
+            return IsSideEffectFree(((NodeCompareLocal*)node)->fallback, type_callees);
+        case NodeTypes::NODE_UNARY:
+            return IsSideEffectFree(((NodeUnary*)node)->operand, type_callees);
+        case NodeTypes::NODE_BINARY: {
+            auto binary = (NodeBinary*)node;
+            return binary->op != "<-" && IsSideEffectFree(binary->left, type_callees) &&
+                   IsSideEffectFree(binary->right, type_callees);
+        }
+        case NodeTypes::NODE_TYPEOF:
+            return IsSideEffectFree(((NodeTypeof*)node)->expr, type_callees);
+        case NodeTypes::NODE_SIZEOF:
+            return IsSideEffectFree(((NodeSizeof*)node)->expr, type_callees);
+        case NodeTypes::NODE_DEREFERENCE:
+            return IsSideEffectFree(((NodeDereference*)node)->expr, type_callees);
+        case NodeTypes::NODE_GET_BY_INDEX: {
+            auto index = (NodeGetIndex*)node;
+            return IsSideEffectFree(index->expr, type_callees) && IsSideEffectFree(index->index_expr, type_callees);
+        }
+        case NodeTypes::NODE_OBJECT_RESOLUTION:
+            return IsSideEffectFree(((NodeObjectResolution*)node)->obj_expr, type_callees);
+        case NodeTypes::NODE_IF_EXPRESSION: {
+            auto if_expr = (NodeIfExpr*)node;
+            return IsSideEffectFree(if_expr->expr, type_callees) && IsSideEffectFree(if_expr->true_expr, type_callees) &&
+                   IsSideEffectFree(if_expr->else_expr, type_callees);
+        }
+        case NodeTypes::NODE_CALL: {
+            auto call = (NodeCall*)node;
+            if (!call->callable || call->callable->NODE_TYPE != NodeTypes::NODE_LITERAL)
+                return false;
+            for (auto arg : call->args)
+                if (!IsSideEffectFree(arg, type_callees)) return false;
+            type_callees.push_back(((NodeLiteral*)call->callable)->name);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Подключение memo-кэша к функции. false – функция не чистая (reason – причина).
+bool EnableFunctionMemo(Function* func, string& reason) {
+    if (!PurityAnalyzer::IsPure(func, reason))
+        return false;
+    if (!func->memo) {
+        func->memo = new MemoCache();
+        MemoizedFunctions().push_back(func);
+    }
+    return true;
+}
+
+// Вывод счётчиков memo-кэша (-memo-stats)
+void PrintMemoStats() {
+    cout << MT::INFO + "Memo cache: " + to_string(MemoizedFunctions().size()) + " function(s)" << endl;
+    for (auto func : MemoizedFunctions()) {
+        auto memo = func->memo;
+        size_t total = memo->hits + memo->misses;
+        cout << MT::INFO + "  " + func->name + ": hits " + to_string(memo->hits) +
+                ", misses " + to_string(memo->misses) +
+                ", entries " + to_string(memo->entries.size()) +
+                (total ? ", hit rate " + to_string(memo->hits * 100 / total) + "%" : "") << endl;
+    }
+}
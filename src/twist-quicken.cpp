@@ -0,0 +1,132 @@
+#include "twist-values.cpp"
+#include "twist-stats.cpp"
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+
+#pragma once
+
+/*
+ * Квикенинг – специализация горячих узлов по типам операндов.
+ *
+ * Обобщённый путь NodeBinary / NodeIf / NodeWhile / NodeFor на каждом
+ * выполнении заново выясняет типы цепочкой сравнений `value.type == ...`
+ * (сравнение Type – visit по variant и сравнение имён). На практике одно
+ * место в программе почти всегда видит одни и те же типы, поэтому узел
+ * первые QUICKEN_AFTER выполнений работает обобщённо, затем смотрит на
+ * типы текущих операндов и переключается в специализированный режим
+ * (Int-Int, Double-Double, String-String для операторов, Bool или Int для
+ * условий).
+ *
+ * В специализированном режиме проверка типа – страж по std::any: тип
+ * данных однозначно соответствует типу Value (Int – int64_t, Double –
+ * NUMBER_ACCURACY, String – RuntimeString, Bool – bool), а any_cast по
+ * указателю сравнивает лишь адрес менеджера. Если страж не прошёл, узел
+ * выполняет обобщённый путь с теми же значениями (результат и ошибки не
+ * меняются) и деоптимизируется: снова прогревается и выбирает режим заново.
+ * После QUICKEN_MAX_DEOPTS деоптимизаций узел остаётся обобщённым.
+ *
+ * Состояние – атомарные счётчики с relaxed-доступом: AST выполняется и из
+ * нескольких потоков (parallel for, spawn), потерянное обновление счётчика
+ * лишь сдвигает момент специализации. -no-quicken отключает специализацию
+ * (для сравнения производительности).
+ */
+
+#define QUICKEN_AFTER 16        // обобщённых выполнений до специализации
+#define QUICKEN_MAX_DEOPTS 4    // деоптимизаций, после которых узел остаётся обобщённым
+
+// -no-quicken
+static bool quicken_nodes = true;
+
+enum class QuickMode : uint8_t {
+    WARMUP,         // обобщённый путь, считаются выполнения
+    GENERIC,        // обобщённый путь навсегда
+    BOOL,           // условие – Bool
+    INT,            // условие – Int
+    INT_INT,
+    DOUBLE_DOUBLE,
+    STRING_STRING,
+};
+
+struct QuickeningState {
+    std::atomic<QuickMode> mode{QuickMode::WARMUP};
+    std::atomic<uint32_t> executions{0};
+    std::atomic<uint32_t> deopts{0};
+
+    QuickMode current() const {
+        return mode.load(std::memory_order_relaxed);
+    }
+
+    // Учёт выполнения при прогреве; true – пора выбрать режим
+    bool tick() {
+        uint32_t count = executions.load(std::memory_order_relaxed) + 1;
+        executions.store(count, std::memory_order_relaxed);
+        return count >= QUICKEN_AFTER;
+    }
+
+    void specialize(QuickMode next) {
+        if (!quicken_nodes)
+            next = QuickMode::GENERIC;
+        if (next != QuickMode::GENERIC)
+            STAT_INC(quickenings);
+        mode.store(next, std::memory_order_relaxed);
+    }
+
+    void deoptimize() {
+        STAT_INC(deoptimizations);
+        uint32_t count = deopts.load(std::memory_order_relaxed) + 1;
+        deopts.store(count, std::memory_order_relaxed);
+        executions.store(0, std::memory_order_relaxed);
+        mode.store(count >= QUICKEN_MAX_DEOPTS ? QuickMode::GENERIC : QuickMode::WARMUP, std::memory_order_relaxed);
+    }
+};
+
+// Стражи типа по данным std::any
+inline const int64_t* QuickInt(const Value& value) { return std::any_cast<int64_t>(&value.data); }
+inline const NUMBER_ACCURACY* QuickDouble(const Value& value) { return std::any_cast<NUMBER_ACCURACY>(&value.data); }
+inline const bool* QuickBool(const Value& value) { return std::any_cast<bool>(&value.data); }
+inline const RuntimeString* QuickString(const Value& value) { return std::any_cast<RuntimeString>(&value.data); }
+
+// Режим пары операндов по их текущим типам
+inline QuickMode ObservePair(const Value& left, const Value& right) {
+    if (QuickInt(left) && QuickInt(right))
+        return QuickMode::INT_INT;
+    if (QuickDouble(left) && QuickDouble(right))
+        return QuickMode::DOUBLE_DOUBLE;
+    if (QuickString(left) && QuickString(right))
+        return QuickMode::STRING_STRING;
+    return QuickMode::GENERIC;
+}
+
+/*
+ * Условие if / while / for в специализированном режиме. true – значение
+ * условия получено (condition), false – узел вычисляет его обобщённо
+ * (при прогреве здесь же выбирается режим, при промахе стража –
+ * деоптимизация).
+ */
+inline bool QuickCondition(QuickeningState& state, const Value& value, bool& condition) {
+    switch (state.current()) {
+        case QuickMode::BOOL:
+            if (auto flag = QuickBool(value)) {
+                condition = *flag;
+                return true;
+            }
+            break;
+        case QuickMode::INT:
+            if (auto number = QuickInt(value)) {
+                condition = *number != 0;
+                return true;
+            }
+            break;
+        case QuickMode::WARMUP:
+            if (state.tick())
+                state.specialize(QuickBool(value) ? QuickMode::BOOL :
+                                 QuickInt(value) ? QuickMode::INT : QuickMode::GENERIC);
+            return false;
+        default:
+            return false;
+    }
+    state.deoptimize();
+    return false;
+}
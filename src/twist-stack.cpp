@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include "twist-context.cpp"
+
+#ifdef _WIN32
+    #include <process.h>
+#else
+    #include <pthread.h>
+    #include <sys/resource.h>
+#endif
+
+#pragma once
+
+/*
+ * NativeStack – контроль запаса нативного стека потока исполнения.
+ *
+ * Каждый уровень вызова Lumen проходит через несколько вложенных
+ * eval_from/exec_from и блоков try/catch, поэтому глубину рекурсии
+ * ограничивает реальный размер стека C++, а не число вызовов.
+ *
+ * run() запускает интерпретацию в отдельном потоке со стеком заданного
+ * размера и запоминает его границы. exhausted() сравнивает текущий адрес
+ * стека с началом и сообщает, что оставшийся запас меньше резерва –
+ * в этом случае вызов завершается ошибкой Lumen вместо падения процесса.
+ *
+ * Границы стека свои у каждого потока. Поток исполнения получает контекст
+ * запуска (RuntimeContext), привязанный к вызвавшему run() потоку.
+ *
+ * Поля:
+ *   base – адрес начала стека (стек растёт вниз), nullptr – не подключён.
+ *   size – доступный размер стека в байтах.
+ */
+
+// Размер стека потока исполнения по умолчанию (МБ)
+#define DEFAULT_NATIVE_STACK_MB 256
+// Резерв стека под обработку ошибки и раскрутку исключения
+#define NATIVE_STACK_RESERVE (256 * 1024)
+// Размер стека основного потока, если его нельзя узнать
+#define FALLBACK_MAIN_STACK (1024 * 1024)
+
+struct NativeStack {
+    static thread_local char* base;
+    static thread_local size_t size;
+
+    static void attach(size_t stack_size) {
+        char marker;
+        base = &marker;
+        size = stack_size;
+    }
+
+    // Подключение к текущему (основному) потоку с системным размером стека
+    static void attach_current() {
+        size_t stack_size = FALLBACK_MAIN_STACK;
+        #ifndef _WIN32
+            struct rlimit limit;
+            if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+                stack_size = (size_t)limit.rlim_cur;
+        #endif
+        attach(stack_size);
+    }
+
+    static bool exhausted() {
+        if (!base) return false;
+        char marker;
+        size_t used = (size_t)(base - &marker);
+        return used + NATIVE_STACK_RESERVE >= size;
+    }
+
+    // Выполнение task в потоке со стеком stack_size байт
+    static void run(size_t stack_size, const std::function<void()>& task) {
+        struct Job {
+            const std::function<void()>* task;
+            size_t stack_size;
+            RuntimeContext* context;
+            std::promise<void> done;
+        } job{&task, stack_size, RuntimeContext::bound(), {}};
+
+        #ifdef _WIN32
+            // _beginthread сам закрывает дескриптор, завершение ждём через promise
+            auto future = job.done.get_future();
+            auto entry = [](void* arg) {
+                Job* job = (Job*)arg;
+                RuntimeContext::Scope scope(job->context);
+                NativeStack::attach(job->stack_size);
+                (*job->task)();
+                job->done.set_value();
+            };
+            if (_beginthread(entry, (unsigned)stack_size, &job) == (uintptr_t)-1L) {
+                attach_current();
+                task();
+                return;
+            }
+            future.wait();
+        #else
+            auto entry = [](void* arg) -> void* {
+                Job* job = (Job*)arg;
+                RuntimeContext::Scope scope(job->context);
+                NativeStack::attach(job->stack_size);
+                (*job->task)();
+                return nullptr;
+            };
+            pthread_attr_t attr;
+            pthread_t thread;
+            pthread_attr_init(&attr);
+            pthread_attr_setstacksize(&attr, stack_size);
+            int status = pthread_create(&thread, &attr, entry, &job);
+            pthread_attr_destroy(&attr);
+            if (status != 0) {
+                attach_current();
+                task();
+                return;
+            }
+            pthread_join(thread, nullptr);
+        #endif
+    }
+};
+
+thread_local char* NativeStack::base = nullptr;
+thread_local size_t NativeStack::size = 0;
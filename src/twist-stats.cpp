@@ -0,0 +1,127 @@
+#include "twist-utils.cpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#pragma once
+
+/*
+ * RuntimeStats – счётчики внутренних событий интерпретатора (--stats).
+ *
+ * Счётчики компилируются только при сборке с -DLUMEN_STATS: в обычной сборке
+ * макросы STAT_INC / STAT_PEAK раскрываются в пустоту и не стоят ничего.
+ * --stats в такой сборке лишь сообщает, что счётчики недоступны.
+ *
+ * Учитываются:
+ *   value_copies        – копирования Value (конструктор и присваивание);
+ *   memory_objects      – созданные MemoryObject;
+ *   memories            – созданные Memory (области видимости, вызовы);
+ *   pool_lookups        – поиски имени в Memory::string_pool;
+ *   static_registrations – регистрации объектов в STATIC_MEMORY;
+ *   throws_*            – выброшенные Return / Break / Continue / TailCall / Error;
+ *   function_calls, lambda_calls – вызовы (хвостовые тоже считаются);
+ *   peak_call_depth     – наибольшая глубина вложенных вызовов функций;
+ *   quickenings, deoptimizations – специализации узлов по типам и откаты
+ *                         (twist-quicken.cpp);
+ *   jit_compilations, jit_calls, jit_bailouts – скомпилированные функции,
+ *                         вызовы машинного кода и возвраты в интерпретатор
+ *                         (twist-jit.cpp).
+ *
+ * Счётчики увеличиваются и из рабочих потоков (parallel for, pmap, spawn,
+ * lumen::Context в разных потоках), поэтому они атомарные: relaxed-
+ * инкремент, пик – через compare_exchange.
+ */
+
+#ifdef LUMEN_STATS
+    #define STAT_INC(counter) (RuntimeStats::counter.fetch_add(1, std::memory_order_relaxed))
+    #define STAT_PEAK(counter, value) (RuntimeStats::peak(RuntimeStats::counter, (uint64_t)(value)))
+#else
+    #define STAT_INC(counter) ((void)0)
+    #define STAT_PEAK(counter, value) ((void)0)
+#endif
+
+struct RuntimeStats {
+    static std::atomic<uint64_t> value_copies;
+    static std::atomic<uint64_t> memory_objects;
+    static std::atomic<uint64_t> memories;
+    static std::atomic<uint64_t> pool_lookups;
+    static std::atomic<uint64_t> static_registrations;
+    static std::atomic<uint64_t> throws_return;
+    static std::atomic<uint64_t> throws_break;
+    static std::atomic<uint64_t> throws_continue;
+    static std::atomic<uint64_t> throws_tail_call;
+    static std::atomic<uint64_t> throws_error;
+    static std::atomic<uint64_t> function_calls;
+    static std::atomic<uint64_t> lambda_calls;
+    static std::atomic<uint64_t> peak_call_depth;
+    static std::atomic<uint64_t> quickenings;
+    static std::atomic<uint64_t> deoptimizations;
+    static std::atomic<uint64_t> jit_compilations;
+    static std::atomic<uint64_t> jit_calls;
+    static std::atomic<uint64_t> jit_bailouts;
+
+    static void peak(std::atomic<uint64_t>& counter, uint64_t value) {
+        uint64_t current = counter.load(std::memory_order_relaxed);
+        while (value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    static constexpr bool available() {
+        #ifdef LUMEN_STATS
+            return true;
+        #else
+            return false;
+        #endif
+    }
+
+    static void print(std::ostream& out) {
+        if (!available()) {
+            out << MT::WARNING << "--stats: interpreter was built without -DLUMEN_STATS, counters are unavailable" << std::endl;
+            return;
+        }
+        auto line = [&](const std::string& label, const std::atomic<uint64_t>& counter) {
+            uint64_t value = counter.load(std::memory_order_relaxed);
+            out << MT::INFO << "  " << label << std::string(label.size() < 22 ? 22 - label.size() : 1, ' ')
+                << value << std::endl;
+        };
+        out << MT::INFO << "Runtime stats:" << std::endl;
+        line("value copies", value_copies);
+        line("memory objects", memory_objects);
+        line("memories", memories);
+        line("string_pool lookups", pool_lookups);
+        line("static registrations", static_registrations);
+        line("throw Return", throws_return);
+        line("throw Break", throws_break);
+        line("throw Continue", throws_continue);
+        line("throw TailCall", throws_tail_call);
+        line("throw Error", throws_error);
+        line("function calls", function_calls);
+        line("lambda calls", lambda_calls);
+        line("peak call depth", peak_call_depth);
+        line("quickenings", quickenings);
+        line("deoptimizations", deoptimizations);
+        line("jit compilations", jit_compilations);
+        line("jit calls", jit_calls);
+        line("jit bailouts", jit_bailouts);
+    }
+};
+
+std::atomic<uint64_t> RuntimeStats::value_copies{0};
+std::atomic<uint64_t> RuntimeStats::memory_objects{0};
+std::atomic<uint64_t> RuntimeStats::memories{0};
+std::atomic<uint64_t> RuntimeStats::pool_lookups{0};
+std::atomic<uint64_t> RuntimeStats::static_registrations{0};
+std::atomic<uint64_t> RuntimeStats::throws_return{0};
+std::atomic<uint64_t> RuntimeStats::throws_break{0};
+std::atomic<uint64_t> RuntimeStats::throws_continue{0};
+std::atomic<uint64_t> RuntimeStats::throws_tail_call{0};
+std::atomic<uint64_t> RuntimeStats::throws_error{0};
+std::atomic<uint64_t> RuntimeStats::function_calls{0};
+std::atomic<uint64_t> RuntimeStats::lambda_calls{0};
+std::atomic<uint64_t> RuntimeStats::peak_call_depth{0};
+std::atomic<uint64_t> RuntimeStats::quickenings{0};
+std::atomic<uint64_t> RuntimeStats::deoptimizations{0};
+std::atomic<uint64_t> RuntimeStats::jit_compilations{0};
+std::atomic<uint64_t> RuntimeStats::jit_calls{0};
+std::atomic<uint64_t> RuntimeStats::jit_bailouts{0};
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#pragma once
+
+/*
+ * RuntimeString – строковое значение Lumen (данные Value с типом String).
+ *
+ * Размер – одно машинное слово, поэтому std::any хранит строку внутри себя,
+ * без отдельного выделения под держатель:
+ *   - строки до STRING_INLINE_CAPACITY байт хранятся прямо в слове (младший
+ *     бит байта-метки = 1, в нём же длина);
+ *   - длинные строки – в неизменяемом буфере StringBuffer со счётчиком
+ *     ссылок, длиной и кэшированным хэшем.
+ *
+ * Копирование – увеличение счётчика, поэтому передача строки в функцию,
+ * чтение переменной, String(s), индексирование и sizeof не копируют символы.
+ * Сравнение == сначала сравнивает буферы, длины и кэшированные хэши.
+ *
+ * Строка неизменяема для всех владельцев. append() меняет буфер на месте
+ * только если он единственный (refs == 1) и в нём есть место – это не видно
+ * снаружи и даёт линейную сборку `s = s + ...` (NodeVariableEqual); иначе
+ * создаётся новый буфер с запасом.
+ */
+
+// Длина строки, хранимой без выделения памяти
+#define STRING_INLINE_CAPACITY 7
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    #define STRING_TAG_BYTE 7
+    #define STRING_INLINE_OFFSET 0
+#else
+    #define STRING_TAG_BYTE 0
+    #define STRING_INLINE_OFFSET 1
+#endif
+
+struct StringBuffer {
+    std::atomic<uint32_t> refs;
+    size_t length;
+    size_t capacity;
+    std::atomic<size_t> hash;   // 0 – ещё не вычислен (буфер может читаться из нескольких потоков)
+    char data[1];
+
+    static StringBuffer* allocate(size_t capacity) {
+        void* memory = ::operator new(offsetof(StringBuffer, data) + capacity);
+        auto buffer = new (memory) StringBuffer;
+        buffer->refs.store(1, std::memory_order_relaxed);
+        buffer->length = 0;
+        buffer->capacity = capacity;
+        buffer->hash.store(0, std::memory_order_relaxed);
+        return buffer;
+    }
+
+    static void release(StringBuffer* buffer) {
+        if (buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            buffer->~StringBuffer();
+            ::operator delete(buffer);
+        }
+    }
+};
+
+struct RuntimeString {
+    union {
+        StringBuffer* heap;
+        char raw[8];
+    };
+
+    RuntimeString() noexcept { set_inline(nullptr, 0); }
+
+    explicit RuntimeString(std::string_view str) { assign(str.data(), str.size()); }
+    explicit RuntimeString(const std::string& str) { assign(str.data(), str.size()); }
+
+    RuntimeString(const RuntimeString& other) noexcept {
+        memcpy(raw, other.raw, sizeof(raw));
+        if (!is_inline()) heap->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    RuntimeString(RuntimeString&& other) noexcept {
+        memcpy(raw, other.raw, sizeof(raw));
+        other.set_inline(nullptr, 0);
+    }
+
+    RuntimeString& operator=(const RuntimeString& other) noexcept {
+        if (this != &other) {
+            RuntimeString copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    RuntimeString& operator=(RuntimeString&& other) noexcept {
+        if (this != &other) {
+            release();
+            memcpy(raw, other.raw, sizeof(raw));
+            other.set_inline(nullptr, 0);
+        }
+        return *this;
+    }
+
+    ~RuntimeString() { release(); }
+
+    bool is_inline() const { return raw[STRING_TAG_BYTE] & 1; }
+
+    size_t size() const {
+        return is_inline() ? (size_t)((unsigned char)raw[STRING_TAG_BYTE] >> 1) : heap->length;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Указатель на символы (без завершающего нуля); для короткой строки –
+    // внутрь объекта, действителен пока объект не перемещён
+    const char* data() const {
+        return is_inline() ? raw + STRING_INLINE_OFFSET : heap->data;
+    }
+
+    std::string_view view() const { return std::string_view(data(), size()); }
+    std::string str() const { return std::string(data(), size()); }
+
+    char operator[](size_t index) const { return data()[index]; }
+
+    size_t hash() const {
+        if (is_inline())
+            return std::hash<std::string_view>()(view());
+        size_t cached = heap->hash.load(std::memory_order_relaxed);
+        if (!cached) {
+            cached = std::hash<std::string_view>()(view());
+            heap->hash.store(cached, std::memory_order_relaxed);
+        }
+        return cached;
+    }
+
+    bool operator==(const RuntimeString& other) const {
+        if (memcmp(raw, other.raw, sizeof(raw)) == 0)
+            return true;    // тот же буфер или одинаковая короткая строка
+        size_t length = size();
+        if (length != other.size() || is_inline() || other.is_inline())
+            return false;   // короткие строки равной длины совпали бы побайтно
+        size_t left_hash = heap->hash.load(std::memory_order_relaxed);
+        size_t right_hash = other.heap->hash.load(std::memory_order_relaxed);
+        if (left_hash && right_hash && left_hash != right_hash)
+            return false;
+        return memcmp(heap->data, other.heap->data, length) == 0;
+    }
+
+    bool operator!=(const RuntimeString& other) const { return !(*this == other); }
+
+    void append(const char* str, size_t length) {
+        size_t old_length = size();
+        size_t total = old_length + length;
+        if (is_inline() && total <= STRING_INLINE_CAPACITY) {
+            memcpy(raw + STRING_INLINE_OFFSET + old_length, str, length);
+            raw[STRING_TAG_BYTE] = (char)((total << 1) | 1);
+            return;
+        }
+        if (!is_inline() && heap->refs.load(std::memory_order_acquire) == 1 && total <= heap->capacity) {
+            memcpy(heap->data + old_length, str, length);
+            heap->length = total;
+            heap->hash.store(0, std::memory_order_relaxed);
+            return;
+        }
+        // Новый буфер с запасом: повторное дописывание – амортизированно O(1)
+        auto buffer = StringBuffer::allocate(std::max(total, old_length * 2));
+        memcpy(buffer->data, data(), old_length);
+        memcpy(buffer->data + old_length, str, length);
+        buffer->length = total;
+        release();
+        set_heap(buffer);
+    }
+
+    void append(std::string_view str) { append(str.data(), str.size()); }
+    void append(const RuntimeString& str) {
+        // str может совпадать с *this – копия держит буфер на время дописывания
+        RuntimeString keep(str);
+        append(keep.data(), keep.size());
+    }
+
+    static RuntimeString concat(const RuntimeString& left, const RuntimeString& right) {
+        if (right.empty()) return left;
+        if (left.empty()) return right;
+        RuntimeString result;
+        result.reserve_exact(left.size() + right.size());
+        result.append(left.data(), left.size());
+        result.append(right.data(), right.size());
+        return result;
+    }
+
+    void swap(RuntimeString& other) noexcept {
+        char tmp[8];
+        memcpy(tmp, raw, sizeof(raw));
+        memcpy(raw, other.raw, sizeof(raw));
+        memcpy(other.raw, tmp, sizeof(raw));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const RuntimeString& str) {
+        return os << str.view();
+    }
+
+private:
+    void set_inline(const char* str, size_t length) {
+        memset(raw, 0, sizeof(raw));
+        if (length) memcpy(raw + STRING_INLINE_OFFSET, str, length);
+        raw[STRING_TAG_BYTE] = (char)((length << 1) | 1);
+    }
+
+    void set_heap(StringBuffer* buffer) {
+        memset(raw, 0, sizeof(raw));
+        heap = buffer;
+    }
+
+    void assign(const char* str, size_t length) {
+        if (length <= STRING_INLINE_CAPACITY) {
+            set_inline(str, length);
+            return;
+        }
+        auto buffer = StringBuffer::allocate(length);
+        memcpy(buffer->data, str, length);
+        buffer->length = length;
+        set_heap(buffer);
+    }
+
+    // Пустая строка с буфером под length символов (для concat)
+    void reserve_exact(size_t length) {
+        if (length <= STRING_INLINE_CAPACITY) return;
+        release();
+        set_heap(StringBuffer::allocate(length));
+    }
+
+    void release() {
+        if (!is_inline()) StringBuffer::release(heap);
+    }
+};
+
+namespace std {
+    template <>
+    struct hash<RuntimeString> {
+        size_t operator()(const RuntimeString& str) const noexcept { return str.hash(); }
+    };
+}
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#pragma once
+
+/*
+ * Symbol – интернированное имя (идентификатор переменной, поля, параметра).
+ *
+ * Каждое имя хранится в SymbolTable один раз и получает постоянный номер.
+ * Memory::string_pool использует Symbol как ключ: сравнение и хэш – одно
+ * число вместо строки. Узлы AST (NodeLiteral, NodeObjectResolution,
+ * NodeNamespaceResolution, Arg) интернируют имя при создании, поэтому при
+ * выполнении строка не хэшируется вовсе.
+ *
+ * Symbol неявно создаётся из std::string / const char*, так что остальной код
+ * может по-прежнему передавать в Memory строки (имя интернируется на месте).
+ * Таблица только растёт: имена живут до конца программы, name() возвращает
+ * стабильную ссылку.
+ *
+ * Таблица общая для всех программ процесса (см. RuntimeContext): intern()
+ * защищён shared_mutex, а имена лежат в блоках фиксированного размера, которые
+ * никогда не перемещаются, поэтому name() читает их без блокировки.
+ */
+
+// Имён в одном блоке и максимальное число блоков
+#define SYMBOL_BLOCK_SIZE 4096
+#define SYMBOL_MAX_BLOCKS 16384
+
+struct SymbolTable {
+    // Функции со статическими локальными – таблица готова к первому Symbol,
+    // даже если он создаётся при статической инициализации
+    static std::unordered_map<std::string, uint32_t>& ids() {
+        static std::unordered_map<std::string, uint32_t> table;
+        return table;
+    }
+
+    static std::atomic<const std::string**>* blocks() {
+        static std::atomic<const std::string**> table[SYMBOL_MAX_BLOCKS];
+        return table;
+    }
+
+    static std::shared_mutex& lock() {
+        static std::shared_mutex mutex;
+        return mutex;
+    }
+
+    static uint32_t intern(const std::string& name) {
+        auto& table = ids();
+        {
+            std::shared_lock<std::shared_mutex> read(lock());
+            auto it = table.find(name);
+            if (it != table.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> write(lock());
+        auto it = table.find(name);
+        if (it != table.end()) return it->second;
+        auto id = (uint32_t)table.size();
+        auto& block = blocks()[id / SYMBOL_BLOCK_SIZE];
+        if (!block.load(std::memory_order_relaxed))
+            block.store(new const std::string*[SYMBOL_BLOCK_SIZE], std::memory_order_release);
+        auto inserted = table.emplace(name, id).first;
+        block.load(std::memory_order_relaxed)[id % SYMBOL_BLOCK_SIZE] = &inserted->first;
+        return id;
+    }
+
+    static const std::string& name(uint32_t id) {
+        return *blocks()[id / SYMBOL_BLOCK_SIZE].load(std::memory_order_acquire)[id % SYMBOL_BLOCK_SIZE];
+    }
+};
+
+struct Symbol {
+    uint32_t id;
+
+    Symbol() : id(SymbolTable::intern(std::string())) {}
+    Symbol(const std::string& name) : id(SymbolTable::intern(name)) {}
+    Symbol(const char* name) : id(SymbolTable::intern(name)) {}
+
+    const std::string& name() const { return SymbolTable::name(id); }
+
+    bool operator==(const Symbol& other) const { return id == other.id; }
+    bool operator!=(const Symbol& other) const { return id != other.id; }
+};
+
+namespace std {
+    template <>
+    struct hash<Symbol> {
+        size_t operator()(const Symbol& symbol) const noexcept { return symbol.id; }
+    };
+}
@@ -0,0 +1,704 @@
+#include "twist-context.cpp"
+#include "twist-memory.cpp"
+#include "twist-output.cpp"
+#include "twist-parallel.cpp"
+#include "twist-profiler.cpp"
+#include "twist-native.cpp"
+#include "twist-err.cpp"
+#include "twist-functions.cpp"
+#include "twist-lambda.cpp"
+#include "twist-namespace.cpp"
+#include "twist-structs.cpp"
+#include "twist-array.cpp"
+#include "twist-map.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#pragma once
+
+/*
+ * Задачи (spawn / await) и каналы.
+ *
+ *     func produce(out: Channel, n: Int) -> Int { ... send(out, i); ... close(out); ret n; }
+ *
+ *     let lines = Channel(16);
+ *     let producer = spawn produce(lines, 100);    // Future
+ *     let line = recv(lines);                      // null – канал закрыт и пуст
+ *     let count = await producer;                  // результат produce
+ *
+ * spawn f(a, b) вычисляет f и аргументы на месте и ставит вызов в очередь
+ * пула TaskPool, сразу возвращая Future. await ждёт завершения задачи и
+ * возвращает её результат; ошибка задачи становится ошибкой await.
+ *
+ * Изоляция. Задача выполняется в своём RuntimeContext параллельно с
+ * запустившим её кодом и не видит его памяти:
+ *   - при spawn делается снимок (TaskSnapshot) памяти объявления f и всей
+ *     памяти, достижимой из неё через функции, лямбды, пространства имён и
+ *     структуры. В задаче DeclarationMemory подменяет память объявлений
+ *     снимком, поэтому изменения глобальных переменных видны только ей;
+ *   - аргументы, результат и сообщения каналов копируются (Value копирует
+ *     массивы и таблицы, буфер строки неизменяем и общий). Указатели,
+ *     экземпляры структур, пространства имён и генераторы передавать
+ *     нельзя, функции и лямбды – только аргументами spawn (их память
+ *     попадает в снимок);
+ *   - вывод задачи собирается отдельно и выводится при первом await, а если
+ *     задачу никто не ждал – в конце программы, в порядке запуска;
+ *   - input внутри задачи запрещён.
+ *
+ * Задачи запуска хранятся в корневом контексте; JoinTasks в конце программы
+ * дожидается всех, а ошибку задачи, которую никто не ждал, сообщает как
+ * ошибку программы.
+ *
+ * Каналы. Channel(n) – очередь сообщений на n мест, общая для всех, кому
+ * передано значение канала: send(ch, v) ждёт свободного места, recv(ch) –
+ * сообщения. После close(ch) send – ошибка, а recv отдаёт оставшиеся
+ * сообщения, затем null.
+ *
+ * TaskPool – -threads <n> потоков (0 – по числу ядер), разбирающих общую
+ * очередь задач. Очередь задач и буфер канала – кольца без блокировок
+ * (MpmcQueue); мьютексы нужны только чтобы усыпить и разбудить ожидающий
+ * поток. Если поток пула ждёт в await, send или recv, пул добавляет поток
+ * (до TASK_MAX_THREADS), чтобы конвейер из большего числа стадий, чем
+ * потоков, не зависал; лишние потоки завершаются, когда работы нет.
+ *
+ * С --profile код задач не профилируется: профилировщик рассчитан на один
+ * поток, время ожидания в await, send, recv учитывается в строке программы.
+ */
+
+// Задач в очереди пула
+#define TASK_QUEUE_SIZE 4096
+// Потоков пула вместе с добавленными на время ожидания
+#define TASK_MAX_THREADS 256
+// Наибольшая ёмкость канала
+#define CHANNEL_MAX_CAPACITY (1 << 20)
+
+// Ограниченная очередь без блокировок для нескольких писателей и читателей:
+// кольцо ячеек с порядковыми номерами (алгоритм Д. Вьюкова). Ячеек не
+// меньше двух: в кольце из одной ячейки её номер после записи совпал бы с
+// номером следующей записи
+template <typename T>
+class MpmcQueue {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t size;
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> head{0};
+
+public:
+    explicit MpmcQueue(size_t capacity) : size(std::max(capacity, (size_t)2)) {
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Разрушается, когда очередью уже никто не пользуется
+    ~MpmcQueue() {
+        for (size_t pos = head.load(); pos != tail.load(); pos++)
+            ((T*)cells[pos % size].storage)->~T();
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // false – очередь полна, value не тронут
+    bool try_push(T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells[pos % size];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (cell.storage) T(std::move(value));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // false – очередь пуста
+    bool try_pop(T& value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells[pos % size];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    auto item = (T*)cell.storage;
+                    value = std::move(*item);
+                    item->~T();
+                    cell.sequence.store(pos + size, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+struct TaskState;
+
+struct TaskPool {
+    MpmcQueue<TaskState*> queue{TASK_QUEUE_SIZE};
+    std::atomic<size_t> pending{0};     // задач в очереди (с учётом ставящихся)
+
+    std::mutex lock;                    // только для счётчиков потоков и сна
+    std::condition_variable wake;
+    size_t size;
+    size_t workers = 0;
+    size_t idle = 0;
+    size_t blocked = 0;                 // ждут в await, send, recv
+
+    // Пул не разрушается: его потоки могут ждать работу до exit()
+    static TaskPool& instance() {
+        static TaskPool* pool = new TaskPool();
+        return *pool;
+    }
+
+    static bool& is_worker() {
+        static thread_local bool worker = false;
+        return worker;
+    }
+
+    TaskPool() {
+        size = WorkerPool::threads ? WorkerPool::threads : std::thread::hardware_concurrency();
+        if (!size) size = 1;
+    }
+
+    void submit(TaskState* task);
+    void work();
+
+    // Под lock: новый поток, если работающих потоков меньше size
+    void grow() {
+        if (idle || workers - blocked >= size || workers >= TASK_MAX_THREADS)
+            return;
+        if (StartInterpreterThread([this]() { work(); }))
+            workers++;
+    }
+
+    void enter_blocking() {
+        std::lock_guard<std::mutex> guard(lock);
+        blocked++;
+        if (pending.load() > 0)
+            grow();
+    }
+
+    void leave_blocking() {
+        std::lock_guard<std::mutex> guard(lock);
+        blocked--;
+    }
+};
+
+// Поток пула ждёт (await, send, recv) – пул может добавить поток
+struct TaskBlocking {
+    bool worker;
+
+    TaskBlocking() : worker(TaskPool::is_worker()) {
+        if (worker) TaskPool::instance().enter_blocking();
+    }
+
+    ~TaskBlocking() {
+        if (worker) TaskPool::instance().leave_blocking();
+    }
+
+    TaskBlocking(const TaskBlocking&) = delete;
+    TaskBlocking& operator=(const TaskBlocking&) = delete;
+};
+
+// Копия памяти объявлений для задачи (см. описание выше). Объекты снимка
+// регистрируются в контексте задачи под своими адресами, поэтому указатели
+// внутри снимка ведут на копии.
+struct TaskSnapshot {
+    uint32_t task = 0;
+    RuntimeContext* context = nullptr;
+    std::unordered_map<Memory*, Memory*> memories;
+    std::unordered_map<MemoryObject*, MemoryObject*> objects;
+    std::vector<std::unique_ptr<Memory>> owned;
+    std::vector<std::unique_ptr<Namespace>> namespaces;
+    std::vector<std::unique_ptr<Struct>> structs;
+    std::vector<std::unique_ptr<MemoryObject>> orphans;    // адрес уже занят в реестре
+    int max_address = 0;
+
+    Memory* add(Memory* memory) {
+        if (!memory)
+            return nullptr;
+        auto it = memories.find(memory);
+        if (it != memories.end())
+            return it->second;
+
+        // Запуск из задачи: копируется её снимок, а не исходная память
+        auto source = DeclarationMemory(memory);
+        owned.push_back(std::make_unique<Memory>());
+        auto copy = owned.back().get();
+        memories.emplace(memory, copy);
+        memories.emplace(source, copy);
+        for (auto& [symbol, object] : source->string_pool)
+            copy->string_pool.emplace(symbol, add(object));
+        return copy;
+    }
+
+    MemoryObject* add(MemoryObject* object) {
+        auto it = objects.find(object);
+        if (it != objects.end())
+            return it->second;
+
+        auto copy = new MemoryObject(*object);
+        objects.emplace(object, copy);
+        copy->task = task;
+        rebind(copy->value);
+        max_address = std::max(max_address, copy->address);
+        if (!context->objects.emplace(copy->address, copy).second)
+            orphans.emplace_back(copy);
+        return copy;
+    }
+
+    // Ссылки значения на память – на копии в снимке
+    void rebind(Value& value) {
+        auto& data = value.data;
+        if (data.type() == typeid(Function*)) {
+            add(any_cast<Function*>(data)->memory);
+        } else if (data.type() == typeid(Lambda*)) {
+            add(any_cast<Lambda*>(data)->memory);
+        } else if (data.type() == typeid(Namespace*)) {
+            auto ns = any_cast<Namespace*>(data);
+            namespaces.push_back(std::make_unique<Namespace>(add(ns->memory), ns->name));
+            data = namespaces.back().get();
+        } else if (data.type() == typeid(Struct*)) {
+            auto st = any_cast<Struct*>(data);
+            structs.push_back(std::make_unique<Struct>(*st));
+            structs.back()->memory = add(st->memory);
+            data = structs.back().get();
+        } else if (data.type() == typeid(Array)) {
+            for (auto& element : any_cast<Array&>(data).values)
+                rebind(element);
+        } else if (data.type() == typeid(ValueTable)) {
+            for (auto& entry : any_cast<ValueTable&>(data).entries)
+                if (entry.alive) rebind(entry.value);
+        }
+    }
+
+    // Память объявления вызываемого значения в снимке (для нативных – пустая)
+    Memory* declaration(const Value& callee) {
+        if (callee.data.type() == typeid(Function*))
+            return add(any_cast<Function*>(callee.data)->memory);
+        if (callee.data.type() == typeid(Lambda*))
+            return add(any_cast<Lambda*>(callee.data)->memory);
+        owned.push_back(std::make_unique<Memory>());
+        return owned.back().get();
+    }
+
+    void clear() {
+        orphans.clear();
+        owned.clear();
+        namespaces.clear();
+        structs.clear();
+        memories.clear();
+        objects.clear();
+    }
+};
+
+// Значение можно передать в другую задачу. callables – функции и лямбды
+// (только аргументы spawn: их память попадает в снимок)
+void CheckTransfer(const Value& value, bool callables, const string& what, const Token& start, const Token& end) {
+    auto& data = value.data;
+    bool callable = data.type() == typeid(Function*) || data.type() == typeid(Lambda*);
+    if ((callable && !callables) || value.type.is_pointer() || value.type == STANDART_TYPE::GENERATOR ||
+        data.type() == typeid(Namespace*) || data.type() == typeid(Struct*))
+        throw ERROR_THROW::TaskTransfer(start, end, what, value.type);
+    if (data.type() == typeid(Array)) {
+        for (auto& element : any_cast<const Array&>(data).values)
+            CheckTransfer(element, callables, what, start, end);
+    } else if (data.type() == typeid(ValueTable)) {
+        any_cast<const ValueTable&>(data).for_each([&](const ValueTable::Entry& entry) {
+            CheckTransfer(entry.value, callables, what, start, end);
+        });
+    }
+}
+
+// Ошибка задачи – в месте await или JoinTasks
+[[noreturn]] void RethrowTaskError(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const ProgramExit& exit) {
+        // exit или фатальная ошибка в задаче – завершение, как вне задачи
+        OutputBuffer::flush();
+        if (exit.fatal)
+            ExitOnError(exit.code);
+        ExitProgram(exit.code);
+    }
+}
+
+inline RuntimeContext& RootContext() {
+    auto context = &RuntimeContext::current();
+    while (context->parent) context = context->parent;
+    return *context;
+}
+
+struct TaskState {
+    std::function<Value()> body;        // вызов, выполняется в контексте задачи
+    Token start, end;                   // место spawn
+
+    RuntimeContext context;
+    TaskSnapshot snapshot;
+    std::string output;
+    std::ostringstream diagnostics;
+
+    std::mutex lock;
+    std::condition_variable finished;
+    bool done = false;
+    bool delivered = false;             // вывод передан в вывод ожидающего
+    bool observed = false;              // результат или ошибку получил await
+    Value result = NewNull();
+    std::exception_ptr error;
+
+    TaskState(const Token& start, const Token& end) : start(start), end(end) {}
+
+    // Снимок для вызова callee(args...) в контексте запускающего;
+    // возвращает память места вызова
+    Memory* capture(Value& callee, vector<Value>& args) {
+        auto& spawner = RuntimeContext::current();
+        context.parent = &RootContext();
+        context.task = NextParallelTask();
+        context.memories = &snapshot.memories;
+        context.output.capture = &output;
+        context.diagnostics = &diagnostics;
+        snapshot.task = context.task;
+        snapshot.context = &context;
+
+        auto memory = snapshot.declaration(callee);
+        snapshot.rebind(callee);
+        for (auto& arg : args)
+            snapshot.rebind(arg);
+
+        // Адреса задачи – после всех, что могут встретиться в снимке.
+        // Внешние контексты читаются, только пока они ждут (parallel for)
+        int next = snapshot.max_address;
+        for (auto c = &spawner; c; c = c->reads_parent ? c->parent : nullptr) {
+            next = std::max(next, c->next_address);
+            if (c->address_source)
+                next = std::max(next, c->address_source->load());
+        }
+        context.next_address = next;
+        return memory;
+    }
+
+    void run() {
+        {
+            RuntimeContext::Scope scope(&context);
+            try {
+                auto value = body();
+                CheckTransfer(value, false, "result of a task", start, end);
+                result = std::move(value);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            OutputBuffer::flush();
+            body = nullptr;
+            ReleaseObjects(context);
+            snapshot.clear();
+            context.memories = nullptr;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        done = true;
+        finished.notify_all();
+    }
+
+    void wait() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (done) return;
+        }
+        TaskBlocking blocking;
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [this]() { return done; });
+    }
+
+    // Вывод задачи – в вывод ожидающего, один раз
+    void deliver() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (delivered) return;
+            delivered = true;
+        }
+        OutputBuffer::write(output);
+        auto text = diagnostics.str();
+        if (!text.empty()) {
+            OutputBuffer::flush();
+            DiagnosticStream() << text;
+        }
+    }
+
+    // await: результат задачи или её ошибка
+    Value take() {
+        wait();
+        deliver();
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            observed = true;
+        }
+        if (error)
+            RethrowTaskError(error);
+        return result;
+    }
+};
+
+void TaskPool::submit(TaskState* task) {
+    pending.fetch_add(1);
+    while (!queue.try_push(task)) {
+        // Очередь полна: потоки пула разберут её
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            grow();
+        }
+        std::this_thread::yield();
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    if (idle)
+        wake.notify_one();
+    else
+        grow();
+}
+
+void TaskPool::work() {
+    is_worker() = true;
+    Profiler::unprofiled_thread() = true;
+    TaskState* task;
+    while (true) {
+        if (queue.try_pop(task)) {
+            pending.fetch_sub(1);
+            task->run();
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(lock);
+        if (pending.load() > 0)
+            continue;
+        // Поток, добавленный на время ожидания, больше не нужен
+        if (workers - blocked > size) {
+            workers--;
+            return;
+        }
+        idle++;
+        wake.wait(guard, [this]() { return pending.load() > 0; });
+        idle--;
+    }
+}
+
+// Запуск задачи: callee и args уже вычислены и проверены (CheckTransfer).
+// invoke(callee, args, memory) выполняет вызов в потоке задачи.
+using TaskInvoke = Value (*)(const Value& callee, const vector<Value>& args, Memory* memory,
+                             const Token& start, const Token& end);
+
+std::shared_ptr<TaskState> SpawnTask(Value callee, vector<Value> args, TaskInvoke invoke,
+                                     const Token& start, const Token& end) {
+    auto task = std::make_shared<TaskState>(start, end);
+    auto memory = task->capture(callee, args);
+    task->body = [invoke, callee, args, memory, start, end]() {
+        return invoke(callee, args, memory, start, end);
+    };
+
+    auto& root = RootContext();
+    {
+        std::lock_guard<std::mutex> guard(root.task_lock);
+        root.tasks.push_back(task);
+    }
+    TaskPool::instance().submit(task.get());
+    return task;
+}
+
+Value NewFuture(std::shared_ptr<TaskState> task) {
+    return Value(STANDART_TYPE::FUTURE, std::move(task));
+}
+
+// Ожидание всех задач запуска (конец программы). Вывод задач, которые никто
+// не ждал, – по порядку запуска; rethrow – сообщить первую ошибку такой задачи
+void JoinTasks(bool rethrow = true) {
+    auto& root = RootContext();
+    std::exception_ptr error;
+    size_t joined = 0;
+    while (true) {
+        std::shared_ptr<TaskState> task;
+        {
+            std::lock_guard<std::mutex> guard(root.task_lock);
+            if (joined == root.tasks.size()) break;
+            task = root.tasks[joined++];
+        }
+        task->wait();
+        task->deliver();
+        root.memoized_functions.insert(root.memoized_functions.end(),
+            task->context.memoized_functions.begin(), task->context.memoized_functions.end());
+        std::lock_guard<std::mutex> guard(task->lock);
+        if (task->error && !task->observed && !error)
+            error = task->error;
+        task->observed = true;
+    }
+    {
+        std::lock_guard<std::mutex> guard(root.task_lock);
+        root.tasks.clear();
+    }
+    if (error && rethrow)
+        RethrowTaskError(error);
+}
+
+struct ChannelState {
+    MpmcQueue<Value> buffer;
+    std::atomic<size_t> free;           // свободных мест: ёмкость канала точная
+    std::atomic<bool> closed{false};
+
+    std::mutex lock;                    // только для сна ожидающих
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::atomic<size_t> receivers{0};   // ждут сообщения
+    std::atomic<size_t> senders{0};     // ждут места
+
+    explicit ChannelState(size_t capacity) : buffer(capacity), free(capacity) {}
+
+    // Пока attempt() не удалась – сон на ready. Счётчик waiters увеличивается
+    // до повторной попытки, поэтому signal после неё не будет пропущен
+    template <typename Attempt>
+    void wait_until(Attempt attempt, std::atomic<size_t>& waiters, std::condition_variable& ready) {
+        if (attempt())
+            return;
+        TaskBlocking blocking;
+        std::unique_lock<std::mutex> guard(lock);
+        waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!attempt())
+            ready.wait(guard);
+        waiters.fetch_sub(1);
+    }
+
+    void signal(std::atomic<size_t>& waiters, std::condition_variable& ready) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load() == 0)
+            return;
+        { std::lock_guard<std::mutex> guard(lock); }
+        ready.notify_one();
+    }
+
+    bool reserve() {
+        size_t slots = free.load();
+        while (slots > 0)
+            if (free.compare_exchange_weak(slots, slots - 1)) return true;
+        return false;
+    }
+
+    // false – канал закрыт
+    bool send(Value& value) {
+        bool reserved = false;
+        wait_until([&]() { return closed.load() || (reserved = reserve()); }, senders, not_full);
+        if (!reserved)
+            return false;
+        // Место занято: кольцо не полно, ячейку может ещё освобождать читатель
+        while (!buffer.try_push(value))
+            std::this_thread::yield();
+        signal(receivers, not_empty);
+        return true;
+    }
+
+    // false – канал закрыт и пуст
+    bool recv(Value& value) {
+        bool received = false;
+        wait_until([&]() {
+            if ((received = buffer.try_pop(value))) return true;
+            if (!closed.load()) return false;
+            // Сообщение, отправленное до close, ещё могло не попасть в первую попытку
+            received = buffer.try_pop(value);
+            return true;
+        }, receivers, not_empty);
+        if (!received)
+            return false;
+        free.fetch_add(1);
+        signal(senders, not_full);
+        return true;
+    }
+
+    void close() {
+        closed.store(true);
+        { std::lock_guard<std::mutex> guard(lock); }
+        not_empty.notify_all();
+        not_full.notify_all();
+    }
+};
+
+namespace BUILTINS {
+
+    ChannelState& ChannelOf(const Value& value) {
+        return *any_cast<const std::shared_ptr<ChannelState>&>(value.data);
+    }
+
+    // Channel(n) – канал на n сообщений
+    Value NewChannel(NativeCall& call, void*) {
+        if (call.args.size() != 1)
+            throw ERROR_THROW::InvalidNativeArgumentCount(call.start, call.end, "Channel", 1, call.args.size());
+        auto& capacity = call.args[0];
+        if (capacity.type != STANDART_TYPE::INT)
+            throw ERROR_THROW::InvalidNativeArgumentType(call.start, call.end, "Channel", 0, STANDART_TYPE::INT, capacity.type);
+        auto n = any_cast<int64_t>(capacity.data);
+        if (n < 1 || n > CHANNEL_MAX_CAPACITY)
+            throw ERROR_THROW::ChannelInvalidCapacity(call.start, call.end, n, CHANNEL_MAX_CAPACITY);
+        return Value(STANDART_TYPE::CHANNEL, std::make_shared<ChannelState>((size_t)n));
+    }
+
+    Value Send(NativeCall& call, void*) {
+        CheckTransfer(call.args[1], false, "message of a channel", call.start, call.end);
+        Value message = call.args[1];
+        if (!ChannelOf(call.args[0]).send(message))
+            throw ERROR_THROW::ChannelClosed(call.start, call.end);
+        return NewNull();
+    }
+
+    Value Recv(NativeCall& call, void*) {
+        Value message = NewNull();
+        ChannelOf(call.args[0]).recv(message);
+        return message;
+    }
+
+    Value Close(NativeCall& call, void*) {
+        ChannelOf(call.args[0]).close();
+        return NewNull();
+    }
+
+    NativeFunction CHANNEL_CONSTRUCTOR { "Channel", -1, {}, NewChannel };
+
+    NativeFunction SEND  { "send",  2, { STANDART_TYPE::CHANNEL, STANDART_TYPE::AUTO }, Send };
+    NativeFunction RECV  { "recv",  1, { STANDART_TYPE::CHANNEL }, Recv };
+    NativeFunction CLOSE { "close", 1, { STANDART_TYPE::CHANNEL }, Close };
+
+    bool RegisterTasks() {
+        NativeRegistry::define_name("Future", NewType(STANDART_TYPE::FUTURE));
+        NativeRegistry::define_name("Channel", NewType(STANDART_TYPE::CHANNEL));
+        NativeRegistry::define_constructor("Channel", &CHANNEL_CONSTRUCTOR);
+        for (auto native : { &SEND, &RECV, &CLOSE })
+            NativeRegistry::define(native);
+        return true;
+    }
+
+    const bool TASKS_REGISTERED = RegisterTasks();
+}
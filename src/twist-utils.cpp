@@ -244,39 +244,21 @@ void printDuration(chrono::nanoseconds duration_ns) {
     }
 }
 
-void middleTimeIt(string name, function<void()> func, int count) {
-    using namespace std::chrono;
-    
-    nanoseconds total_duration = nanoseconds(0);
-    
-    cout << MT::INFO << "Starting " << name << " (" << count << " iterations)" 
-         << TERMINAL_COLORS::RESET << endl;
-    
-    for (int i = 0; i < count; i++) { 
-        auto start = high_resolution_clock::now();
-        func();
-        auto end = high_resolution_clock::now();
-        
-        auto iteration_duration = duration_cast<nanoseconds>(end - start);
-        total_duration += iteration_duration;
-        
-        // Вывод времени текущей итерации
-        cout << ">>>" << TERMINAL_COLORS::BLUE << " Iteration " << (i+1) << "/" << count << ": ";
-        printDuration(iteration_duration);
-        cout << TERMINAL_COLORS::RESET << "\n";
+// Экранирование строки для JSON (с кавычками)
+string JsonString(const string& str) {
+    string result = "\"";
+    for (unsigned char c : str) {
+        if (c == '"' || c == '\\') { result += '\\'; result += c; }
+        else if (c == '\n') result += "\\n";
+        else if (c == '\t') result += "\\t";
+        else if (c < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            result += buffer;
+        }
+        else result += c;
     }
-    
-    // Вывод среднего времени
-    nanoseconds avg_duration = total_duration / count;
-
-    // Дополнительная статистика 
-    cout << MT::INFO << "Total time: " << TERMINAL_COLORS::BLACK;
-    printDuration(total_duration);
-    cout << TERMINAL_COLORS::RESET << endl;
-    
-    cout << MT::INFO << "Average for " << name << ": " << TERMINAL_COLORS::UNDERLINE << TERMINAL_COLORS::GREEN;
-    printDuration(avg_duration);
-    cout << TERMINAL_COLORS::RESET << endl; 
+    return result + "\"";
 }
 
 
@@ -417,10 +399,30 @@ struct ArgsParser {
     bool run_time = false;
     bool compile_mod = false;
     bool delete_precompiled = true;
-    bool middle_run_time = false;
+    bool benchmark = false;         // -bench (-mrt), см. twist-bench.cpp
+    int bench_warmup = 3;           // -bench-warmup <n>
+    int bench_iterations = 30;      // -bench-iters <n>
+    double bench_time_ms = 0;       // -bench-time <мс>, 0 – без ограничения
+    string bench_json;              // -bench-json <файл | ->
+    bool bench_quiet = true;        // -bench-verbose – не подавлять вывод программы
+    string phases_json;             // -phases <файл | ->, время этапов в JSON
     bool print_ast = false;
     bool save_ast = false;
     bool as_debuger = false;
+    bool optimize = true;
+    bool quicken = true;            // -no-quicken, без специализации горячих узлов по типам
+    bool jit = true;                // --jit / --no-jit, машинный код для горячих функций (x86-64 Linux)
+    int recursion_limit = 100;      // -rl <n>, 0 – без ограничения по числу вызовов
+    size_t stack_size_mb = 256;     // -stack <МБ>, размер стека потока исполнения
+    size_t threads = 0;             // -threads <n>, потоков для parallel for / pmap и задач spawn (0 – по числу ядер)
+    bool memoize = false;           // -memo, кэшировать все чистые функции
+    size_t memo_capacity = 4096;    // -memo-size <n>, записей кэша на функцию (0 – без ограничения)
+    bool memo_stats = false;        // -memo-stats, счётчики кэша после выполнения
+    bool profile = false;           // --profile[=text|json|collapsed]
+    string profile_format = "text";
+    string profile_output;          // --profile-out <файл>, по умолчанию stdout
+    bool stats = false;             // --stats, счётчики RuntimeStats (сборка с -DLUMEN_STATS)
+    int out_fd = -1;                // -out-fd <n>, вывод программы напрямую в дескриптор
 
     ArgsParser(vector<string> args) : args(args) {}
 
@@ -453,8 +455,33 @@ struct ArgsParser {
                     delete_precompiled = false;
                     continue;
                 }
-                if (args[i] == "-mrt") {
-                    middle_run_time = true;
+                if (args[i] == "-bench" || args[i] == "-mrt") {
+                    benchmark = true;
+                    continue;
+                }
+                if (args[i] == "-bench-warmup" && i + 1 < args.size()) {
+                    bench_warmup = stoi(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-bench-iters" && i + 1 < args.size()) {
+                    bench_iterations = stoi(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-bench-time" && i + 1 < args.size()) {
+                    bench_time_ms = stod(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-bench-json" && i + 1 < args.size()) {
+                    benchmark = true;
+                    bench_json = args[i + 1];
+                    continue;
+                }
+                if (args[i] == "-bench-verbose") {
+                    bench_quiet = false;
+                    continue;
+                }
+                if (args[i] == "-phases" && i + 1 < args.size()) {
+                    phases_json = args[i + 1];
                     continue;
                 }
                 if (args[i] == "-print-ast") {
@@ -469,6 +496,61 @@ struct ArgsParser {
                     as_debuger = true;
                     continue;
                 }
+                if (args[i] == "-no-opt") {
+                    optimize = false;
+                    continue;
+                }
+                if (args[i] == "-no-quicken") {
+                    quicken = false;
+                    continue;
+                }
+                if (args[i] == "--jit" || args[i] == "--no-jit") {
+                    jit = args[i] == "--jit";
+                    continue;
+                }
+                if (args[i] == "-rl" && i + 1 < args.size()) {
+                    recursion_limit = stoi(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-stack" && i + 1 < args.size()) {
+                    stack_size_mb = stoul(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-threads" && i + 1 < args.size()) {
+                    threads = stoul(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-memo") {
+                    memoize = true;
+                    continue;
+                }
+                if (args[i] == "-memo-size" && i + 1 < args.size()) {
+                    memo_capacity = stoul(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "-memo-stats") {
+                    memo_stats = true;
+                    continue;
+                }
+                if (args[i] == "--profile" || args[i].rfind("--profile=", 0) == 0) {
+                    profile = true;
+                    if (args[i].size() > 10)
+                        profile_format = args[i].substr(10);
+                    continue;
+                }
+                if (args[i] == "-out-fd" && i + 1 < args.size()) {
+                    out_fd = stoi(args[i + 1]);
+                    continue;
+                }
+                if (args[i] == "--stats") {
+                    stats = true;
+                    continue;
+                }
+                if (args[i] == "--profile-out" && i + 1 < args.size()) {
+                    profile = true;
+                    profile_output = args[i + 1];
+                    continue;
+                }
             }
         }
     }
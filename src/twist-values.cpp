@@ -7,6 +7,8 @@
 #include <any>
 #include <iostream>
 #include <cassert>
+#include "twist-stats.cpp"
+#include "twist-string.cpp"
 #pragma once
 
 using namespace std;
@@ -575,8 +577,15 @@ namespace STANDART_TYPE {
     const Type LAMBDA = Type("Lambda");
     const Type AUTO = Type("auto");
     const Type PTR = Type("ptr");
-
-    const Type TYPES = INT | BOOL | STRING | CHAR | DOUBLE | NAMESPACE | NULL_T | LAMBDA | TYPE | PTR;
+    const Type MAP = Type("Map");
+    const Type SET = Type("Set");
+    const Type NATIVE = Type("Native");
+    const Type FUTURE = Type("Future");
+    const Type CHANNEL = Type("Channel");
+    const Type GENERATOR = Type("Generator");
+
+    const Type TYPES = INT | BOOL | STRING | CHAR | DOUBLE | NAMESPACE | NULL_T | LAMBDA | TYPE | PTR | MAP | SET | NATIVE |
+                       FUTURE | CHANNEL | GENERATOR;
 }
 
 bool IsTypeCompatible(const Type& target_type, const Type& source_type) {
@@ -596,12 +605,15 @@ struct Value {
 
     Value(const Value& other)
         : type(other.type),
-          data(other.data) {}
+          data(other.data) {
+        STAT_INC(value_copies);
+    }
 
     Value(Value&& other) = default;
 
     Value& operator=(const Value& other) {
         if (this != &other) {
+            STAT_INC(value_copies);
             type = other.type;
             data = other.data;
         }
@@ -616,7 +628,7 @@ struct Value {
 
     friend ostream& operator<<(ostream& os, const Value& value) {
         if (value.type == STANDART_TYPE::STRING) {
-            os << any_cast<string>(value.data);
+            os << any_cast<const RuntimeString&>(value.data);
         } else if (value.type == STANDART_TYPE::NAMESPACE) {
             os << "NAMESPACE";
         } else {
@@ -638,7 +650,8 @@ Value NewBool(bool value) { return Value(STANDART_TYPE::BOOL, value); }
 Value NewType(const string& name) { return Value(STANDART_TYPE::TYPE, Type(name)); }
 Value NewType(const Type& type) { return Value(STANDART_TYPE::TYPE, type); }
 Value NewNull() { return Value(STANDART_TYPE::NULL_T, Null()); }
-Value NewString(const string& value) { return Value(STANDART_TYPE::STRING, value); }
+Value NewString(const string& value) { return Value(STANDART_TYPE::STRING, RuntimeString(value)); }
+Value NewString(RuntimeString value) { return Value(STANDART_TYPE::STRING, std::move(value)); }
 Value NewChar(char value) { return Value(STANDART_TYPE::CHAR, value); }
 
 Value NewPointer(int value, const Type& pointer_type, bool create_pointer = true) {
@@ -0,0 +1,84 @@
+"""
+Регрессионные тесты Lumen.
+
+Каждый tests/*.lumen выполняется lumenc (из каталога tests, stdout – канал,
+не терминал), вывод сравнивается с tests/<имя>.expected. Из вывода
+убираются цвета и служебные строки lumenc ("[ yes ] File ... is found",
+"[ inf ] Parse finished ..."); прочие [ inf ] (например, -memo-stats)
+сравниваются как обычный вывод.
+
+Строка `// lumenc: <ключи>` в тесте задаёт ключи запуска; несколько таких
+строк – несколько запусков с одним ожидаемым выводом (например, --jit и
+--no-jit). tests/<имя>.stdin, если есть, подаётся на stdin.
+
+    python tests/run.py [--lumenc bin/lumenc.exe] [имена тестов...]
+"""
+
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+COLOR = re.compile(r"\x1b\[[0-9;]*m")
+SERVICE = re.compile(r"^\[ (yes \] File .* is found\.|inf \] Parse finished in )")
+VARIANT = re.compile(r"^// lumenc:(.*)$", re.M)
+
+
+def default_lumenc():
+    bin_dir = os.path.join(ROOT, "..", "bin")
+    path = os.path.join(bin_dir, "lumenc")
+    return path if os.name != "nt" and os.path.exists(path) else os.path.join(bin_dir, "lumenc.exe")
+
+
+def program_output(lumenc, name, flags):
+    command = [os.path.abspath(lumenc)] + (flags + ["--file"] if flags else []) + [name]
+    stdin_path = os.path.join(ROOT, os.path.splitext(name)[0] + ".stdin")
+    stdin = open(stdin_path, "rb") if os.path.exists(stdin_path) else subprocess.DEVNULL
+    try:
+        process = subprocess.run(command, cwd=ROOT, stdin=stdin,
+                                 stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    finally:
+        if stdin is not subprocess.DEVNULL:
+            stdin.close()
+    lines = COLOR.sub("", process.stdout.decode(errors="replace")).splitlines()
+    return "\n".join(line for line in lines if not SERVICE.match(line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Lumen regression tests")
+    parser.add_argument("--lumenc", default=default_lumenc())
+    parser.add_argument("names", nargs="*", help="запустить только эти тесты")
+    args = parser.parse_args()
+
+    files = sorted(glob.glob(os.path.join(ROOT, "*.lumen")))
+    if args.names:
+        files = [f for f in files if os.path.splitext(os.path.basename(f))[0] in args.names]
+
+    runs = 0
+    failed = 0
+    for path in files:
+        name = os.path.basename(path)
+        with open(os.path.splitext(path)[0] + ".expected") as f:
+            expected = f.read().rstrip("\n")
+        with open(path) as f:
+            variants = [line.split() for line in VARIANT.findall(f.read())] or [[]]
+        for flags in variants:
+            runs += 1
+            label = " ".join([name] + flags)
+            actual = program_output(args.lumenc, name, flags).rstrip("\n")
+            if actual == expected:
+                print("ok      %s" % label)
+                continue
+            failed += 1
+            print("FAILED  %s" % label)
+            print("--- expected\n%s\n--- actual\n%s" % (expected, actual))
+
+    print("%d/%d passed" % (runs - failed, runs))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())